@@ -0,0 +1,138 @@
+#include "ArenaRendu.h"
+#include <algorithm>
+#include <cstdint>
+
+/// Alignement des blocs demandés à la ressource amont.
+static constexpr size_t ALIGNEMENT_BLOC = alignof(std::max_align_t);
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param capaciteInitiale Taille du premier bloc.
+ * @param amont Ressource fournissant les blocs.
+ */
+ArenaRendu::ArenaRendu(size_t capaciteInitiale, std::pmr::memory_resource* amont)
+    : amont(amont), capaciteInitiale(std::max<size_t>(capaciteInitiale, 256)) {}
+
+/**
+ * @brief Destructeur.
+ */
+ArenaRendu::~ArenaRendu() {
+    libererBlocs();
+}
+
+/**
+ * @brief Rend toute la mémoire distribuée.
+ */
+void ArenaRendu::reinitialiser() {
+    if (blocs.size() > 1) {
+        // Le rendu a débordé du premier bloc : un seul bloc couvrira désormais l'ensemble
+        size_t total = 0;
+        for (const Bloc& bloc : blocs) {
+            total += bloc.taille;
+        }
+        libererBlocs();
+        ajouterBloc(total);
+    }
+    position = 0;
+    utilise = 0;
+}
+
+/**
+ * @brief Octets distribués depuis le dernier reinitialiser().
+ * 
+ * @return size_t Le nombre d'octets.
+ */
+size_t ArenaRendu::getUtilise() const {
+    return utilise;
+}
+
+/**
+ * @brief Taille cumulée des blocs.
+ * 
+ * @return size_t Le nombre d'octets.
+ */
+size_t ArenaRendu::getCapacite() const {
+    size_t total = 0;
+    for (const Bloc& bloc : blocs) {
+        total += bloc.taille;
+    }
+    return total;
+}
+
+/**
+ * @brief Nombre de blocs obtenus depuis la construction.
+ * 
+ * @return size_t Le nombre de blocs.
+ */
+size_t ArenaRendu::getNbBlocsAlloues() const {
+    return nbBlocsAlloues;
+}
+
+/**
+ * @brief Distribue de la mémoire dans le bloc courant, ou dans un nouveau bloc.
+ * 
+ * @param octets Taille demandée.
+ * @param alignement Alignement demandé (puissance de 2).
+ * @return void* La mémoire.
+ */
+void* ArenaRendu::do_allocate(size_t octets, size_t alignement) {
+    if (!blocs.empty()) {
+        const Bloc& bloc = blocs.back();
+        const uintptr_t adresse = reinterpret_cast<uintptr_t>(bloc.debut) + position;
+        const size_t decalage = (alignement - adresse % alignement) % alignement;
+        if (position + decalage + octets <= bloc.taille) {
+            position += decalage + octets;
+            utilise += decalage + octets;
+            return reinterpret_cast<void*>(adresse + decalage);
+        }
+    }
+
+    // Bloc suivant au moins deux fois plus grand : peu de blocs, vite fusionnés
+    const size_t precedent = blocs.empty() ? capaciteInitiale / 2 : blocs.back().taille;
+    ajouterBloc(std::max(2 * precedent, octets + alignement));
+    const uintptr_t adresse = reinterpret_cast<uintptr_t>(blocs.back().debut);
+    const size_t decalage = (alignement - adresse % alignement) % alignement;
+    position = decalage + octets;
+    utilise += decalage + octets;
+    return reinterpret_cast<void*>(adresse + decalage);
+}
+
+/**
+ * @brief Ne fait rien : la mémoire est rendue par reinitialiser().
+ */
+void ArenaRendu::do_deallocate(void*, size_t, size_t) {}
+
+/**
+ * @brief Deux arènes ne sont égales que si elles sont le même objet.
+ * 
+ * @param autre Autre ressource.
+ * @return bool Vrai si `autre` est cette arène.
+ */
+bool ArenaRendu::do_is_equal(const std::pmr::memory_resource& autre) const noexcept {
+    return this == &autre;
+}
+
+/**
+ * @brief Obtient un nouveau bloc.
+ * 
+ * @param minimum Taille minimale du bloc.
+ */
+void ArenaRendu::ajouterBloc(size_t minimum) {
+    const size_t taille = (minimum + ALIGNEMENT_BLOC - 1) / ALIGNEMENT_BLOC * ALIGNEMENT_BLOC;
+    blocs.reserve(blocs.size() + 1); // Avant l'allocation du bloc : rien ne fuit si reserve échoue
+    blocs.push_back({static_cast<char*>(amont->allocate(taille, ALIGNEMENT_BLOC)), taille});
+    position = 0;
+    ++nbBlocsAlloues;
+}
+
+/**
+ * @brief Rend tous les blocs à la ressource amont.
+ */
+void ArenaRendu::libererBlocs() {
+    for (const Bloc& bloc : blocs) {
+        amont->deallocate(bloc.debut, bloc.taille, ALIGNEMENT_BLOC);
+    }
+    blocs.clear();
+    position = 0;
+}
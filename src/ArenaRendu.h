@@ -0,0 +1,103 @@
+#ifndef ARENA_RENDU_H
+#define ARENA_RENDU_H
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+/**
+ * @brief Mémoire de travail d'un rendu : allocation par simple avancée dans des blocs réutilisés.
+ * 
+ * Les allocations avancent un pointeur dans le bloc courant ; les libérations
+ * ne font rien. reinitialiser() rend toute la mémoire d'un coup, sans la
+ * restituer : si le rendu précédent a demandé plusieurs blocs, ils sont
+ * remplacés par un seul bloc de leur taille cumulée. Après quelques rendus,
+ * le bloc couvre le plus gros rendu et plus aucun appel n'atteint
+ * l'allocateur global.
+ * 
+ * La mémoire obtenue n'est valable que jusqu'au prochain reinitialiser() :
+ * les objets construits dans l'arène (vecteurs std::pmr, bitmaps de travail)
+ * ne doivent pas survivre au rendu. Une arène n'est pas protégée contre les
+ * accès concurrents : chaque thread utilise la sienne (voir Rendu).
+ */
+class ArenaRendu : public std::pmr::memory_resource {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param capaciteInitiale Taille du premier bloc, alloué à la première demande.
+     * @param amont Ressource fournissant les blocs.
+     */
+    explicit ArenaRendu(size_t capaciteInitiale = 64 * 1024,
+                        std::pmr::memory_resource* amont = std::pmr::new_delete_resource());
+
+    /**
+     * @brief Destructeur : rend les blocs à la ressource amont.
+     */
+    ~ArenaRendu() override;
+
+    ArenaRendu(const ArenaRendu&) = delete;
+    ArenaRendu& operator=(const ArenaRendu&) = delete;
+
+    /**
+     * @brief Rend toute la mémoire distribuée depuis le dernier appel.
+     * 
+     * Les blocs sont conservés, fusionnés en un seul s'il y en a plusieurs.
+     */
+    void reinitialiser();
+
+    /**
+     * @brief Octets distribués depuis le dernier reinitialiser(), alignements compris.
+     * 
+     * @return size_t Le nombre d'octets.
+     */
+    size_t getUtilise() const;
+
+    /**
+     * @brief Taille cumulée des blocs.
+     * 
+     * @return size_t Le nombre d'octets.
+     */
+    size_t getCapacite() const;
+
+    /**
+     * @brief Nombre de blocs obtenus de la ressource amont depuis la construction.
+     * 
+     * @return size_t Le nombre de blocs ; stable une fois le régime établi.
+     */
+    size_t getNbBlocsAlloues() const;
+
+private:
+    /**
+     * @brief Bloc de mémoire obtenu de la ressource amont.
+     */
+    struct Bloc {
+        char* debut;    ///< Premier octet.
+        size_t taille;  ///< Taille en octets.
+    };
+
+    void* do_allocate(size_t octets, size_t alignement) override;
+    void do_deallocate(void* pointeur, size_t octets, size_t alignement) override;
+    bool do_is_equal(const std::pmr::memory_resource& autre) const noexcept override;
+
+    /**
+     * @brief Obtient un nouveau bloc et en fait le bloc courant.
+     * 
+     * @param minimum Taille minimale du bloc.
+     */
+    void ajouterBloc(size_t minimum);
+
+    /**
+     * @brief Rend tous les blocs à la ressource amont.
+     */
+    void libererBlocs();
+
+    std::pmr::memory_resource* amont;  ///< Ressource fournissant les blocs.
+    size_t capaciteInitiale;           ///< Taille du premier bloc.
+    std::vector<Bloc> blocs;           ///< Blocs, le courant en dernier.
+    size_t position = 0;               ///< Premier octet libre du bloc courant.
+    size_t utilise = 0;                ///< Octets distribués depuis le dernier reinitialiser().
+    size_t nbBlocsAlloues = 0;         ///< Blocs obtenus depuis la construction.
+};
+
+#endif // ARENA_RENDU_H
@@ -0,0 +1,534 @@
+#include "AtlasGlyphes.h"
+#include "CacheGlyphes.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <stdexcept>
+
+/// Signature d'un atlas sérialisé.
+static const char SIGNATURE[4] = {'A', 'T', 'L', 'G'};
+
+/// Version du format de sérialisation.
+static const uint32_t VERSION = 1;
+
+/// Octets d'une métrique sérialisée : lettre, style, 2 octets nuls, 7 entiers et 4 flottants.
+static const size_t TAILLE_METRIQUE = 4 + 7 * 4 + 4 * 4;
+
+/**
+ * @brief Rangement de rectangles par ligne d'horizon (skyline).
+ * 
+ * L'horizon est la suite des hauteurs déjà occupées, par segments de colonnes
+ * contigus. Un rectangle est posé sur l'horizon à la position où son bord
+ * haut serait le plus bas (puis la plus à gauche), et l'horizon est relevé
+ * sous lui : l'espace laissé sous un segment plus haut est perdu, ce qui
+ * reste faible quand les rectangles arrivent par hauteur décroissante.
+ */
+class Skyline {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param largeur Largeur disponible.
+     */
+    explicit Skyline(int largeur) : largeur(largeur), segments{{0, 0, largeur}} {}
+
+    /**
+     * @brief Place un rectangle.
+     * 
+     * @param l Largeur du rectangle.
+     * @param h Hauteur du rectangle.
+     * @param x Reçoit la colonne du rectangle.
+     * @param y Reçoit la ligne du rectangle.
+     * @return bool Faux si le rectangle est plus large que l'espace disponible.
+     */
+    bool placer(int l, int h, int& x, int& y) {
+        size_t meilleur = segments.size();
+        int meilleurY = 0;
+        for (size_t i = 0; i < segments.size() && segments[i].x + l <= largeur; ++i) {
+            // Hauteur d'appui : maximum de l'horizon sur [x, x + l[
+            int appui = 0;
+            for (size_t j = i; j < segments.size() && segments[j].x < segments[i].x + l; ++j) {
+                appui = std::max(appui, segments[j].y);
+            }
+            if (meilleur == segments.size() || appui < meilleurY) {
+                meilleur = i;
+                meilleurY = appui;
+            }
+        }
+        if (meilleur == segments.size()) {
+            return false;
+        }
+        x = segments[meilleur].x;
+        y = meilleurY;
+        relever(meilleur, l, meilleurY + h);
+        hauteur = std::max(hauteur, meilleurY + h);
+        return true;
+    }
+
+    /**
+     * @brief Hauteur totale occupée.
+     * 
+     * @return int La hauteur de l'horizon le plus haut.
+     */
+    int getHauteur() const {
+        return hauteur;
+    }
+
+private:
+    /**
+     * @brief Segment d'horizon : colonnes [x, x + largeur[ occupées jusqu'à la ligne y.
+     */
+    struct Segment {
+        int x;        ///< Première colonne.
+        int y;        ///< Hauteur occupée.
+        int largeur;  ///< Nombre de colonnes.
+    };
+
+    /**
+     * @brief Relève l'horizon sous un rectangle posé.
+     * 
+     * @param i Segment où commence le rectangle.
+     * @param l Largeur du rectangle.
+     * @param haut Nouvelle hauteur sous le rectangle.
+     */
+    void relever(size_t i, int l, int haut) {
+        const int x = segments[i].x;
+        const int fin = x + l;
+        // Retirer ou raccourcir les segments recouverts
+        size_t j = i;
+        while (j < segments.size() && segments[j].x < fin) {
+            const int finSegment = segments[j].x + segments[j].largeur;
+            if (finSegment <= fin) {
+                ++j;
+            } else {
+                segments[j].largeur = finSegment - fin;
+                segments[j].x = fin;
+                break;
+            }
+        }
+        segments.erase(segments.begin() + i, segments.begin() + j);
+        segments.insert(segments.begin() + i, Segment{x, haut, l});
+
+        // Fusionner avec les voisins de même hauteur
+        if (i + 1 < segments.size() && segments[i + 1].y == haut) {
+            segments[i].largeur += segments[i + 1].largeur;
+            segments.erase(segments.begin() + i + 1);
+        }
+        if (i > 0 && segments[i - 1].y == haut) {
+            segments[i - 1].largeur += segments[i].largeur;
+            segments.erase(segments.begin() + i);
+        }
+    }
+
+    int largeur;                    ///< Largeur disponible.
+    int hauteur = 0;                ///< Hauteur occupée.
+    std::vector<Segment> segments;  ///< Horizon, par colonnes croissantes.
+};
+
+/**
+ * @brief Format de pixels d'un atlas réunissant plusieurs styles.
+ * 
+ * @param styles Les styles de l'atlas.
+ * @return PixelFormat Bit1, Index8 ou Coverage8.
+ * 
+ * @throws std::invalid_argument Si Lisse et ContourRouge sont mélangés.
+ */
+static PixelFormat formatAtlas(const std::vector<StyleRendu>& styles) {
+    bool couverture = false;
+    bool indices = false;
+    for (StyleRendu style : styles) {
+        couverture = couverture || Rendu::formatPour(style) == PixelFormat::Coverage8;
+        indices = indices || Rendu::formatPour(style) == PixelFormat::Index8;
+    }
+    if (couverture && indices) {
+        throw std::invalid_argument("Un atlas ne peut pas réunir les styles lisse et rouge.");
+    }
+    return couverture ? PixelFormat::Coverage8 : (indices ? PixelFormat::Index8 : PixelFormat::Bit1);
+}
+
+/**
+ * @brief Constructeur : rend, découpe et range les glyphes.
+ * 
+ * @param lettres Les lettres à rendre.
+ * @param styles Les styles de rendu.
+ * @param taille Hauteur des rendus.
+ * @param largeurMax Largeur visée de l'atlas.
+ * @param marge Pixels vides entre deux glyphes.
+ */
+AtlasGlyphes::AtlasGlyphes(const std::string& lettres, const std::vector<StyleRendu>& styles, int taille,
+                           int largeurMax, int marge)
+    : bitmap(1, 1, PixelFormat::Bit1), taille(taille) {
+    if (largeurMax <= 0 || marge < 0) {
+        throw std::invalid_argument("La largeur de l'atlas doit être positive et la marge positive ou nulle.");
+    }
+    const PixelFormat format = formatAtlas(styles);
+
+    // Rendre chaque glyphe et ne garder que la boîte de son encre (sans limite de mémoire :
+    // les références vers les rendus restent valides jusqu'à la fin de la construction)
+    CacheGlyphes cache(SIZE_MAX);
+    std::vector<const Bitmap*> images;
+    int largeurUtile = largeurMax;
+    for (char lettre : lettres) {
+        lettre = static_cast<char>(std::toupper(static_cast<unsigned char>(lettre)));
+        for (StyleRendu style : styles) {
+            const GlypheCache& glyphe = cache.obtenir(lettre, style, taille);
+            MetriqueGlyphe metrique{lettre, style, Rectangle{0, 0, 0, 0}, 0.0f, 0.0f, 0.0f, 0.0f,
+                                    glyphe.decalageX, glyphe.decalageY, glyphe.largeur};
+            if (glyphe.encre) {
+                metrique.zone.largeur = glyphe.image.getWidth();
+                metrique.zone.hauteur = glyphe.image.getHeight();
+                largeurUtile = std::max(largeurUtile, metrique.zone.largeur);
+            }
+            images.push_back(&glyphe.image);
+            metriques.push_back(metrique);
+        }
+    }
+
+    // Ranger les boîtes, des plus hautes aux plus basses
+    std::vector<size_t> ordre(metriques.size());
+    for (size_t i = 0; i < ordre.size(); ++i) {
+        ordre[i] = i;
+    }
+    std::stable_sort(ordre.begin(), ordre.end(), [this](size_t a, size_t b) {
+        const Rectangle& za = metriques[a].zone;
+        const Rectangle& zb = metriques[b].zone;
+        return za.hauteur != zb.hauteur ? za.hauteur > zb.hauteur : za.largeur > zb.largeur;
+    });
+    Skyline horizon(largeurUtile + marge);
+    int largeurAtlas = 1;
+    for (size_t i : ordre) {
+        Rectangle& zone = metriques[i].zone;
+        if (zone.largeur == 0) {
+            continue;
+        }
+        horizon.placer(zone.largeur + marge, zone.hauteur + marge, zone.x, zone.y);
+        largeurAtlas = std::max(largeurAtlas, zone.x + zone.largeur);
+    }
+    const int hauteurAtlas = std::max(1, horizon.getHauteur() - marge);
+
+    // Copier les glyphes à leur place et calculer leurs coordonnées de texture
+    bitmap = Bitmap(largeurAtlas, hauteurAtlas, format);
+    for (size_t i = 0; i < metriques.size(); ++i) {
+        MetriqueGlyphe& metrique = metriques[i];
+        if (metrique.zone.largeur == 0) {
+            continue;
+        }
+        Composition::composer(*images[i], bitmap, metrique.zone.x, metrique.zone.y, OperateurComposition::Copie);
+        metrique.u0 = static_cast<float>(metrique.zone.x) / largeurAtlas;
+        metrique.v0 = static_cast<float>(metrique.zone.y) / hauteurAtlas;
+        metrique.u1 = static_cast<float>(metrique.zone.x + metrique.zone.largeur) / largeurAtlas;
+        metrique.v1 = static_cast<float>(metrique.zone.y + metrique.zone.hauteur) / hauteurAtlas;
+    }
+}
+
+/**
+ * @brief Constructeur à partir d'éléments déjà calculés.
+ * 
+ * @param bitmap Pixels de l'atlas.
+ * @param taille Hauteur des rendus.
+ * @param metriques Table des métriques.
+ */
+AtlasGlyphes::AtlasGlyphes(Bitmap bitmap, int taille, std::vector<MetriqueGlyphe> metriques)
+    : bitmap(std::move(bitmap)), taille(taille), metriques(std::move(metriques)) {}
+
+/**
+ * @brief Bitmap de l'atlas.
+ * 
+ * @return const Bitmap& Les pixels.
+ */
+const Bitmap& AtlasGlyphes::getBitmap() const {
+    return bitmap;
+}
+
+/**
+ * @brief Table des métriques.
+ * 
+ * @return const std::vector<MetriqueGlyphe>& Les métriques.
+ */
+const std::vector<MetriqueGlyphe>& AtlasGlyphes::getMetriques() const {
+    return metriques;
+}
+
+/**
+ * @brief Hauteur des rendus.
+ * 
+ * @return int La taille.
+ */
+int AtlasGlyphes::getTaille() const {
+    return taille;
+}
+
+/**
+ * @brief Recherche les métriques d'un rendu.
+ * 
+ * @param lettre La lettre.
+ * @param style Le style.
+ * @return const MetriqueGlyphe* L'entrée, ou nullptr.
+ */
+const MetriqueGlyphe* AtlasGlyphes::trouver(char lettre, StyleRendu style) const {
+    for (const MetriqueGlyphe& metrique : metriques) {
+        if (metrique.lettre == lettre && metrique.style == style) {
+            return &metrique;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Part de la surface de l'atlas occupée par des glyphes.
+ * 
+ * @return double Le taux de remplissage.
+ */
+double AtlasGlyphes::getTauxRemplissage() const {
+    double occupe = 0.0;
+    for (const MetriqueGlyphe& metrique : metriques) {
+        occupe += static_cast<double>(metrique.zone.largeur) * metrique.zone.hauteur;
+    }
+    return occupe / (static_cast<double>(bitmap.getWidth()) * bitmap.getHeight());
+}
+
+/**
+ * @brief Ajoute un entier de 32 bits, en petit-boutiste.
+ * 
+ * @param bloc Bloc en construction.
+ * @param valeur Valeur à ajouter.
+ */
+static void ajouter32(std::vector<uint8_t>& bloc, uint32_t valeur) {
+    for (int i = 0; i < 4; ++i) {
+        bloc.push_back(static_cast<uint8_t>(valeur >> (8 * i)));
+    }
+}
+
+/**
+ * @brief Ajoute un flottant de 32 bits (IEEE 754), en petit-boutiste.
+ * 
+ * @param bloc Bloc en construction.
+ * @param valeur Valeur à ajouter.
+ */
+static void ajouterFlottant(std::vector<uint8_t>& bloc, float valeur) {
+    uint32_t bits;
+    std::memcpy(&bits, &valeur, sizeof(bits));
+    ajouter32(bloc, bits);
+}
+
+/**
+ * @brief Nombre d'octets d'une ligne de pixels sérialisée.
+ * 
+ * @param format Format des pixels.
+ * @param largeur Largeur en pixels.
+ * @return size_t Octets par ligne, sans remplissage.
+ */
+static size_t octetsParLigne(PixelFormat format, int largeur) {
+    return format == PixelFormat::Bit1 ? (static_cast<size_t>(largeur) + 7) / 8 : static_cast<size_t>(largeur);
+}
+
+/**
+ * @brief Sérialise l'atlas en un bloc binaire.
+ * 
+ * @return std::vector<uint8_t> Le bloc.
+ */
+std::vector<uint8_t> AtlasGlyphes::serialiser() const {
+    const size_t ligne = octetsParLigne(bitmap.getFormat(), bitmap.getWidth());
+    std::vector<uint8_t> bloc;
+    bloc.reserve(32 + metriques.size() * 44 + ligne * bitmap.getHeight());
+
+    bloc.insert(bloc.end(), SIGNATURE, SIGNATURE + sizeof(SIGNATURE));
+    ajouter32(bloc, VERSION);
+    ajouter32(bloc, static_cast<uint32_t>(taille));
+    ajouter32(bloc, static_cast<uint32_t>(bitmap.getFormat()));
+    ajouter32(bloc, static_cast<uint32_t>(bitmap.getWidth()));
+    ajouter32(bloc, static_cast<uint32_t>(bitmap.getHeight()));
+    ajouter32(bloc, static_cast<uint32_t>(metriques.size()));
+
+    for (const MetriqueGlyphe& metrique : metriques) {
+        bloc.push_back(static_cast<uint8_t>(metrique.lettre));
+        bloc.push_back(static_cast<uint8_t>(metrique.style));
+        bloc.push_back(0);
+        bloc.push_back(0);
+        for (int valeur : {metrique.zone.x, metrique.zone.y, metrique.zone.largeur, metrique.zone.hauteur,
+                           metrique.decalageX, metrique.decalageY, metrique.avance}) {
+            ajouter32(bloc, static_cast<uint32_t>(valeur));
+        }
+        for (float valeur : {metrique.u0, metrique.v0, metrique.u1, metrique.v1}) {
+            ajouterFlottant(bloc, valeur);
+        }
+    }
+
+    for (int y = 0; y < bitmap.getHeight(); ++y) {
+        bloc.insert(bloc.end(), bitmap.row(y), bitmap.row(y) + ligne);
+    }
+    return bloc;
+}
+
+/**
+ * @brief Lecteur séquentiel d'un bloc sérialisé.
+ */
+struct LecteurBloc {
+    const uint8_t* donnees;  ///< Début du bloc.
+    size_t taille;           ///< Taille du bloc.
+    size_t position = 0;     ///< Prochain octet à lire.
+
+    /**
+     * @brief Réserve les prochains octets du bloc.
+     * 
+     * @param n Nombre d'octets.
+     * @return const uint8_t* Le premier de ces octets.
+     * 
+     * @throws std::runtime_error Si le bloc est trop court.
+     */
+    const uint8_t* prendre(size_t n) {
+        if (taille - position < n) {
+            throw std::runtime_error("Atlas de glyphes tronqué.");
+        }
+        const uint8_t* debut = donnees + position;
+        position += n;
+        return debut;
+    }
+
+    /**
+     * @brief Nombre d'octets restant à lire.
+     * 
+     * @return size_t Le nombre d'octets.
+     */
+    size_t restant() const {
+        return taille - position;
+    }
+
+    /**
+     * @brief Lit un entier de 32 bits en petit-boutiste.
+     * 
+     * @return uint32_t La valeur lue.
+     */
+    uint32_t lire32() {
+        const uint8_t* octets = prendre(4);
+        return static_cast<uint32_t>(octets[0]) | (static_cast<uint32_t>(octets[1]) << 8)
+             | (static_cast<uint32_t>(octets[2]) << 16) | (static_cast<uint32_t>(octets[3]) << 24);
+    }
+
+    /**
+     * @brief Lit un flottant de 32 bits en petit-boutiste.
+     * 
+     * @return float La valeur lue.
+     */
+    float lireFlottant() {
+        const uint32_t bits = lire32();
+        float valeur;
+        std::memcpy(&valeur, &bits, sizeof(valeur));
+        return valeur;
+    }
+};
+
+/**
+ * @brief Reconstruit un atlas à partir d'un bloc binaire.
+ * 
+ * @param donnees Début du bloc.
+ * @param taille Taille du bloc.
+ * @return AtlasGlyphes L'atlas.
+ */
+AtlasGlyphes AtlasGlyphes::deserialiser(const uint8_t* donnees, size_t taille) {
+    LecteurBloc lecteur{donnees, taille};
+    if (std::memcmp(lecteur.prendre(sizeof(SIGNATURE)), SIGNATURE, sizeof(SIGNATURE)) != 0) {
+        throw std::runtime_error("Le bloc n'est pas un atlas de glyphes.");
+    }
+    if (lecteur.lire32() != VERSION) {
+        throw std::runtime_error("Version d'atlas de glyphes non prise en charge.");
+    }
+    const int tailleRendu = static_cast<int>(lecteur.lire32());
+    const uint32_t format = lecteur.lire32();
+    const uint32_t largeur = lecteur.lire32();
+    const uint32_t hauteur = lecteur.lire32();
+    const uint32_t nbGlyphes = lecteur.lire32();
+    if (format > static_cast<uint32_t>(PixelFormat::Coverage8) || largeur == 0 || hauteur == 0
+        || largeur > (1u << 20) || hauteur > (1u << 20)) {
+        throw std::runtime_error("En-tête d'atlas de glyphes invalide.");
+    }
+    // Table et pixels doivent tenir dans le bloc avant toute allocation à leur taille
+    const size_t ligne = octetsParLigne(static_cast<PixelFormat>(format), static_cast<int>(largeur));
+    if (nbGlyphes > lecteur.restant() / TAILLE_METRIQUE
+        || hauteur > (lecteur.restant() - nbGlyphes * TAILLE_METRIQUE) / ligne) {
+        throw std::runtime_error("Atlas de glyphes tronqué.");
+    }
+
+    std::vector<MetriqueGlyphe> metriques;
+    metriques.reserve(nbGlyphes);
+    for (uint32_t i = 0; i < nbGlyphes; ++i) {
+        const uint8_t* entete = lecteur.prendre(4);
+        if (entete[1] > static_cast<uint8_t>(StyleRendu::Lisse)) {
+            throw std::runtime_error("Style inconnu dans l'atlas de glyphes.");
+        }
+        MetriqueGlyphe metrique;
+        metrique.lettre = static_cast<char>(entete[0]);
+        metrique.style = static_cast<StyleRendu>(entete[1]);
+        metrique.zone.x = static_cast<int>(lecteur.lire32());
+        metrique.zone.y = static_cast<int>(lecteur.lire32());
+        metrique.zone.largeur = static_cast<int>(lecteur.lire32());
+        metrique.zone.hauteur = static_cast<int>(lecteur.lire32());
+        metrique.decalageX = static_cast<int>(lecteur.lire32());
+        metrique.decalageY = static_cast<int>(lecteur.lire32());
+        metrique.avance = static_cast<int>(lecteur.lire32());
+        metrique.u0 = lecteur.lireFlottant();
+        metrique.v0 = lecteur.lireFlottant();
+        metrique.u1 = lecteur.lireFlottant();
+        metrique.v1 = lecteur.lireFlottant();
+        const Rectangle& zone = metrique.zone;
+        if (zone.x < 0 || zone.y < 0 || zone.largeur < 0 || zone.hauteur < 0
+            || static_cast<uint32_t>(zone.x) + static_cast<uint32_t>(zone.largeur) > largeur
+            || static_cast<uint32_t>(zone.y) + static_cast<uint32_t>(zone.hauteur) > hauteur) {
+            throw std::runtime_error("Zone de glyphe hors de l'atlas de glyphes.");
+        }
+        metriques.push_back(metrique);
+    }
+
+    Bitmap bitmap(static_cast<int>(largeur), static_cast<int>(hauteur), static_cast<PixelFormat>(format));
+    for (int y = 0; y < bitmap.getHeight(); ++y) {
+        std::memcpy(bitmap.row(y), lecteur.prendre(ligne), ligne);
+    }
+    return AtlasGlyphes(std::move(bitmap), tailleRendu, std::move(metriques));
+}
+
+using Fichier = std::unique_ptr<FILE, int (*)(FILE*)>;
+
+/**
+ * @brief Écrit l'atlas sérialisé dans un fichier.
+ * 
+ * @param chemin Chemin du fichier.
+ */
+void AtlasGlyphes::ecrire(const std::string& chemin) const {
+    const std::vector<uint8_t> bloc = serialiser();
+    Fichier fichier(std::fopen(chemin.c_str(), "wb"), &std::fclose);
+    if (!fichier) {
+        throw std::ios_base::failure("Impossible de créer le fichier : " + chemin);
+    }
+    if (std::fwrite(bloc.data(), 1, bloc.size(), fichier.get()) != bloc.size()
+        || std::fclose(fichier.release()) != 0) {
+        throw std::ios_base::failure("Erreur d'écriture dans le fichier : " + chemin);
+    }
+}
+
+/**
+ * @brief Lit un atlas écrit par ecrire().
+ * 
+ * @param chemin Chemin du fichier.
+ * @return AtlasGlyphes L'atlas.
+ */
+AtlasGlyphes AtlasGlyphes::lire(const std::string& chemin) {
+    Fichier fichier(std::fopen(chemin.c_str(), "rb"), &std::fclose);
+    if (!fichier) {
+        throw std::ios_base::failure("Impossible d'ouvrir le fichier : " + chemin);
+    }
+    std::fseek(fichier.get(), 0, SEEK_END);
+    const long taille = std::ftell(fichier.get());
+    std::fseek(fichier.get(), 0, SEEK_SET);
+    if (taille < 0) {
+        throw std::ios_base::failure("Erreur de lecture du fichier : " + chemin);
+    }
+    std::vector<uint8_t> bloc(static_cast<size_t>(taille));
+    if (std::fread(bloc.data(), 1, bloc.size(), fichier.get()) != bloc.size()) {
+        throw std::ios_base::failure("Erreur de lecture du fichier : " + chemin);
+    }
+    return deserialiser(bloc.data(), bloc.size());
+}
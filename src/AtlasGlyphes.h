@@ -0,0 +1,153 @@
+#ifndef ATLAS_GLYPHES_H
+#define ATLAS_GLYPHES_H
+
+#include "Bitmap.h"
+#include "Composition.h"
+#include "Rendu.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Place et dimensions d'un glyphe dans un atlas.
+ */
+struct MetriqueGlyphe {
+    char lettre;       ///< La lettre rendue.
+    StyleRendu style;  ///< Le style du rendu.
+    Rectangle zone;    ///< Boîte de l'encre dans l'atlas (largeur et hauteur nulles si la lettre n'a pas d'encre).
+    float u0;          ///< Bord gauche de la zone, en coordonnée de texture (0 à 1).
+    float v0;          ///< Bord haut de la zone, en coordonnée de texture.
+    float u1;          ///< Bord droit de la zone, en coordonnée de texture.
+    float v1;          ///< Bord bas de la zone, en coordonnée de texture.
+    int decalageX;     ///< Approche : colonne du premier pixel encré dans la cellule de rendu.
+    int decalageY;     ///< Ligne du premier pixel encré dans la cellule de rendu.
+    int avance;        ///< Avance horizontale : largeur de la cellule de rendu.
+};
+
+/**
+ * @brief Atlas de glyphes : les rendus de plusieurs lettres et styles dans un seul bitmap.
+ * 
+ * Chaque rendu est réduit à la boîte englobante de son encre, puis les boîtes
+ * sont rangées par un algorithme de ligne d'horizon (skyline, placement le
+ * plus bas puis le plus à gauche, des plus hautes aux plus basses). La table
+ * des métriques permet de replacer chaque glyphe dans sa cellule d'origine.
+ * L'atlas complet (pixels et métriques) se sérialise en un seul bloc binaire,
+ * lu en une seule fois.
+ */
+class AtlasGlyphes {
+public:
+    /**
+     * @brief Construit un atlas en rendant chaque lettre dans chaque style.
+     * 
+     * Le format de l'atlas est Bit1 si tous les styles sont monochromes,
+     * Coverage8 si le style Lisse est demandé, Index8 sinon.
+     * 
+     * @param lettres Les lettres à rendre (converties en majuscules).
+     * @param styles Les styles de rendu.
+     * @param taille Hauteur des rendus en pixels.
+     * @param largeurMax Largeur visée de l'atlas (élargie si un glyphe est plus large).
+     * @param marge Pixels vides laissés entre deux glyphes.
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0, si largeurMax ou la marge
+     *         sont invalides, ou si les styles Lisse et ContourRouge sont mélangés.
+     */
+    AtlasGlyphes(const std::string& lettres, const std::vector<StyleRendu>& styles, int taille,
+                 int largeurMax = 1024, int marge = 1);
+
+    /**
+     * @brief Bitmap de l'atlas.
+     * 
+     * @return const Bitmap& Les pixels de tous les glyphes.
+     */
+    const Bitmap& getBitmap() const;
+
+    /**
+     * @brief Table des métriques, dans l'ordre des lettres puis des styles.
+     * 
+     * @return const std::vector<MetriqueGlyphe>& Une entrée par rendu.
+     */
+    const std::vector<MetriqueGlyphe>& getMetriques() const;
+
+    /**
+     * @brief Hauteur des rendus.
+     * 
+     * @return int La taille en pixels.
+     */
+    int getTaille() const;
+
+    /**
+     * @brief Recherche les métriques d'un rendu.
+     * 
+     * @param lettre La lettre (majuscule).
+     * @param style Le style.
+     * @return const MetriqueGlyphe* L'entrée, ou nullptr si le rendu n'est pas dans l'atlas.
+     */
+    const MetriqueGlyphe* trouver(char lettre, StyleRendu style) const;
+
+    /**
+     * @brief Part de la surface de l'atlas occupée par des glyphes.
+     * 
+     * @return double Somme des zones divisée par la surface du bitmap.
+     */
+    double getTauxRemplissage() const;
+
+    /**
+     * @brief Sérialise l'atlas en un bloc binaire.
+     * 
+     * En-tête "ATLG", version, taille, format et dimensions, puis la table des
+     * métriques, puis les lignes de pixels sans remplissage (1 bit par pixel en
+     * Bit1, poids faible d'abord ; 1 octet sinon). Entiers et flottants en
+     * petit-boutiste.
+     * 
+     * @return std::vector<uint8_t> Le bloc.
+     */
+    std::vector<uint8_t> serialiser() const;
+
+    /**
+     * @brief Reconstruit un atlas à partir d'un bloc binaire.
+     * 
+     * @param donnees Début du bloc.
+     * @param taille Taille du bloc en octets.
+     * @return AtlasGlyphes L'atlas.
+     * 
+     * @throws std::runtime_error Si le bloc est tronqué, n'est pas un atlas ou place une zone hors de l'atlas.
+     */
+    static AtlasGlyphes deserialiser(const uint8_t* donnees, size_t taille);
+
+    /**
+     * @brief Écrit l'atlas sérialisé dans un fichier, en une seule écriture.
+     * 
+     * @param chemin Chemin du fichier.
+     * 
+     * @throws std::ios_base::failure Si le fichier ne peut pas être écrit.
+     */
+    void ecrire(const std::string& chemin) const;
+
+    /**
+     * @brief Lit un atlas écrit par ecrire(), en une seule lecture.
+     * 
+     * @param chemin Chemin du fichier.
+     * @return AtlasGlyphes L'atlas.
+     * 
+     * @throws std::ios_base::failure Si le fichier ne peut pas être lu.
+     * @throws std::runtime_error Si le contenu n'est pas un atlas.
+     */
+    static AtlasGlyphes lire(const std::string& chemin);
+
+private:
+    /**
+     * @brief Constructeur à partir d'éléments déjà calculés (désérialisation).
+     * 
+     * @param bitmap Pixels de l'atlas.
+     * @param taille Hauteur des rendus.
+     * @param metriques Table des métriques.
+     */
+    AtlasGlyphes(Bitmap bitmap, int taille, std::vector<MetriqueGlyphe> metriques);
+
+    Bitmap bitmap;                          ///< Pixels de tous les glyphes.
+    int taille;                             ///< Hauteur des rendus.
+    std::vector<MetriqueGlyphe> metriques;  ///< Une entrée par rendu.
+};
+
+#endif // ATLAS_GLYPHES_H
@@ -0,0 +1,447 @@
+#include "BancEssai.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+/// Allocations faites par operator new.
+static std::atomic<size_t> nbAllocations{0};
+
+/// Octets demandés à operator new.
+static std::atomic<size_t> octetsAlloues{0};
+
+/**
+ * @brief Alloue un bloc et le compte, en appelant le gestionnaire new tant que la mémoire manque.
+ * 
+ * @param taille Octets demandés.
+ * @param allouer Allocation brute, renvoyant nullptr en cas d'échec.
+ * @return void* Le bloc alloué.
+ * 
+ * @throws std::bad_alloc Si la mémoire manque et qu'aucun gestionnaire n'est installé.
+ */
+template <class Allocation>
+static void* allouerCompte(std::size_t taille, Allocation&& allouer) {
+    nbAllocations.fetch_add(1, std::memory_order_relaxed);
+    octetsAlloues.fetch_add(taille, std::memory_order_relaxed);
+    for (;;) {
+        if (void* bloc = allouer()) {
+            return bloc;
+        }
+        const std::new_handler gestionnaire = std::get_new_handler();
+        if (!gestionnaire) {
+            throw std::bad_alloc();
+        }
+        gestionnaire();
+    }
+}
+
+/**
+ * @brief Alloue un bloc aligné avec malloc, de façon portable.
+ * 
+ * Le bloc est pris avec une marge d'un alignement plus un pointeur ;
+ * l'adresse renvoyée par malloc est rangée juste avant le bloc aligné, pour
+ * libererAligne().
+ * 
+ * @param taille Octets demandés.
+ * @param alignement Alignement (puissance de 2).
+ * @return void* Le bloc aligné, ou nullptr si la mémoire manque.
+ */
+static void* allouerAligne(std::size_t taille, std::size_t alignement) {
+    alignement = std::max(alignement, alignof(void*));
+    if (taille > SIZE_MAX - alignement - sizeof(void*)) {
+        return nullptr;
+    }
+    void* brut = std::malloc(taille + alignement + sizeof(void*));
+    if (!brut) {
+        return nullptr;
+    }
+    const std::uintptr_t debut = reinterpret_cast<std::uintptr_t>(brut) + sizeof(void*);
+    void* bloc = reinterpret_cast<void*>((debut + alignement - 1) & ~static_cast<std::uintptr_t>(alignement - 1));
+    static_cast<void**>(bloc)[-1] = brut;
+    return bloc;
+}
+
+/**
+ * @brief Libère un bloc obtenu par allouerAligne().
+ * 
+ * @param bloc Bloc à libérer (nullptr accepté).
+ */
+static void libererAligne(void* bloc) noexcept {
+    if (bloc) {
+        std::free(static_cast<void**>(bloc)[-1]);
+    }
+}
+
+// Toutes les formes de new et delete sont remplacées ensemble : un bloc
+// alloué par une forme de la bibliothèque ne doit jamais atteindre les
+// delete ci-dessous, qui libèrent avec free() ou libererAligne().
+
+/**
+ * @brief Opérateur new global, remplacé pour compter les allocations.
+ * 
+ * @param taille Octets demandés.
+ * @return void* Le bloc alloué.
+ * 
+ * @throws std::bad_alloc Si la mémoire manque.
+ */
+void* operator new(std::size_t taille) {
+    return allouerCompte(taille, [taille]() { return std::malloc(taille != 0 ? taille : 1); });
+}
+
+/**
+ * @brief Opérateur new[] global, compté comme operator new.
+ * 
+ * @param taille Octets demandés.
+ * @return void* Le bloc alloué.
+ */
+void* operator new[](std::size_t taille) {
+    return operator new(taille);
+}
+
+/**
+ * @brief Opérateur new global sans exception.
+ * 
+ * @param taille Octets demandés.
+ * @return void* Le bloc alloué, ou nullptr si la mémoire manque.
+ */
+void* operator new(std::size_t taille, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(taille);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Opérateur new[] global sans exception.
+ * 
+ * @param taille Octets demandés.
+ * @return void* Le bloc alloué, ou nullptr si la mémoire manque.
+ */
+void* operator new[](std::size_t taille, const std::nothrow_t&) noexcept {
+    return operator new(taille, std::nothrow);
+}
+
+/**
+ * @brief Opérateur new global aligné, compté comme operator new.
+ * 
+ * Utilisé pour les types sur-alignés et par std::pmr::new_delete_resource(),
+ * donc par les conteneurs std::pmr de la ressource par défaut.
+ * 
+ * @param taille Octets demandés.
+ * @param alignement Alignement demandé (puissance de 2).
+ * @return void* Le bloc alloué.
+ * 
+ * @throws std::bad_alloc Si la mémoire manque.
+ */
+void* operator new(std::size_t taille, std::align_val_t alignement) {
+    return allouerCompte(taille, [taille, alignement]() {
+        return allouerAligne(taille, static_cast<std::size_t>(alignement));
+    });
+}
+
+/**
+ * @brief Opérateur new[] global aligné.
+ * 
+ * @param taille Octets demandés.
+ * @param alignement Alignement demandé.
+ * @return void* Le bloc alloué.
+ */
+void* operator new[](std::size_t taille, std::align_val_t alignement) {
+    return operator new(taille, alignement);
+}
+
+/**
+ * @brief Opérateur new global aligné sans exception.
+ * 
+ * @param taille Octets demandés.
+ * @param alignement Alignement demandé.
+ * @return void* Le bloc alloué, ou nullptr si la mémoire manque.
+ */
+void* operator new(std::size_t taille, std::align_val_t alignement, const std::nothrow_t&) noexcept {
+    try {
+        return operator new(taille, alignement);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Opérateur new[] global aligné sans exception.
+ * 
+ * @param taille Octets demandés.
+ * @param alignement Alignement demandé.
+ * @return void* Le bloc alloué, ou nullptr si la mémoire manque.
+ */
+void* operator new[](std::size_t taille, std::align_val_t alignement, const std::nothrow_t&) noexcept {
+    return operator new(taille, alignement, std::nothrow);
+}
+
+/**
+ * @brief Opérateur delete global, associé à operator new.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete(void* bloc) noexcept {
+    std::free(bloc);
+}
+
+/**
+ * @brief Opérateur delete[] global.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete[](void* bloc) noexcept {
+    std::free(bloc);
+}
+
+/**
+ * @brief Opérateur delete global avec taille.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete(void* bloc, std::size_t) noexcept {
+    std::free(bloc);
+}
+
+/**
+ * @brief Opérateur delete[] global avec taille.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete[](void* bloc, std::size_t) noexcept {
+    std::free(bloc);
+}
+
+/**
+ * @brief Opérateur delete global sans exception.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete(void* bloc, const std::nothrow_t&) noexcept {
+    std::free(bloc);
+}
+
+/**
+ * @brief Opérateur delete[] global sans exception.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete[](void* bloc, const std::nothrow_t&) noexcept {
+    std::free(bloc);
+}
+
+/**
+ * @brief Opérateur delete global aligné.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete(void* bloc, std::align_val_t) noexcept {
+    libererAligne(bloc);
+}
+
+/**
+ * @brief Opérateur delete[] global aligné.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete[](void* bloc, std::align_val_t) noexcept {
+    libererAligne(bloc);
+}
+
+/**
+ * @brief Opérateur delete global aligné avec taille.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete(void* bloc, std::size_t, std::align_val_t) noexcept {
+    libererAligne(bloc);
+}
+
+/**
+ * @brief Opérateur delete[] global aligné avec taille.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete[](void* bloc, std::size_t, std::align_val_t) noexcept {
+    libererAligne(bloc);
+}
+
+/**
+ * @brief Opérateur delete global aligné sans exception.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete(void* bloc, std::align_val_t, const std::nothrow_t&) noexcept {
+    libererAligne(bloc);
+}
+
+/**
+ * @brief Opérateur delete[] global aligné sans exception.
+ * 
+ * @param bloc Bloc à libérer.
+ */
+void operator delete[](void* bloc, std::align_val_t, const std::nothrow_t&) noexcept {
+    libererAligne(bloc);
+}
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param repetitions Répétitions chronométrées par mesure.
+ * @param dureeMin Durée minimale d'une répétition, en secondes.
+ */
+BancEssai::BancEssai(size_t repetitions, double dureeMin) : repetitions(repetitions), dureeMin(dureeMin) {
+    if (repetitions == 0 || dureeMin < 0.0) {
+        throw std::invalid_argument("Le banc d'essai demande au moins une répétition et une durée positive.");
+    }
+}
+
+/**
+ * @brief Mesure une opération.
+ * 
+ * @param groupe Groupe de la mesure.
+ * @param nom Nom de la mesure.
+ * @param operation L'opération.
+ * @return const ResultatMesure& Le résultat.
+ */
+const ResultatMesure& BancEssai::mesurer(const std::string& groupe, const std::string& nom,
+                                         const std::function<void()>& operation) {
+    using Horloge = std::chrono::steady_clock;
+    auto chronometrer = [&operation](size_t iterations) {
+        const auto debut = Horloge::now();
+        for (size_t i = 0; i < iterations; ++i) {
+            operation();
+        }
+        return std::chrono::duration<double>(Horloge::now() - debut).count();
+    };
+
+    // Mise en température et calibrage
+    operation();
+    size_t iterations = 1;
+    while (chronometrer(iterations) < dureeMin && iterations < (size_t(1) << 40)) {
+        iterations *= 2;
+    }
+
+    ResultatMesure resultat;
+    resultat.groupe = groupe;
+    resultat.nom = nom;
+    resultat.repetitions = repetitions;
+    resultat.iterations = iterations;
+    std::vector<double> durees(repetitions);
+    const size_t allocationsDebut = getNbAllocations();
+    const size_t octetsDebut = getOctetsAlloues();
+    for (double& duree : durees) {
+        duree = chronometrer(iterations) * 1e9 / iterations;
+    }
+    const double appels = static_cast<double>(repetitions) * iterations;
+    resultat.allocations = (getNbAllocations() - allocationsDebut) / appels;
+    resultat.octets = (getOctetsAlloues() - octetsDebut) / appels;
+
+    double somme = 0.0;
+    for (double duree : durees) {
+        somme += duree;
+    }
+    resultat.moyenne = somme / repetitions;
+    double ecarts = 0.0;
+    for (double duree : durees) {
+        ecarts += (duree - resultat.moyenne) * (duree - resultat.moyenne);
+    }
+    resultat.ecartType = repetitions > 1 ? std::sqrt(ecarts / (repetitions - 1)) : 0.0;
+    resultat.minimum = *std::min_element(durees.begin(), durees.end());
+    resultat.maximum = *std::max_element(durees.begin(), durees.end());
+
+    resultats.push_back(resultat);
+    return resultats.back();
+}
+
+/**
+ * @brief Résultats des mesures.
+ * 
+ * @return const std::vector<ResultatMesure>& Les résultats.
+ */
+const std::vector<ResultatMesure>& BancEssai::getResultats() const {
+    return resultats;
+}
+
+/**
+ * @brief Échappe une chaîne pour JSON.
+ * 
+ * @param texte Texte UTF-8.
+ * @return std::string La chaîne entre guillemets.
+ */
+std::string BancEssai::chaineJson(const std::string& texte) {
+    std::string sortie = "\"";
+    for (char c : texte) {
+        if (c == '"' || c == '\\') {
+            sortie += '\\';
+            sortie += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            static const char hexa[] = "0123456789abcdef";
+            sortie += "\\u00";
+            sortie += hexa[(c >> 4) & 0xF];
+            sortie += hexa[c & 0xF];
+        } else {
+            sortie += c;
+        }
+    }
+    return sortie + '"';
+}
+
+/**
+ * @brief Écrit les résultats en JSON.
+ * 
+ * @param sortie Flux de sortie.
+ * @param contexte Paires ajoutées au contexte.
+ */
+void BancEssai::ecrireJson(std::ostream& sortie, const std::vector<std::pair<std::string, std::string>>& contexte) const {
+    const auto precision = sortie.precision(9);
+    sortie << "{\n  \"contexte\": {\n";
+#if defined(__clang__)
+    sortie << "    \"compilateur\": " << chaineJson("clang " __clang_version__) << ",\n";
+#elif defined(__GNUC__)
+    sortie << "    \"compilateur\": " << chaineJson("gcc " __VERSION__) << ",\n";
+#endif
+#ifdef NDEBUG
+    sortie << "    \"ndebug\": true,\n";
+#else
+    sortie << "    \"ndebug\": false,\n";
+#endif
+    for (const auto& paire : contexte) {
+        sortie << "    " << chaineJson(paire.first) << ": " << chaineJson(paire.second) << ",\n";
+    }
+    sortie << "    \"repetitions\": " << repetitions << ",\n";
+    sortie << "    \"duree_min_s\": " << dureeMin << "\n  },\n  \"resultats\": [";
+    for (size_t i = 0; i < resultats.size(); ++i) {
+        const ResultatMesure& r = resultats[i];
+        sortie << (i == 0 ? "\n" : ",\n") << "    {\"groupe\": " << chaineJson(r.groupe) << ", \"nom\": " << chaineJson(r.nom)
+               << ", \"repetitions\": " << r.repetitions << ", \"iterations\": " << r.iterations
+               << ", \"moyenne_ns\": " << r.moyenne << ", \"ecart_type_ns\": " << r.ecartType
+               << ", \"min_ns\": " << r.minimum << ", \"max_ns\": " << r.maximum
+               << ", \"allocations\": " << r.allocations << ", \"octets_alloues\": " << r.octets << "}";
+    }
+    sortie << "\n  ]\n}\n";
+    sortie.precision(precision);
+}
+
+/**
+ * @brief Nombre d'allocations faites par operator new.
+ * 
+ * @return size_t Le nombre d'allocations.
+ */
+size_t BancEssai::getNbAllocations() {
+    return nbAllocations.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Octets demandés à operator new.
+ * 
+ * @return size_t Le nombre d'octets.
+ */
+size_t BancEssai::getOctetsAlloues() {
+    return octetsAlloues.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,110 @@
+#ifndef BANC_ESSAI_H
+#define BANC_ESSAI_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Résultat d'une mesure : durées par itération, en nanosecondes.
+ */
+struct ResultatMesure {
+    std::string groupe;        ///< Groupe de la mesure (par exemple "bezier").
+    std::string nom;           ///< Nom de la mesure, paramètres compris.
+    size_t repetitions = 0;    ///< Nombre de répétitions chronométrées.
+    size_t iterations = 0;     ///< Appels de l'opération par répétition.
+    double moyenne = 0.0;      ///< Durée moyenne d'un appel sur les répétitions.
+    double ecartType = 0.0;    ///< Écart type de la durée d'un appel entre répétitions.
+    double minimum = 0.0;      ///< Durée d'un appel dans la répétition la plus rapide.
+    double maximum = 0.0;      ///< Durée d'un appel dans la répétition la plus lente.
+    double allocations = 0.0;  ///< Allocations (operator new) par appel.
+    double octets = 0.0;       ///< Octets alloués par appel.
+};
+
+/**
+ * @brief Banc d'essai : chronomètre des opérations et compte leurs allocations.
+ * 
+ * Chaque opération est d'abord appelée une fois (mise en température), puis
+ * le nombre d'appels par répétition est doublé jusqu'à ce qu'une répétition
+ * dure au moins la durée minimale. Les répétitions sont ensuite chronométrées
+ * une à une ; le résultat donne la moyenne, l'écart type et les extrêmes de
+ * la durée d'un appel, ainsi que le nombre moyen d'allocations par appel.
+ * 
+ * Les allocations sont comptées par les opérateurs new globaux, remplacés
+ * dans BancEssai.cpp : le compte couvre tout le programme, les mesures
+ * doivent donc être faites depuis un seul thread.
+ */
+class BancEssai {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param repetitions Nombre de répétitions chronométrées par mesure.
+     * @param dureeMin Durée minimale d'une répétition, en secondes.
+     * 
+     * @throws std::invalid_argument Si repetitions vaut 0 ou si dureeMin est négative.
+     */
+    explicit BancEssai(size_t repetitions = 10, double dureeMin = 0.01);
+
+    /**
+     * @brief Mesure une opération et conserve le résultat.
+     * 
+     * @param groupe Groupe de la mesure.
+     * @param nom Nom de la mesure.
+     * @param operation L'opération, appelée de nombreuses fois.
+     * @return const ResultatMesure& Le résultat.
+     */
+    const ResultatMesure& mesurer(const std::string& groupe, const std::string& nom,
+                                  const std::function<void()>& operation);
+
+    /**
+     * @brief Résultats des mesures, dans l'ordre.
+     * 
+     * @return const std::vector<ResultatMesure>& Les résultats.
+     */
+    const std::vector<ResultatMesure>& getResultats() const;
+
+    /**
+     * @brief Écrit les résultats en JSON.
+     * 
+     * Un objet `contexte` (compilateur, options, répétitions, durée minimale)
+     * suivi d'un tableau `resultats` : un objet par mesure, durées en
+     * nanosecondes, dans l'ordre des mesures.
+     * 
+     * @param sortie Flux de sortie.
+     * @param contexte Paires (clé, valeur) ajoutées au contexte.
+     */
+    void ecrireJson(std::ostream& sortie, const std::vector<std::pair<std::string, std::string>>& contexte = {}) const;
+
+    /**
+     * @brief Échappe une chaîne pour JSON (guillemets, barres obliques inverses, caractères de contrôle).
+     * 
+     * @param texte Texte UTF-8.
+     * @return std::string La chaîne entre guillemets.
+     */
+    static std::string chaineJson(const std::string& texte);
+
+    /**
+     * @brief Nombre d'allocations faites par operator new depuis le démarrage.
+     * 
+     * @return size_t Le nombre d'allocations.
+     */
+    static size_t getNbAllocations();
+
+    /**
+     * @brief Octets demandés à operator new depuis le démarrage.
+     * 
+     * @return size_t Le nombre d'octets.
+     */
+    static size_t getOctetsAlloues();
+
+private:
+    size_t repetitions;                     ///< Répétitions chronométrées par mesure.
+    double dureeMin;                        ///< Durée minimale d'une répétition (secondes).
+    std::vector<ResultatMesure> resultats;  ///< Résultats, dans l'ordre des mesures.
+};
+
+#endif // BANC_ESSAI_H
@@ -1,5 +1,22 @@
 #include "BezierCourbe.h"
+#include "Trace.h"
 #include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+/**
+ * @brief Vérifie qu'une résolution est exploitable avant d'allouer le résultat.
+ * 
+ * @param resolution Nombre de segments demandé.
+ * 
+ * @throws std::invalid_argument Si la résolution est < 1.
+ */
+static void verifierResolution(int resolution) {
+    if (resolution < 1) {
+        throw std::invalid_argument("La résolution doit être au moins égale à 1.");
+    }
+}
 
 /**
  * @brief Calcul des points d'une courbe de Bézier linéaire.
@@ -13,11 +30,10 @@
  * @return std::vector<Point> Un vecteur contenant les points calculés.
  */
 std::vector<Point> BezierCourbe::courbeLineaire(const Point& P0, const Point& P1, int nb_points) {
-    std::vector<Point> points;
-    for (int i = 0; i <= nb_points; ++i) {
-        float t = static_cast<float>(i) / nb_points;
-        points.push_back(Point::interpolation(P0, P1, t));
-    }
+    const Point controlPoints[2] = {P0, P1};
+    verifierResolution(nb_points);
+    std::vector<Point> points(nb_points + 1);
+    BezierCourbe::evaluer(controlPoints, 2, nb_points, points.data());
     return points;
 }
 
@@ -34,41 +50,189 @@ std::vector<Point> BezierCourbe::courbeLineaire(const Point& P0, const Point& P1
  * @return std::vector<Point> Un vecteur contenant les points calculés.
  */
 std::vector<Point> BezierCourbe::courbeQuadratique(const Point& P0, const Point& C, const Point& P1, int nb_points) {
-    std::vector<Point> controlPoints = {P0, C, P1};
-    return BezierCourbe::deCasteljau(controlPoints, nb_points);
+    const Point controlPoints[3] = {P0, C, P1};
+    verifierResolution(nb_points);
+    std::vector<Point> points(nb_points + 1);
+    BezierCourbe::evaluer(controlPoints, 3, nb_points, points.data());
+    return points;
 }
 
 /**
  * @brief Algorithme de de Casteljau pour les courbes de Bézier de degré N.
  * 
- * Calcule les points d'une courbe de Bézier générique en utilisant
- * l'algorithme de de Casteljau pour interpoler les points de contrôle.
+ * Calcule les points d'une courbe de Bézier générique. Le vecteur résultat est
+ * alloué une seule fois ; l'évaluation elle-même est déléguée à evaluer().
  * 
  * @param controlPoints Un vecteur contenant les points de contrôle.
  * @param resolution Nombre de points à générer pour la courbe.
  * @return std::vector<Point> Un vecteur contenant les points calculés.
  */
 std::vector<Point> BezierCourbe::deCasteljau(const std::vector<Point>& controlPoints, int resolution) {
-    std::vector<Point> points;
+    verifierResolution(resolution);
+    std::vector<Point> points(resolution + 1);
+    BezierCourbe::evaluer(controlPoints.data(), static_cast<int>(controlPoints.size()), resolution, points.data());
+    return points;
+}
 
-    for (int i = 0; i <= resolution; ++i) {
-        float t = static_cast<float>(i) / resolution;
+/**
+ * @brief Évaluation sans allocation d'une courbe de Bézier.
+ * 
+ * Pour les degrés 1 à 3, la courbe est mise sous forme polynomiale
+ * (a t³ + b t² + c t + d) puis parcourue par différences avant avec un pas
+ * h = 1 / resolution. Les accumulateurs sont en double afin que l'erreur
+ * cumulée reste négligeable devant le pixel. Les degrés supérieurs sont
+ * calculés par de Casteljau dans un tableau local.
+ * 
+ * @param controlPoints Tableau des points de contrôle.
+ * @param nbControlPoints Nombre de points de contrôle.
+ * @param resolution Nombre de segments.
+ * @param sortie Tampon recevant resolution + 1 points.
+ */
+void BezierCourbe::evaluer(const Point* controlPoints, int nbControlPoints, int resolution, Point* sortie) {
+    if (nbControlPoints < 1) {
+        throw std::invalid_argument("Une courbe de Bézier nécessite au moins un point de contrôle.");
+    }
+    verifierResolution(resolution);
+    TRACE_ECHANTILLONS(resolution + 1);
 
-        // Créer une copie des points de contrôle pour l'itération
-        std::vector<Point> tempPoints = controlPoints;
+    const Point& premier = controlPoints[0];
+    const Point& dernier = controlPoints[nbControlPoints - 1];
 
-        // Appliquer l'algorithme de de Casteljau
-        while (tempPoints.size() > 1) {
-            std::vector<Point> nextLevel;
-            for (size_t j = 0; j < tempPoints.size() - 1; ++j) {
-                nextLevel.push_back(Point::interpolation(tempPoints[j], tempPoints[j + 1], t));
+    if (nbControlPoints == 1) {
+        for (int i = 0; i <= resolution; ++i) {
+            sortie[i] = premier;
+        }
+        return;
+    }
+
+    if (nbControlPoints <= 4) {
+        // Coefficients polynomiaux, élevés au degré 3 (les termes inutiles sont nuls)
+        double ax = 0.0, ay = 0.0, bx = 0.0, by = 0.0, cx, cy;
+        const double x0 = controlPoints[0].getX(), y0 = controlPoints[0].getY();
+        const double x1 = controlPoints[1].getX(), y1 = controlPoints[1].getY();
+        if (nbControlPoints == 2) {
+            cx = x1 - x0;
+            cy = y1 - y0;
+        } else if (nbControlPoints == 3) {
+            const double x2 = controlPoints[2].getX(), y2 = controlPoints[2].getY();
+            bx = x0 - 2.0 * x1 + x2;
+            by = y0 - 2.0 * y1 + y2;
+            cx = 2.0 * (x1 - x0);
+            cy = 2.0 * (y1 - y0);
+        } else {
+            const double x2 = controlPoints[2].getX(), y2 = controlPoints[2].getY();
+            const double x3 = controlPoints[3].getX(), y3 = controlPoints[3].getY();
+            ax = -x0 + 3.0 * (x1 - x2) + x3;
+            ay = -y0 + 3.0 * (y1 - y2) + y3;
+            bx = 3.0 * (x0 - 2.0 * x1 + x2);
+            by = 3.0 * (y0 - 2.0 * y1 + y2);
+            cx = 3.0 * (x1 - x0);
+            cy = 3.0 * (y1 - y0);
+        }
+
+        const double h = 1.0 / resolution;
+        const double h2 = h * h;
+        const double h3 = h2 * h;
+
+        // Différences avant d'ordre 1, 2 et 3
+        double x = x0, y = y0;
+        double dx = ax * h3 + bx * h2 + cx * h;
+        double dy = ay * h3 + by * h2 + cy * h;
+        double ddx = 6.0 * ax * h3 + 2.0 * bx * h2;
+        double ddy = 6.0 * ay * h3 + 2.0 * by * h2;
+        const double dddx = 6.0 * ax * h3;
+        const double dddy = 6.0 * ay * h3;
+
+        sortie[0] = premier;
+        for (int i = 1; i < resolution; ++i) {
+            x += dx;
+            y += dy;
+            dx += ddx;
+            dy += ddy;
+            ddx += dddx;
+            ddy += dddy;
+            sortie[i] = Point(static_cast<float>(x), static_cast<float>(y));
+        }
+        sortie[resolution] = dernier;
+        return;
+    }
+
+    // Degré élevé : de Casteljau sur un tableau local, réutilisé pour chaque t
+    Point pile[NB_POINTS_MAX_PILE];
+    std::vector<Point> tas;
+    Point* niveaux = pile;
+    if (nbControlPoints > NB_POINTS_MAX_PILE) {
+        tas.resize(nbControlPoints);
+        niveaux = tas.data();
+    }
+
+    for (int i = 0; i <= resolution; ++i) {
+        float t = static_cast<float>(i) / resolution;
+        for (int j = 0; j < nbControlPoints; ++j) {
+            niveaux[j] = controlPoints[j];
+        }
+        for (int n = nbControlPoints - 1; n > 0; --n) {
+            for (int j = 0; j < n; ++j) {
+                niveaux[j] = Point::interpolation(niveaux[j], niveaux[j + 1], t);
             }
-            tempPoints = nextLevel;
         }
+        sortie[i] = niveaux[0];
+    }
+}
 
-        // Le point restant est le point de la courbe pour le t actuel
-        points.push_back(tempPoints.front());
+/**
+ * @brief Nombre de segments donné par la formule de Wang.
+ * 
+ * La plus grande différence seconde L = max |P(i+2) - 2 P(i+1) + P(i)| borne
+ * la dérivée seconde de la courbe ; l'écart entre la courbe et sa corde sur un
+ * intervalle de longueur 1/k est alors au plus n (n - 1) L / (8 k²).
+ * 
+ * @param controlPoints Tableau des points de contrôle.
+ * @param nbControlPoints Nombre de points de contrôle.
+ * @param tolerance Écart maximal toléré (en pixels).
+ * @return int Nombre de segments (de 1 à NB_SEGMENTS_MAX).
+ */
+int BezierCourbe::nombreSegments(const Point* controlPoints, int nbControlPoints, float tolerance) {
+    if (!(tolerance > 0.0f)) {
+        throw std::invalid_argument("La tolérance d'aplatissement doit être strictement positive.");
+    }
+    if (nbControlPoints <= 2) {
+        return 1;
     }
 
-    return points;
+    float L = 0.0f;
+    for (int i = 0; i + 2 < nbControlPoints; ++i) {
+        float ddx = controlPoints[i].getX() - 2.0f * controlPoints[i + 1].getX() + controlPoints[i + 2].getX();
+        float ddy = controlPoints[i].getY() - 2.0f * controlPoints[i + 1].getY() + controlPoints[i + 2].getY();
+        L = std::max(L, std::sqrt(ddx * ddx + ddy * ddy));
+    }
+
+    const float n = static_cast<float>(nbControlPoints - 1);
+    const float segments = std::ceil(std::sqrt(n * (n - 1.0f) * L / (8.0f * tolerance)));
+    if (!(segments < static_cast<float>(NB_SEGMENTS_MAX))) {
+        return NB_SEGMENTS_MAX; // Tolérance infime ou points démesurés : la conversion en int déborderait
+    }
+    return std::max(1, static_cast<int>(segments));
+}
+
+/**
+ * @brief Aplatit une courbe en ajoutant ses sommets à un vecteur.
+ * 
+ * Le vecteur est agrandi une seule fois puis rempli par evaluer().
+ * 
+ * @param controlPoints Tableau des points de contrôle.
+ * @param nbControlPoints Nombre de points de contrôle.
+ * @param tolerance Écart maximal toléré (en pixels).
+ * @param sortie Vecteur de destination.
+ * @return int Nombre de segments produits.
+ */
+int BezierCourbe::aplatir(const Point* controlPoints, int nbControlPoints, float tolerance, std::vector<Point>& sortie) {
+    if (nbControlPoints < 1) {
+        throw std::invalid_argument("Une courbe de Bézier nécessite au moins un point de contrôle.");
+    }
+    const int segments = nombreSegments(controlPoints, nbControlPoints, tolerance);
+    const size_t debut = sortie.size();
+    sortie.resize(debut + segments + 1);
+    evaluer(controlPoints, nbControlPoints, segments, sortie.data() + debut);
+    return segments;
 }
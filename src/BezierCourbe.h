@@ -46,6 +46,69 @@ public:
      */
     static std::vector<Point> deCasteljau(const std::vector<Point>& controlPoints, int resolution);
 
+    /**
+     * @brief Évalue une courbe de Bézier dans un tampon fourni par l'appelant.
+     * 
+     * Les courbes linéaires, quadratiques et cubiques sont échantillonnées par
+     * différences avant (en double précision) : chaque point coûte un nombre
+     * constant d'additions et aucune allocation n'est effectuée. Les degrés
+     * supérieurs (jusqu'à NB_POINTS_MAX_PILE points) utilisent de Casteljau sur un tableau
+     * de pile.
+     * 
+     * Précision : pour des coordonnées de module <= 4096 et une résolution
+     * <= 4096, l'écart avec la valeur exacte est inférieur à 2.5e-4 pixel, et
+     * l'écart avec l'ancien de Casteljau en float (dont l'erreur domine)
+     * inférieur à 2e-3 pixel. Le premier et le dernier point sont exactement
+     * les extrémités de la courbe.
+     * 
+     * @param controlPoints Tableau des points de contrôle.
+     * @param nbControlPoints Nombre de points de contrôle (degré + 1).
+     * @param resolution Nombre de segments (resolution + 1 points sont écrits).
+     * @param sortie Tampon d'au moins resolution + 1 points.
+     * 
+     * @throws std::invalid_argument Si la résolution est < 1 ou s'il n'y a aucun point.
+     */
+    static void evaluer(const Point* controlPoints, int nbControlPoints, int resolution, Point* sortie);
+
+    /**
+     * @brief Nombre minimal de segments pour approcher une courbe à une tolérance donnée.
+     * 
+     * Applique la formule de Wang : pour une courbe de degré n, le nombre de
+     * segments est ceil(sqrt(n (n - 1) L / (8 tolerance))), où L est la plus
+     * grande différence seconde des points de contrôle. Une droite donne
+     * toujours un seul segment. Le résultat est plafonné à NB_SEGMENTS_MAX,
+     * quelle que soit la tolérance.
+     * 
+     * @param controlPoints Tableau des points de contrôle.
+     * @param nbControlPoints Nombre de points de contrôle.
+     * @param tolerance Écart maximal toléré entre la courbe et les segments (en pixels).
+     * @return int Nombre de segments (de 1 à NB_SEGMENTS_MAX).
+     * 
+     * @throws std::invalid_argument Si la tolérance n'est pas strictement positive.
+     */
+    static int nombreSegments(const Point* controlPoints, int nbControlPoints, float tolerance);
+
+    /**
+     * @brief Aplatit une courbe de Bézier en une ligne brisée.
+     * 
+     * Le nombre de segments est donné par nombreSegments() : c'est le minimum
+     * garantissant que la ligne brisée reste à moins de `tolerance` pixels de
+     * la courbe. Les points sont ajoutés à la fin de `sortie`.
+     * 
+     * @param controlPoints Tableau des points de contrôle.
+     * @param nbControlPoints Nombre de points de contrôle.
+     * @param tolerance Écart maximal toléré (en pixels).
+     * @param sortie Vecteur auquel sont ajoutés les segments + 1 sommets.
+     * @return int Nombre de segments produits.
+     */
+    static int aplatir(const Point* controlPoints, int nbControlPoints, float tolerance, std::vector<Point>& sortie);
+
+    /// Nombre maximal de points de contrôle évalués sans allocation.
+    static const int NB_POINTS_MAX_PILE = 16;
+
+    /// Nombre maximal de segments d'une courbe aplatie, bien au-delà du pixel pour toute taille de rendu.
+    static const int NB_SEGMENTS_MAX = 1 << 16;
+
 };
 
 #endif
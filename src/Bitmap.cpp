@@ -1,25 +1,87 @@
 #include "Bitmap.h"
+#include "Trace.h"
 #include <fstream>
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 #include <iostream> // Ajoutez cette ligne
 
+// Les accès par mots (rowWords()) supposent que le pixel x d'une ligne 1 bit soit le bit x & 63 du mot x >> 6
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "Bitmap : les opérations par mots de 64 bits supposent une machine petit-boutiste."
+#endif
+
+// Comptage et recherche de bits dans un mot : instructions dédiées avec GCC et
+// Clang, versions portables sinon
+#if defined(__GNUC__)
+/// Nombre de bits à 1 du mot.
+static inline int compterBits(uint64_t mot) {
+    return __builtin_popcountll(mot);
+}
+
+/// Position du bit à 1 de poids le plus faible (mot non nul).
+static inline int premierBit(uint64_t mot) {
+    return __builtin_ctzll(mot);
+}
+
+/// Position du bit à 1 de poids le plus fort (mot non nul).
+static inline int dernierBit(uint64_t mot) {
+    return 63 - __builtin_clzll(mot);
+}
+#else
+/// Nombre de bits à 1 du mot.
+static inline int compterBits(uint64_t mot) {
+    mot = mot - ((mot >> 1) & 0x5555555555555555ULL);
+    mot = (mot & 0x3333333333333333ULL) + ((mot >> 2) & 0x3333333333333333ULL);
+    mot = (mot + (mot >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((mot * 0x0101010101010101ULL) >> 56);
+}
+
+/// Position du bit à 1 de poids le plus faible (mot non nul).
+static inline int premierBit(uint64_t mot) {
+    return compterBits((mot & (~mot + 1)) - 1);
+}
+
+/// Position du bit à 1 de poids le plus fort (mot non nul).
+static inline int dernierBit(uint64_t mot) {
+    int position = 0;
+    for (int pas = 32; pas > 0; pas >>= 1) {
+        if (mot >> pas) {
+            mot >>= pas;
+            position += pas;
+        }
+    }
+    return position;
+}
+#endif
+
 /**
  * @brief Constructeur du bitmap.
  * 
  * Initialise un bitmap avec une largeur et une hauteur spécifiées.
- * Tous les pixels sont initialisés à blanc par défaut.
+ * Tous les pixels sont initialisés à blanc par défaut. Les lignes sont
+ * rangées dans un seul tampon, chacune arrondie à un multiple de 64 bits.
  * 
  * @param width Largeur du bitmap en pixels.
  * @param height Hauteur du bitmap en pixels.
+ * @param format Format de stockage des pixels.
+ * @param ressource Ressource fournissant le tampon de pixels.
  * 
  * @throws std::invalid_argument Si la largeur ou la hauteur est <= 0.
  */
-Bitmap::Bitmap(int width, int height) : width(width), height(height) {
+Bitmap::Bitmap(int width, int height, PixelFormat format, std::pmr::memory_resource* ressource)
+    : width(width), height(height), format(format), storage(ressource) {
     if (width <= 0 || height <= 0) {
         throw std::invalid_argument("La largeur et la hauteur doivent être positives.");
     }
-    // Initialiser la grille de pixels avec des pixels blancs (valeur 0)
-    pixels = std::vector<std::vector<int>>(height, std::vector<int>(width, 0));
+    const int bitsParPixel = (format == PixelFormat::Bit1) ? 1 : 8;
+    const size_t motsParLigne = (static_cast<size_t>(width) * bitsParPixel + 63) / 64;
+    stride = static_cast<int>(motsParLigne * sizeof(uint64_t));
+
+    // Initialiser le tampon avec des pixels blancs (valeur 0)
+    storage.assign(motsParLigne * height, 0);
 }
 
 /**
@@ -36,7 +98,7 @@ Bitmap::Bitmap(int width, int height) : width(width), height(height) {
  */
 void Bitmap::setPixel(int x, int y, int color) {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        pixels[y][x] = color; // Modifier la couleur du pixel
+        setPixelRaw(row(y), x, color); // Modifier la couleur du pixel
     }
 }
 
@@ -54,11 +116,346 @@ void Bitmap::setPixel(int x, int y, int color) {
  */
 int Bitmap::getPixel(int x, int y) const {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        return pixels[y][x];
+        return getPixelRaw(row(y), x);
     }
     return 0; // Blanc par défaut
 }
 
+/**
+ * @brief Trace un segment de droite par pas entiers.
+ * 
+ * Le segment est paramétré par son axe principal (celui de plus grande
+ * étendue) : le pixel k a pour coordonnée secondaire m(k) = arrondi(k * db / da).
+ * Comme m est monotone, l'ensemble des k visibles est un intervalle que l'on
+ * calcule directement ; la boucle n'écrit ensuite que des pixels valides.
+ * 
+ * @param x0 Coordonnée X du pixel de départ.
+ * @param y0 Coordonnée Y du pixel de départ.
+ * @param x1 Coordonnée X du pixel d'arrivée.
+ * @param y1 Coordonnée Y du pixel d'arrivée.
+ * @param color Couleur à attribuer aux pixels.
+ * @param inclureFin Si faux, le pixel d'arrivée n'est pas écrit.
+ */
+void Bitmap::drawLine(int x0, int y0, int x1, int y1, int color, bool inclureFin) {
+    const bool xMajeur = std::abs(x1 - x0) >= std::abs(y1 - y0);
+
+    // Axe principal (a) et axe secondaire (b)
+    const long long a0 = xMajeur ? x0 : y0;
+    const long long b0 = xMajeur ? y0 : x0;
+    const long long da = xMajeur ? std::abs(x1 - x0) : std::abs(y1 - y0);
+    const long long db = xMajeur ? std::abs(y1 - y0) : std::abs(x1 - x0);
+    const int sa = (xMajeur ? x1 >= x0 : y1 >= y0) ? 1 : -1;
+    const int sb = (xMajeur ? y1 >= y0 : x1 >= x0) ? 1 : -1;
+    const long long limA = xMajeur ? width : height;
+    const long long limB = xMajeur ? height : width;
+
+    long long kDebut = 0;
+    long long kFin = inclureFin ? da : da - 1;
+
+    // Découpage sur l'axe principal : 0 <= a0 + sa * k < limA
+    if (sa > 0) {
+        kDebut = std::max(kDebut, -a0);
+        kFin = std::min(kFin, limA - 1 - a0);
+    } else {
+        kDebut = std::max(kDebut, a0 - (limA - 1));
+        kFin = std::min(kFin, a0);
+    }
+
+    // Découpage sur l'axe secondaire : 0 <= b0 + sb * m(k) < limB, avec m(k) >= 0 croissant
+    const long long mMin = sb > 0 ? -b0 : b0 - (limB - 1);
+    const long long mMax = sb > 0 ? limB - 1 - b0 : b0;
+    if (mMax < 0) {
+        return;
+    }
+    if (mMin > 0) {
+        if (db == 0) {
+            return;
+        }
+        // m(k) >= mMin  <=>  2 k db >= da (2 mMin - 1)
+        const long long num = da * (2 * mMin - 1);
+        kDebut = std::max(kDebut, (num + 2 * db - 1) / (2 * db));
+    }
+    if (db > 0) {
+        // m(k) <= mMax  <=>  2 k db < da (2 mMax + 1)
+        const long long num = da * (2 * mMax + 1);
+        kFin = std::min(kFin, (num + 2 * db - 1) / (2 * db) - 1);
+    }
+    if (kDebut > kFin) {
+        return;
+    }
+    TRACE_PIXELS(kFin - kDebut + 1);
+
+    // Parcours incrémental à partir du premier pixel visible
+    const long long deuxDa = 2 * std::max(da, 1LL);
+    long long numerateur = 2 * kDebut * db + da;
+    long long m = numerateur / deuxDa;
+    long long erreur = numerateur % deuxDa;
+    for (long long k = kDebut; k <= kFin; ++k) {
+        const long long a = a0 + sa * k;
+        const long long b = b0 + sb * m;
+        if (xMajeur) {
+            setPixelRaw(row(static_cast<int>(b)), static_cast<int>(a), color);
+        } else {
+            setPixelRaw(row(static_cast<int>(a)), static_cast<int>(b), color);
+        }
+        erreur += 2 * db;
+        if (erreur >= deuxDa) {
+            erreur -= deuxDa;
+            ++m;
+        }
+    }
+}
+
+/**
+ * @brief Pose ou efface les bits d'un masque dans un mot de pixels 1 bit.
+ * 
+ * @param mot Le mot modifié.
+ * @param masque Les bits concernés.
+ * @param color Couleur : non nulle pour encrer, nulle pour effacer.
+ */
+static void appliquerMasqueMot(uint64_t& mot, uint64_t masque, int color) {
+    if (color) {
+        mot |= masque;
+    } else {
+        mot &= ~masque;
+    }
+}
+
+/**
+ * @brief Remplit une portion horizontale de ligne.
+ * 
+ * En 1 bit, les mots de bord sont modifiés par masque et les mots entiers du
+ * milieu écrits d'un bloc : 64 pixels par opération.
+ * 
+ * @param y Indice de la ligne.
+ * @param x0 Premier pixel de la portion (inclus).
+ * @param x1 Dernier pixel de la portion (inclus).
+ * @param color Couleur à attribuer aux pixels.
+ */
+void Bitmap::fillSpan(int y, int x0, int x1, int color) {
+    if (y < 0 || y >= height) {
+        return;
+    }
+    x0 = std::max(x0, 0);
+    x1 = std::min(x1, width - 1);
+    if (x0 > x1) {
+        return;
+    }
+    TRACE_PIXELS(x1 - x0 + 1);
+
+    uint8_t* ligne = row(y);
+    if (format != PixelFormat::Bit1) {
+        const int valeur = (format == PixelFormat::Coverage8) ? (color ? 255 : 0) : (color & 0xFF);
+        std::memset(ligne + x0, valeur, static_cast<size_t>(x1 - x0 + 1));
+        return;
+    }
+
+    uint64_t* mots = rowWords(y);
+    const int premier = x0 >> 6;
+    const int dernier = x1 >> 6;
+    const uint64_t masqueDebut = ~0ULL << (x0 & 63);
+    const uint64_t masqueFin = ~0ULL >> (63 - (x1 & 63));
+    if (premier == dernier) {
+        appliquerMasqueMot(mots[premier], masqueDebut & masqueFin, color);
+        return;
+    }
+    appliquerMasqueMot(mots[premier], masqueDebut, color);
+    std::fill(mots + premier + 1, mots + dernier, color ? ~0ULL : 0ULL);
+    appliquerMasqueMot(mots[dernier], masqueFin, color);
+}
+
+/**
+ * @brief Superpose l'encre d'un bitmap 1 bit, par OU logique.
+ * 
+ * @param source Bitmap Bit1 à superposer.
+ * @param dx Décalage horizontal de la source.
+ * @param dy Décalage vertical de la source.
+ * 
+ * @throws std::invalid_argument Si l'un des deux bitmaps n'est pas au format Bit1.
+ */
+void Bitmap::orBitmap(const Bitmap& source, int dx, int dy) {
+    TRACE_PORTEE("Bitmap::orBitmap");
+    if (format != PixelFormat::Bit1 || source.format != PixelFormat::Bit1) {
+        throw std::invalid_argument("La superposition par mots demande deux bitmaps au format Bit1.");
+    }
+    const int yDebut = std::max(0, dy);
+    const int yFin = std::min(height, dy + source.height);
+    const int motDebut = std::max(0, dx >> 6);
+    const int motFin = std::min(getWordsPerRow() - 1, (dx + source.width - 1) >> 6);
+    if (yDebut >= yFin || dx + source.width <= 0 || motDebut > motFin) {
+        return;
+    }
+    TRACE_PIXELS(static_cast<uint64_t>(yFin - yDebut) * (std::min(width, dx + source.width) - std::max(0, dx)));
+    const int nbMotsSource = source.getWordsPerRow();
+    const uint64_t masqueLargeur = ~0ULL >> (63 - ((width - 1) & 63)); // Pixels valides du dernier mot
+    for (int y = yDebut; y < yFin; ++y) {
+        uint64_t* mots = rowWords(y);
+        const uint64_t* motsSource = source.rowWords(y - dy);
+        for (int j = motDebut; j <= motFin; ++j) {
+            mots[j] |= readBits(motsSource, nbMotsSource, 64LL * j - dx);
+        }
+        mots[getWordsPerRow() - 1] &= masqueLargeur;
+    }
+}
+
+/**
+ * @brief Compte les pixels encrés (non blancs) d'un rectangle.
+ * 
+ * @param x0 Première colonne.
+ * @param y0 Première ligne.
+ * @param x1 Dernière colonne.
+ * @param y1 Dernière ligne.
+ * @return size_t Le nombre de pixels non nuls.
+ */
+size_t Bitmap::countInk(int x0, int y0, int x1, int y1) const {
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, width - 1);
+    y1 = std::min(y1, height - 1);
+    size_t total = 0;
+    if (x0 > x1) {
+        return total;
+    }
+    for (int y = y0; y <= y1; ++y) {
+        if (format != PixelFormat::Bit1) {
+            const uint8_t* ligne = row(y);
+            total += static_cast<size_t>(x1 - x0 + 1) - static_cast<size_t>(std::count(ligne + x0, ligne + x1 + 1, 0));
+            continue;
+        }
+        const uint64_t* mots = rowWords(y);
+        const int premier = x0 >> 6;
+        const int dernier = x1 >> 6;
+        const uint64_t masqueDebut = ~0ULL << (x0 & 63);
+        const uint64_t masqueFin = ~0ULL >> (63 - (x1 & 63));
+        if (premier == dernier) {
+            total += compterBits(mots[premier] & masqueDebut & masqueFin);
+            continue;
+        }
+        total += compterBits(mots[premier] & masqueDebut);
+        for (int j = premier + 1; j < dernier; ++j) {
+            total += compterBits(mots[j]);
+        }
+        total += compterBits(mots[dernier] & masqueFin);
+    }
+    return total;
+}
+
+/**
+ * @brief Compte les pixels encrés (non blancs) du bitmap.
+ * 
+ * @return size_t Le nombre de pixels non nuls.
+ */
+size_t Bitmap::countInk() const {
+    return countInk(0, 0, width - 1, height - 1);
+}
+
+/**
+ * @brief Boîte englobante des pixels encrés (non blancs).
+ * 
+ * @param x0 Reçoit la première colonne encrée.
+ * @param y0 Reçoit la première ligne encrée.
+ * @param x1 Reçoit la dernière colonne encrée.
+ * @param y1 Reçoit la dernière ligne encrée.
+ * @return bool Faux si aucun pixel n'est encré.
+ */
+bool Bitmap::getInkBounds(int& x0, int& y0, int& x1, int& y1) const {
+    x0 = width;
+    y0 = height;
+    x1 = -1;
+    y1 = -1;
+    for (int y = 0; y < height; ++y) {
+        int premier;
+        int dernier;
+        if (format == PixelFormat::Bit1) {
+            // Les bits au-delà de la largeur sont nuls : un mot non nul contient de l'encre
+            const uint64_t* mots = rowWords(y);
+            const int nbMots = getWordsPerRow();
+            int j = 0;
+            while (j < nbMots && mots[j] == 0) {
+                ++j;
+            }
+            if (j == nbMots) {
+                continue;
+            }
+            premier = j * 64 + premierBit(mots[j]);
+            j = nbMots - 1;
+            while (mots[j] == 0) {
+                --j;
+            }
+            dernier = j * 64 + dernierBit(mots[j]);
+        } else {
+            const uint8_t* ligne = row(y);
+            premier = 0;
+            while (premier < width && ligne[premier] == 0) {
+                ++premier;
+            }
+            if (premier == width) {
+                continue;
+            }
+            dernier = width - 1;
+            while (ligne[dernier] == 0) {
+                --dernier;
+            }
+        }
+        x0 = std::min(x0, premier);
+        x1 = std::max(x1, dernier);
+        y0 = std::min(y0, y);
+        y1 = y;
+    }
+    return x1 >= 0;
+}
+
+/**
+ * @brief Ramène une coordonnée flottante au pixel qui la contient.
+ * 
+ * La valeur est bornée pour que la conversion en entier reste définie.
+ * 
+ * @param v Coordonnée en pixels.
+ * @return int Indice du pixel.
+ */
+static int versPixel(float v) {
+    const float borne = 1 << 24;
+    return static_cast<int>(std::floor(std::max(-borne, std::min(borne, v))));
+}
+
+/**
+ * @brief Trace une ligne brisée sans réécrire les sommets partagés.
+ * 
+ * Chaque segment est tracé sans son pixel d'arrivée, qui sera le premier du
+ * segment suivant ; seul le dernier sommet est écrit à part, sauf s'il
+ * referme la ligne sur son premier pixel.
+ * 
+ * @param points Tableau des sommets.
+ * @param nbPoints Nombre de sommets.
+ * @param color Couleur à attribuer aux pixels.
+ */
+void Bitmap::drawPolyline(const Point* points, size_t nbPoints, int color) {
+    if (nbPoints == 0) {
+        return;
+    }
+
+    const int premierX = versPixel(points[0].getX());
+    const int premierY = versPixel(points[0].getY());
+    int x = premierX, y = premierY;
+    bool traces = false;
+
+    for (size_t i = 1; i < nbPoints; ++i) {
+        const int nx = versPixel(points[i].getX());
+        const int ny = versPixel(points[i].getY());
+        if (nx == x && ny == y) {
+            continue;
+        }
+        drawLine(x, y, nx, ny, color, false);
+        x = nx;
+        y = ny;
+        traces = true;
+    }
+
+    if (!(traces && x == premierX && y == premierY)) {
+        setPixel(x, y, color);
+    }
+}
+
 /**
  * @brief Sauvegarde le bitmap dans un fichier au format PBM.
  * 
@@ -71,6 +468,7 @@ int Bitmap::getPixel(int x, int y) const {
  * @throws std::ios_base::failure Si le fichier ne peut pas être créé ou ouvert.
  */
 void Bitmap::saveToFile(const std::string& filename) const {
+    TRACE_PORTEE("Bitmap::saveToFile");
     std::ofstream file(filename);
     if (!file.is_open()) {
         throw std::ios_base::failure("Impossible de créer le fichier : " + filename);
@@ -80,9 +478,10 @@ void Bitmap::saveToFile(const std::string& filename) const {
     file << "P1\n" << width << " " << height << "\n";
 
     // Écrire les pixels ligne par ligne
-    for (const auto& row : pixels) {
-        for (int pixel : row) {
-            file << (pixel ? "1 " : "0 ");
+    for (int y = 0; y < height; ++y) {
+        const uint8_t* ligne = row(y);
+        for (int x = 0; x < width; ++x) {
+            file << (getPixelRaw(ligne, x) ? "1 " : "0 ");
         }
         file << "\n";
     }
@@ -91,31 +490,68 @@ void Bitmap::saveToFile(const std::string& filename) const {
 }
 
 /**
- * @brief Dessine le bitmap dans une fenêtre SDL.
+ * @brief Palette ARGB8888 d'un format de pixels.
  * 
- * Affiche le contenu du bitmap dans une fenêtre SDL en utilisant un renderer.
- * Chaque pixel est dessiné avec la couleur appropriée :
- * - Blanc (0) : RGB(255, 255, 255)
- * - Noir (1) : RGB(0, 0, 0)
- * - Rouge (2) : RGB(255, 0, 0)
+ * @param format Format des pixels.
+ * @return Un tableau de 256 couleurs, indexé par la valeur brute du pixel.
+ */
+static const uint32_t* paletteARGB(PixelFormat format) {
+    struct Palettes {
+        uint32_t indices[256];
+        uint32_t couvertures[256];
+        Palettes() {
+            for (int i = 0; i < 256; ++i) {
+                indices[i] = 0xFFFFFFFFu; // Blanc
+                const uint32_t gris = static_cast<uint32_t>(255 - i);
+                couvertures[i] = 0xFF000000u | (gris << 16) | (gris << 8) | gris;
+            }
+            indices[1] = 0xFF000000u; // Noir
+            indices[2] = 0xFFFF0000u; // Rouge
+        }
+    };
+    static const Palettes palettes;
+    return format == PixelFormat::Coverage8 ? palettes.couvertures : palettes.indices;
+}
+
+/**
+ * @brief Convertit une ligne de pixels en couleurs ARGB8888.
  * 
- * @param renderer Le renderer SDL utilisé pour dessiner les pixels.
+ * @param y Indice de la ligne.
+ * @param sortie Tampon de destination de getWidth() couleurs.
  */
-void Bitmap::renderToSDL(SDL_Renderer* renderer) const {
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            if (pixels[y][x] == 1) { // Noir
-                SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
-            } else if (pixels[y][x] == 2) { // Rouge
-                SDL_SetRenderDrawColor(renderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
-            } else { // Blanc
-                SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);
+void Bitmap::rowToARGB(int y, uint32_t* sortie) const {
+    const uint32_t* palette = paletteARGB(format);
+    const uint8_t* ligne = row(y);
+    if (format == PixelFormat::Bit1) {
+        const int octetsPleins = width >> 3;
+        for (int i = 0; i < octetsPleins; ++i, sortie += 8) {
+            const unsigned octet = ligne[i];
+            for (int b = 0; b < 8; ++b) {
+                sortie[b] = palette[(octet >> b) & 1u];
             }
-            SDL_RenderDrawPoint(renderer, x, y);
+        }
+        for (int x = octetsPleins << 3; x < width; ++x) {
+            *sortie++ = palette[getPixelRaw(ligne, x)];
+        }
+    } else {
+        for (int x = 0; x < width; ++x) {
+            sortie[x] = palette[ligne[x]];
         }
     }
 }
 
+/**
+ * @brief Convertit les pixels en couleurs ARGB8888.
+ * 
+ * @param pixels Tampon de destination.
+ * @param pitch Distance en octets entre deux lignes de la destination.
+ */
+void Bitmap::toARGB(void* pixels, int pitch) const {
+    for (int y = 0; y < height; ++y) {
+        rowToARGB(y, reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(pixels) + static_cast<ptrdiff_t>(y) * pitch));
+    }
+}
+
 /**
  * @brief Retourne la largeur du bitmap.
  * 
@@ -133,3 +569,39 @@ int Bitmap::getWidth() const {
 int Bitmap::getHeight() const {
     return height;
 }
+
+/**
+ * @brief Retourne le format de stockage des pixels.
+ * 
+ * @return PixelFormat Le format du bitmap.
+ */
+PixelFormat Bitmap::getFormat() const {
+    return format;
+}
+
+/**
+ * @brief Retourne le pas d'une ligne en octets.
+ * 
+ * @return int Nombre d'octets entre deux lignes consécutives.
+ */
+int Bitmap::getStride() const {
+    return stride;
+}
+
+/**
+ * @brief Retourne la taille mémoire du tampon de pixels.
+ * 
+ * @return size_t Nombre d'octets occupés par les pixels.
+ */
+size_t Bitmap::getSizeInBytes() const {
+    return storage.size() * sizeof(uint64_t);
+}
+
+/**
+ * @brief Remet tous les pixels à blanc.
+ * 
+ * Le tampon étant contigu, un seul remplissage suffit.
+ */
+void Bitmap::clear() {
+    std::fill(storage.begin(), storage.end(), 0);
+}
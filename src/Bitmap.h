@@ -1,17 +1,31 @@
 #ifndef BITMAP_H
 #define BITMAP_H
 
+#include <memory_resource>
 #include <vector>
 #include <string>
-#include <SDL2/SDL.h>
+#include <cstdint>
+#include <cstddef>
+#include "Point.h"
+
+/**
+ * @brief Format de stockage des pixels d'un bitmap.
+ */
+enum class PixelFormat {
+    Bit1,      ///< 1 bit par pixel : 0 = blanc, 1 = noir (bit x & 7 de l'octet x >> 3, poids faible d'abord).
+    Index8,    ///< 1 octet par pixel : indice de couleur (0 = blanc, 1 = noir, 2 = rouge).
+    Coverage8  ///< 1 octet par pixel : couverture de l'encre noire, de 0 (blanc) à 255 (noir).
+};
 
 /**
  * @brief Classe représentant une grille de pixels (bitmap).
  * 
  * Permet de dessiner des points, de sauvegarder le bitmap dans un fichier au format PBM,
- * et de l'afficher dans une fenêtre SDL.
- * Les pixels sont représentés avec un entier, où des valeurs spécifiques peuvent
- * correspondre à différentes couleurs (par exemple, noir, blanc, rouge, etc.).
+ * et de convertir ses pixels en couleurs pour un affichage (voir toARGB()).
+ * Le bitmap ne dépend d'aucune bibliothèque d'affichage.
+ * Les pixels sont stockés dans un unique tampon contigu, ligne par ligne, dans
+ * le format choisi à la construction. Chaque ligne occupe getStride() octets,
+ * un multiple de 8, ce qui aligne le début de chaque ligne sur 64 bits.
  */
 class Bitmap {
 public:
@@ -23,8 +37,13 @@ public:
      * 
      * @param width Largeur du bitmap (en pixels).
      * @param height Hauteur du bitmap (en pixels).
+     * @param format Format de stockage des pixels (par défaut : indice de couleur sur 8 bits).
+     * @param ressource Ressource fournissant le tampon de pixels (une arène de
+     * rendu pour un bitmap de travail ; une copie du bitmap utilise toujours la
+     * ressource par défaut).
      */
-    Bitmap(int width, int height);
+    Bitmap(int width, int height, PixelFormat format = PixelFormat::Index8,
+           std::pmr::memory_resource* ressource = std::pmr::get_default_resource());
 
     /**
      * @brief Définit la couleur d'un pixel dans le bitmap.
@@ -34,6 +53,7 @@ public:
      * @param x Coordonnée X du pixel.
      * @param y Coordonnée Y du pixel.
      * @param color Couleur à attribuer au pixel (par exemple, 0 = blanc, 1 = noir, 2 = rouge).
+     * En Bit1 et Coverage8, toute couleur non nulle est de l'encre pleine.
      */
     void setPixel(int x, int y, int color);
 
@@ -44,30 +64,258 @@ public:
      * 
      * @param x Coordonnée X du pixel.
      * @param y Coordonnée Y du pixel.
-     * @return int Couleur du pixel (par exemple, 0 = blanc, 1 = noir, 2 = rouge).
+     * @return int Couleur du pixel (par exemple, 0 = blanc, 1 = noir, 2 = rouge),
+     * ou couverture de 0 à 255 en Coverage8.
      */
     int getPixel(int x, int y) const;
 
+    /**
+     * @brief Lit un pixel dans une ligne brute, sans vérification de bornes.
+     * 
+     * @param ligne Pointeur obtenu par row().
+     * @param x Coordonnée X du pixel (0 <= x < largeur).
+     * @return int Valeur du pixel, comme getPixel().
+     */
+    int getPixelRaw(const uint8_t* ligne, int x) const {
+        if (format == PixelFormat::Bit1) {
+            return (ligne[x >> 3] >> (x & 7)) & 1;
+        }
+        return ligne[x];
+    }
+
+    /**
+     * @brief Écrit un pixel dans une ligne brute, sans vérification de bornes.
+     * 
+     * @param ligne Pointeur obtenu par row().
+     * @param x Coordonnée X du pixel (0 <= x < largeur).
+     * @param color Couleur, interprétée comme par setPixel().
+     */
+    void setPixelRaw(uint8_t* ligne, int x, int color) {
+        switch (format) {
+        case PixelFormat::Bit1:
+            if (color) {
+                ligne[x >> 3] |= static_cast<uint8_t>(1u << (x & 7));
+            } else {
+                ligne[x >> 3] &= static_cast<uint8_t>(~(1u << (x & 7)));
+            }
+            break;
+        case PixelFormat::Index8:
+            ligne[x] = static_cast<uint8_t>(color);
+            break;
+        case PixelFormat::Coverage8:
+            ligne[x] = color ? 255 : 0;
+            break;
+        }
+    }
+
+    /**
+     * @brief Accès direct à une ligne de pixels.
+     * 
+     * Permet aux boucles critiques de parcourir le bitmap sans passer par les
+     * tests de bornes de setPixel()/getPixel().
+     * 
+     * @param y Indice de la ligne (0 <= y < hauteur).
+     * @return uint8_t* Pointeur sur le premier octet de la ligne.
+     */
+    uint8_t* row(int y) {
+        return reinterpret_cast<uint8_t*>(storage.data()) + static_cast<size_t>(y) * stride;
+    }
+
+    /**
+     * @brief Accès direct en lecture à une ligne de pixels.
+     * 
+     * @param y Indice de la ligne (0 <= y < hauteur).
+     * @return const uint8_t* Pointeur sur le premier octet de la ligne.
+     */
+    const uint8_t* row(int y) const {
+        return reinterpret_cast<const uint8_t*>(storage.data()) + static_cast<size_t>(y) * stride;
+    }
+
+    /**
+     * @brief Accès par mots de 64 bits à une ligne de pixels.
+     * 
+     * En Bit1, le pixel x est le bit x & 63 du mot x >> 6 (même disposition
+     * que row() sur une machine petit-boutiste) : une opération sur un mot
+     * traite 64 pixels. Les bits au-delà de la largeur restent toujours nuls.
+     * 
+     * @param y Indice de la ligne (0 <= y < hauteur).
+     * @return uint64_t* Pointeur sur le premier mot de la ligne.
+     */
+    uint64_t* rowWords(int y) {
+        return storage.data() + static_cast<size_t>(y) * (stride / sizeof(uint64_t));
+    }
+
+    /**
+     * @brief Accès en lecture par mots de 64 bits à une ligne de pixels.
+     * 
+     * @param y Indice de la ligne (0 <= y < hauteur).
+     * @return const uint64_t* Pointeur sur le premier mot de la ligne.
+     */
+    const uint64_t* rowWords(int y) const {
+        return storage.data() + static_cast<size_t>(y) * (stride / sizeof(uint64_t));
+    }
+
+    /**
+     * @brief Nombre de mots de 64 bits d'une ligne.
+     * 
+     * @return int getStride() / 8.
+     */
+    int getWordsPerRow() const {
+        return stride / static_cast<int>(sizeof(uint64_t));
+    }
+
+    /**
+     * @brief Lit 64 pixels consécutifs d'une ligne 1 bit, à partir d'une colonne quelconque.
+     * 
+     * @param words Mots de la ligne (voir rowWords()).
+     * @param nbWords Nombre de mots de la ligne.
+     * @param first Colonne du premier pixel lu (éventuellement négative).
+     * @return uint64_t Les pixels first à first + 63, le premier dans le bit 0 ;
+     * ceux hors de la ligne sont nuls.
+     */
+    static uint64_t readBits(const uint64_t* words, int nbWords, long long first) {
+        const long long indice = first >> 6; // Division arrondie vers -infini
+        const int decalage = static_cast<int>(first & 63);
+        const uint64_t bas = (indice >= 0 && indice < nbWords) ? words[indice] : 0;
+        if (decalage == 0) {
+            return bas;
+        }
+        const uint64_t haut = (indice + 1 >= 0 && indice + 1 < nbWords) ? words[indice + 1] : 0;
+        return (bas >> decalage) | (haut << (64 - decalage));
+    }
+
+    /**
+     * @brief Remet tous les pixels à blanc.
+     */
+    void clear();
+
+    /**
+     * @brief Trace un segment de droite entre deux pixels.
+     * 
+     * Parcourt le segment par pas entiers (Bresenham) : chaque pixel couvert
+     * est écrit une seule fois. Le découpage aux bords du bitmap est calculé
+     * une fois pour tout le segment, puis les pixels sont écrits sans test.
+     * 
+     * @param x0 Coordonnée X du pixel de départ.
+     * @param y0 Coordonnée Y du pixel de départ.
+     * @param x1 Coordonnée X du pixel d'arrivée.
+     * @param y1 Coordonnée Y du pixel d'arrivée.
+     * @param color Couleur à attribuer aux pixels.
+     * @param inclureFin Si faux, le pixel d'arrivée n'est pas écrit (utile pour enchaîner des segments).
+     */
+    void drawLine(int x0, int y0, int x1, int y1, int color, bool inclureFin = true);
+
+    /**
+     * @brief Remplit une portion horizontale de ligne.
+     * 
+     * La portion est découpée une seule fois aux bords du bitmap, puis écrite
+     * d'un bloc (memset en 8 bits, mots de 64 pixels masqués en 1 bit).
+     * 
+     * @param y Indice de la ligne.
+     * @param x0 Premier pixel de la portion (inclus).
+     * @param x1 Dernier pixel de la portion (inclus).
+     * @param color Couleur à attribuer aux pixels.
+     */
+    void fillSpan(int y, int x0, int x1, int color);
+
+    /**
+     * @brief Superpose l'encre d'un bitmap 1 bit, par OU logique.
+     * 
+     * Chaque mot de la destination reçoit le OU des 64 pixels correspondants de
+     * la source, décalés de (dx, dy) ; les pixels hors de la destination sont
+     * ignorés.
+     * 
+     * @param source Bitmap Bit1 à superposer.
+     * @param dx Colonne de la destination recevant la colonne 0 de la source.
+     * @param dy Ligne de la destination recevant la ligne 0 de la source.
+     * 
+     * @throws std::invalid_argument Si l'un des deux bitmaps n'est pas au format Bit1.
+     */
+    void orBitmap(const Bitmap& source, int dx, int dy);
+
+    /**
+     * @brief Compte les pixels encrés (non blancs) d'un rectangle.
+     * 
+     * En Bit1, un comptage de bits par mot de 64 pixels. Le rectangle est
+     * découpé aux bords du bitmap.
+     * 
+     * @param x0 Première colonne (incluse).
+     * @param y0 Première ligne (incluse).
+     * @param x1 Dernière colonne (incluse).
+     * @param y1 Dernière ligne (incluse).
+     * @return size_t Le nombre de pixels non nuls.
+     */
+    size_t countInk(int x0, int y0, int x1, int y1) const;
+
+    /**
+     * @brief Compte les pixels encrés (non blancs) du bitmap.
+     * 
+     * @return size_t Le nombre de pixels non nuls.
+     */
+    size_t countInk() const;
+
+    /**
+     * @brief Boîte englobante des pixels encrés (non blancs).
+     * 
+     * Les lignes sont parcourues par mots de 64 pixels en Bit1, octet par
+     * octet sinon ; les lignes vides sont écartées sans examiner leurs pixels.
+     * 
+     * @param x0 Reçoit la première colonne encrée.
+     * @param y0 Reçoit la première ligne encrée.
+     * @param x1 Reçoit la dernière colonne encrée.
+     * @param y1 Reçoit la dernière ligne encrée.
+     * @return bool Faux si aucun pixel n'est encré.
+     */
+    bool getInkBounds(int& x0, int& y0, int& x1, int& y1) const;
+
+    /**
+     * @brief Trace une ligne brisée.
+     * 
+     * Les sommets sont ramenés au pixel qui les contient, puis reliés par
+     * drawLine() ; les sommets partagés entre deux segments ne sont écrits
+     * qu'une fois, y compris lorsque la ligne est fermée.
+     * 
+     * @param points Tableau des sommets.
+     * @param nbPoints Nombre de sommets.
+     * @param color Couleur à attribuer aux pixels.
+     */
+    void drawPolyline(const Point* points, size_t nbPoints, int color);
+
     /**
      * @brief Sauvegarde le bitmap dans un fichier au format PBM.
      * 
      * Crée un fichier texte représentant le bitmap en utilisant la notation
      * PBM (Portable Bitmap). Cette méthode est utile pour visualiser le bitmap
-     * dans un éditeur prenant en charge ce format.
+     * dans un éditeur prenant en charge ce format. Pour des fichiers compacts
+     * et une écriture rapide, voir Netpbm::ecrire() (formats binaires).
      * 
      * @param filename Nom du fichier de sortie.
      */
     void saveToFile(const std::string& filename) const;
 
     /**
-     * @brief Dessine le bitmap dans une fenêtre SDL.
+     * @brief Convertit les pixels en couleurs ARGB8888.
      * 
-     * Affiche le bitmap dans une fenêtre SDL en utilisant un renderer SDL.
-     * Chaque pixel est dessiné avec la couleur appropriée selon sa valeur.
+     * Une passe unique par ligne : chaque indice (ou couverture) est traduit
+     * par une palette de 256 entrées propre au format ; en Bit1, chaque octet
+     * donne huit pixels. Blanc, noir et rouge pour les indices 0, 1 et 2,
+     * niveau de gris pour la couverture.
      * 
-     * @param renderer Le renderer SDL utilisé pour dessiner les pixels.
+     * @param pixels Tampon de destination d'au moins getHeight() lignes.
+     * @param pitch Distance en octets entre deux lignes de la destination.
      */
-    void renderToSDL(SDL_Renderer* renderer) const;
+    void toARGB(void* pixels, int pitch) const;
+
+    /**
+     * @brief Convertit une ligne de pixels en couleurs ARGB8888.
+     * 
+     * Même conversion que toARGB(), pour une seule ligne : permet d'encoder
+     * une image ligne par ligne sans tampon de la taille de l'image.
+     * 
+     * @param y Indice de la ligne (0 <= y < getHeight()).
+     * @param sortie Tampon de destination de getWidth() couleurs.
+     */
+    void rowToARGB(int y, uint32_t* sortie) const;
 
     /**
      * @brief Getter pour la largeur du bitmap.
@@ -83,10 +331,33 @@ public:
      */
     int getHeight() const;
 
+    /**
+     * @brief Getter pour le format de stockage.
+     * 
+     * @return PixelFormat Format des pixels.
+     */
+    PixelFormat getFormat() const;
+
+    /**
+     * @brief Nombre d'octets séparant le début de deux lignes consécutives.
+     * 
+     * @return int Pas d'une ligne en octets (multiple de 8).
+     */
+    int getStride() const;
+
+    /**
+     * @brief Taille mémoire occupée par les pixels.
+     * 
+     * @return size_t Nombre d'octets du tampon de pixels.
+     */
+    size_t getSizeInBytes() const;
+
 private:
-    int width;   ///< Largeur du bitmap
-    int height;  ///< Hauteur du bitmap
-    std::vector<std::vector<int>> pixels;  ///< Grille 2D représentant les couleurs des pixels
+    int width;           ///< Largeur du bitmap
+    int height;          ///< Hauteur du bitmap
+    PixelFormat format;  ///< Format de stockage des pixels
+    int stride;          ///< Pas d'une ligne en octets
+    std::pmr::vector<uint64_t> storage;  ///< Tampon contigu des lignes (mots de 64 bits pour l'alignement)
 };
 
 #endif
@@ -0,0 +1,338 @@
+#include "CacheConcurrent.h"
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+/**
+ * @brief Entrée d'une table : un rendu construit ou en construction.
+ */
+struct CacheConcurrent::Entree : Recuperable {
+    /**
+     * @brief Constructeur d'une entrée en construction.
+     * 
+     * @param cle La clé du rendu.
+     * @param pret Résultat de la construction, attendu par les demandes regroupées.
+     */
+    Entree(const CleGlyphe& cle, std::shared_future<void> pret)
+        : cle(cle), pret(std::move(pret)), glyphe{Bitmap(1, 1, PixelFormat::Bit1), false, 0, 0, 0, 0} {}
+
+    CleGlyphe cle;                      ///< Clé du rendu.
+    std::shared_future<void> pret;      ///< Prêt quand glyphe est construit (ou porte l'erreur de construction).
+    GlypheCache glyphe;                 ///< Le rendu, immuable une fois construit.
+    size_t octets = 0;                  ///< Mémoire comptée pour le rendu.
+    std::atomic<bool> construit{false}; ///< Vrai quand le rendu peut être lu et évincé.
+    std::atomic<bool> reference{true};  ///< Lu depuis le dernier passage de l'éviction.
+};
+
+/**
+ * @brief Lecture protégée : réserve un emplacement de lecteur et y annonce l'époque courante.
+ * 
+ * Tant que la lecture dure, aucun objet retiré à une époque postérieure ou
+ * égale à celle annoncée n'est libéré.
+ */
+class CacheConcurrent::Lecture {
+public:
+    /**
+     * @brief Constructeur : réserve un emplacement libre.
+     * 
+     * @param cache Le cache lu.
+     */
+    explicit Lecture(CacheConcurrent& cache) {
+        // Chaque thread recommence par son dernier emplacement : en régime établi, la
+        // première tentative réussit et les threads n'écrivent pas sur les mêmes lignes
+        thread_local size_t dernier = 0;
+        for (size_t i = dernier;; i = (i + 1) % NB_LECTEURS_MAX) {
+            Lecteur& candidat = cache.lecteurs[i];
+            uint64_t libre = 0;
+            if (candidat.epoque.load(std::memory_order_relaxed) == 0
+                && candidat.epoque.compare_exchange_strong(libre, cache.epoque.load())) {
+                lecteur = &candidat;
+                dernier = i;
+                return;
+            }
+            if ((i + 1) % NB_LECTEURS_MAX == dernier) {
+                std::this_thread::yield(); // Tous les emplacements sont pris
+            }
+        }
+    }
+
+    /**
+     * @brief Destructeur : libère l'emplacement.
+     */
+    ~Lecture() {
+        lecteur->epoque.store(0, std::memory_order_release);
+    }
+
+    Lecture(const Lecture&) = delete;
+    Lecture& operator=(const Lecture&) = delete;
+
+    /**
+     * @brief Emplacement réservé.
+     * 
+     * @return Lecteur& L'emplacement, dont les compteurs appartiennent à cette lecture.
+     */
+    Lecteur& getLecteur() {
+        return *lecteur;
+    }
+
+private:
+    Lecteur* lecteur;  ///< Emplacement réservé.
+};
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param budget Mémoire maximale, en octets.
+ * @param nbFragments Nombre de fragments.
+ */
+CacheConcurrent::CacheConcurrent(size_t budget, size_t nbFragments)
+    : budget(budget), lecteurs(new Lecteur[NB_LECTEURS_MAX]) {
+    size_t nombre = 1;
+    while (nombre < nbFragments) {
+        nombre *= 2;
+    }
+    fragments.reset(new Fragment[nombre]);
+    masqueFragments = nombre - 1;
+    for (size_t i = 0; i < nombre; ++i) {
+        fragments[i].table.store(new Table);
+    }
+}
+
+/**
+ * @brief Destructeur : libère les tables publiées et leurs rendus.
+ */
+CacheConcurrent::~CacheConcurrent() {
+    for (size_t i = 0; i <= masqueFragments; ++i) {
+        Table* table = fragments[i].table.load();
+        for (const auto& element : table->entrees) {
+            delete element.second;
+        }
+        delete table;
+    }
+}
+
+/**
+ * @brief Fragment d'une clé.
+ * 
+ * @param cle La clé.
+ * @return Fragment& Le fragment.
+ */
+CacheConcurrent::Fragment& CacheConcurrent::fragmentDe(const CleGlyphe& cle) {
+    // Mélange de Fibonacci : la lettre seule occupe les bits de poids faible du hachage
+    const uint64_t melange = static_cast<uint64_t>(HachageCleGlyphe()(cle)) * 0x9E3779B97F4A7C15ull;
+    return fragments[(melange >> 32) & masqueFragments];
+}
+
+/**
+ * @brief Dessine une lettre dans un bitmap.
+ * 
+ * @param rendu Moteur de rendu du thread appelant.
+ * @param lettre La lettre.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @param bitmap Bitmap de destination.
+ */
+void CacheConcurrent::dessiner(Rendu& rendu, char lettre, StyleRendu style, int taille, Bitmap& bitmap) {
+    if (bitmap.getFormat() != Rendu::formatPour(style)) {
+        throw std::invalid_argument("Le format du bitmap ne convient pas au style de rendu.");
+    }
+    const CleGlyphe cle{lettre, style, taille};
+    Fragment& fragment = fragmentDe(cle);
+
+    for (;;) {
+        // Lecture sans verrou
+        {
+            Lecture lecture(*this);
+            const Table* table = fragment.table.load();
+            const auto trouve = table->entrees.find(cle);
+            if (trouve != table->entrees.end()) {
+                Entree& entree = *trouve->second;
+                if (entree.construit.load(std::memory_order_acquire)) {
+                    lecture.getLecteur().succes.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    entree.pret.get(); // En construction par un autre thread (relance son erreur)
+                    lecture.getLecteur().regroupes.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (!entree.reference.load(std::memory_order_relaxed)) {
+                    entree.reference.store(true, std::memory_order_relaxed);
+                }
+                CacheGlyphes::copier(entree.glyphe, bitmap);
+                return;
+            }
+        }
+
+        // Absent : insérer une entrée en construction, sauf si un autre thread vient de le faire
+        std::promise<void> promesse;
+        Entree* entree = nullptr;
+        std::vector<std::unique_ptr<Recuperable>> aRetirer;
+        {
+            std::lock_guard<std::mutex> verrou(fragment.mutex);
+            const Table* table = fragment.table.load(std::memory_order_relaxed);
+            if (table->entrees.count(cle) != 0) {
+                continue;
+            }
+            std::unique_ptr<Table> nouvelle(new Table(*table));
+            entree = new Entree(cle, promesse.get_future().share());
+            nouvelle->entrees.emplace(cle, entree);
+            aRetirer.push_back(publier(fragment, std::move(nouvelle)));
+        }
+        retirer(std::move(aRetirer));
+
+        // Construire hors verrou ; l'entrée ne peut pas être évincée avant d'être marquée construite
+        try {
+            entree->glyphe = CacheGlyphes::construire(rendu, lettre, style, taille);
+        } catch (...) {
+            promesse.set_exception(std::current_exception());
+            abandonner(fragment, entree);
+            throw;
+        }
+        entree->octets = entree->glyphe.image.getSizeInBytes() + sizeof(Entree);
+        CacheGlyphes::copier(entree->glyphe, bitmap);
+        promesse.set_value();
+        echecs.fetch_add(1, std::memory_order_relaxed);
+
+        std::vector<std::unique_ptr<Recuperable>> evinces;
+        {
+            std::lock_guard<std::mutex> verrou(fragment.mutex);
+            fragment.octets += entree->octets;
+            octets.fetch_add(entree->octets, std::memory_order_relaxed);
+            nbEntrees.fetch_add(1, std::memory_order_relaxed);
+            entree->construit.store(true, std::memory_order_release); // Dernier accès à l'entrée
+            evincer(fragment, evinces);
+        }
+        retirer(std::move(evinces));
+        return;
+    }
+}
+
+/**
+ * @brief Publie une nouvelle table.
+ * 
+ * @param fragment Le fragment.
+ * @param table La nouvelle table.
+ * @return std::unique_ptr<Recuperable> L'ancienne table.
+ */
+std::unique_ptr<CacheConcurrent::Recuperable> CacheConcurrent::publier(Fragment& fragment, std::unique_ptr<Table> table) {
+    return std::unique_ptr<Recuperable>(fragment.table.exchange(table.release()));
+}
+
+/**
+ * @brief Évince des rendus construits jusqu'à respecter la part du budget du fragment.
+ * 
+ * @param fragment Le fragment.
+ * @param aRetirer Reçoit les objets retirés.
+ */
+void CacheConcurrent::evincer(Fragment& fragment, std::vector<std::unique_ptr<Recuperable>>& aRetirer) {
+    const size_t part = budget / (masqueFragments + 1);
+    if (fragment.octets <= part) {
+        return;
+    }
+    std::unique_ptr<Table> nouvelle(new Table(*fragment.table.load(std::memory_order_relaxed)));
+    bool modifiee = false;
+    // Seconde chance : un premier passage épargne (et démarque) les rendus lus récemment
+    for (int passage = 0; passage < 2 && fragment.octets > part; ++passage) {
+        for (auto it = nouvelle->entrees.begin(); it != nouvelle->entrees.end() && fragment.octets > part;) {
+            Entree* entree = it->second;
+            if (!entree->construit.load(std::memory_order_relaxed)
+                || entree->reference.exchange(false, std::memory_order_relaxed)) {
+                ++it;
+                continue;
+            }
+            fragment.octets -= entree->octets;
+            octets.fetch_sub(entree->octets, std::memory_order_relaxed);
+            nbEntrees.fetch_sub(1, std::memory_order_relaxed);
+            evictions.fetch_add(1, std::memory_order_relaxed);
+            aRetirer.emplace_back(entree);
+            it = nouvelle->entrees.erase(it);
+            modifiee = true;
+        }
+    }
+    if (modifiee) {
+        aRetirer.push_back(publier(fragment, std::move(nouvelle)));
+    }
+}
+
+/**
+ * @brief Retire une entrée dont la construction a échoué.
+ * 
+ * @param fragment Le fragment.
+ * @param entree L'entrée.
+ */
+void CacheConcurrent::abandonner(Fragment& fragment, Entree* entree) {
+    std::vector<std::unique_ptr<Recuperable>> aRetirer;
+    {
+        std::lock_guard<std::mutex> verrou(fragment.mutex);
+        std::unique_ptr<Table> nouvelle(new Table(*fragment.table.load(std::memory_order_relaxed)));
+        nouvelle->entrees.erase(entree->cle);
+        aRetirer.push_back(publier(fragment, std::move(nouvelle)));
+        aRetirer.emplace_back(entree);
+    }
+    retirer(std::move(aRetirer));
+}
+
+/**
+ * @brief Confie des objets retirés à la récupération par époques, puis libère ce qui peut l'être.
+ * 
+ * Les objets sont marqués de l'époque courante, qui est ensuite avancée :
+ * un lecteur qui annonce une époque plus récente a chargé les tables après
+ * le retrait et ne peut plus les voir.
+ * 
+ * @param objets Objets retirés.
+ */
+void CacheConcurrent::retirer(std::vector<std::unique_ptr<Recuperable>> objets) {
+    std::vector<std::unique_ptr<Recuperable>> liberes;
+    {
+        std::lock_guard<std::mutex> verrou(mutexRecuperation);
+        const uint64_t courante = epoque.fetch_add(1);
+        for (std::unique_ptr<Recuperable>& objet : objets) {
+            retires.emplace_back(courante, std::move(objet));
+        }
+
+        uint64_t plusAncienne = std::numeric_limits<uint64_t>::max();
+        for (size_t i = 0; i < NB_LECTEURS_MAX; ++i) {
+            const uint64_t annoncee = lecteurs[i].epoque.load();
+            if (annoncee != 0) {
+                plusAncienne = std::min(plusAncienne, annoncee);
+            }
+        }
+        const auto fin = std::partition(retires.begin(), retires.end(),
+                                        [plusAncienne](const auto& retire) { return retire.first >= plusAncienne; });
+        for (auto it = fin; it != retires.end(); ++it) {
+            liberes.push_back(std::move(it->second));
+        }
+        retires.erase(fin, retires.end());
+    }
+    // Les objets sont détruits ici, hors verrou
+}
+
+/**
+ * @brief Compteurs du cache.
+ * 
+ * @return StatistiquesCacheConcurrent Les compteurs.
+ */
+StatistiquesCacheConcurrent CacheConcurrent::getStatistiques() const {
+    StatistiquesCacheConcurrent statistiques;
+    for (size_t i = 0; i < NB_LECTEURS_MAX; ++i) {
+        statistiques.succes += lecteurs[i].succes.load(std::memory_order_relaxed);
+        statistiques.regroupes += lecteurs[i].regroupes.load(std::memory_order_relaxed);
+    }
+    statistiques.echecs = echecs.load(std::memory_order_relaxed);
+    statistiques.evictions = evictions.load(std::memory_order_relaxed);
+    statistiques.entrees = nbEntrees.load(std::memory_order_relaxed);
+    statistiques.octets = octets.load(std::memory_order_relaxed);
+    std::lock_guard<std::mutex> verrou(mutexRecuperation);
+    statistiques.aRecuperer = retires.size();
+    return statistiques;
+}
+
+/**
+ * @brief Mémoire maximale des rendus en cache.
+ * 
+ * @return size_t Le budget.
+ */
+size_t CacheConcurrent::getBudget() const {
+    return budget;
+}
@@ -0,0 +1,196 @@
+#ifndef CACHE_CONCURRENT_H
+#define CACHE_CONCURRENT_H
+
+#include "Bitmap.h"
+#include "CacheGlyphes.h"
+#include "Rendu.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Compteurs d'un cache concurrent.
+ */
+struct StatistiquesCacheConcurrent {
+    size_t succes = 0;        ///< Rendus trouvés déjà construits.
+    size_t regroupes = 0;     ///< Rendus trouvés en construction par un autre thread, puis attendus.
+    size_t echecs = 0;        ///< Rendus construits (un seul par clé, même sous demandes simultanées).
+    size_t evictions = 0;     ///< Rendus retirés pour respecter le budget.
+    size_t entrees = 0;       ///< Nombre de rendus en cache.
+    size_t octets = 0;        ///< Mémoire occupée par les rendus en cache.
+    size_t aRecuperer = 0;    ///< Tables et rendus retirés, pas encore libérés.
+};
+
+/**
+ * @brief Cache de rendus partagé entre threads, sans verrou pour les lecteurs.
+ * 
+ * Les clés sont réparties sur des fragments indépendants. Chaque fragment
+ * publie une table immuable par un pointeur atomique : une lecture charge ce
+ * pointeur et cherche la clé, sans verrou ni écriture partagée (les compteurs
+ * des lecteurs sont dans leur emplacement d'époque). Une insertion ou une
+ * éviction prend le verrou du seul fragment concerné, copie sa table, la
+ * modifie et publie la copie.
+ * 
+ * Les anciennes tables et les rendus évincés sont libérés par époques : chaque
+ * lecteur annonce l'époque courante le temps de sa lecture, et un objet retiré
+ * à l'époque e n'est libéré que quand tous les lecteurs actifs ont annoncé une
+ * époque postérieure.
+ * 
+ * Des demandes simultanées d'un même rendu absent sont regroupées : la
+ * première insère une entrée en construction et la construit hors verrou, les
+ * autres attendent son résultat (std::shared_future). L'éviction (seconde
+ * chance : un rendu lu depuis le dernier passage est épargné une fois)
+ * ignore les entrées en construction.
+ * 
+ * Les rendus absents sont construits avec le moteur Rendu de l'appelant :
+ * Rendu n'étant pas protégé contre les accès concurrents, chaque thread
+ * fournit le sien.
+ */
+class CacheConcurrent {
+public:
+    /// Nombre maximal de lectures simultanées (au-delà, les lecteurs attendent un emplacement libre).
+    static constexpr size_t NB_LECTEURS_MAX = 64;
+
+    /**
+     * @brief Constructeur.
+     * 
+     * @param budget Mémoire maximale des rendus en cache, en octets, partagée également entre les fragments.
+     * @param nbFragments Nombre de fragments (arrondi à la puissance de 2 supérieure).
+     */
+    explicit CacheConcurrent(size_t budget = 64 * 1024 * 1024, size_t nbFragments = 16);
+
+    /**
+     * @brief Destructeur : libère tous les rendus. Aucune lecture ne doit être en cours.
+     */
+    ~CacheConcurrent();
+
+    CacheConcurrent(const CacheConcurrent&) = delete;
+    CacheConcurrent& operator=(const CacheConcurrent&) = delete;
+
+    /**
+     * @brief Dessine une lettre dans un bitmap, comme Rendu::rendreLettre().
+     * 
+     * Peut être appelée depuis plusieurs threads à la fois.
+     * 
+     * @param rendu Moteur de rendu du thread appelant, utilisé si le rendu est absent.
+     * @param lettre La lettre (majuscule).
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @param bitmap Bitmap de destination, au format Rendu::formatPour(style).
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0, ou si le format ne convient pas au style.
+     */
+    void dessiner(Rendu& rendu, char lettre, StyleRendu style, int taille, Bitmap& bitmap);
+
+    /**
+     * @brief Compteurs du cache (instantané approximatif pendant les accès concurrents).
+     * 
+     * @return StatistiquesCacheConcurrent Les compteurs.
+     */
+    StatistiquesCacheConcurrent getStatistiques() const;
+
+    /**
+     * @brief Mémoire maximale des rendus en cache.
+     * 
+     * @return size_t Le budget en octets.
+     */
+    size_t getBudget() const;
+
+private:
+    /**
+     * @brief Objet dont la libération est différée jusqu'à la fin des lectures qui peuvent le voir.
+     */
+    struct Recuperable {
+        virtual ~Recuperable() = default;
+    };
+
+    struct Entree;
+
+    /**
+     * @brief Table immuable d'un fragment.
+     */
+    struct Table : Recuperable {
+        std::unordered_map<CleGlyphe, Entree*, HachageCleGlyphe> entrees;  ///< Rendus par clé.
+    };
+
+    /**
+     * @brief Fragment : une partie des clés, avec son verrou d'écriture.
+     */
+    struct alignas(64) Fragment {
+        std::mutex mutex;                    ///< Sérialise les insertions et évictions du fragment.
+        std::atomic<Table*> table{nullptr};  ///< Table publiée, immuable.
+        size_t octets = 0;                   ///< Mémoire des rendus construits (sous le verrou).
+    };
+
+    /**
+     * @brief Emplacement d'un lecteur : époque annoncée et compteurs de ses lectures.
+     */
+    struct alignas(64) Lecteur {
+        std::atomic<uint64_t> epoque{0};      ///< Époque annoncée, 0 si l'emplacement est libre.
+        std::atomic<size_t> succes{0};        ///< Succès comptés dans cet emplacement.
+        std::atomic<size_t> regroupes{0};     ///< Demandes regroupées comptées dans cet emplacement.
+    };
+
+    class Lecture;
+
+    /**
+     * @brief Fragment d'une clé.
+     * 
+     * @param cle La clé.
+     * @return Fragment& Le fragment.
+     */
+    Fragment& fragmentDe(const CleGlyphe& cle);
+
+    /**
+     * @brief Publie une nouvelle table. Appelée sous le verrou du fragment.
+     * 
+     * @param fragment Le fragment.
+     * @param table La nouvelle table.
+     * @return std::unique_ptr<Recuperable> L'ancienne table, à retirer.
+     */
+    static std::unique_ptr<Recuperable> publier(Fragment& fragment, std::unique_ptr<Table> table);
+
+    /**
+     * @brief Évince des rendus construits jusqu'à respecter la part du budget. Appelée sous le verrou du fragment.
+     * 
+     * @param fragment Le fragment.
+     * @param aRetirer Reçoit les rendus évincés et l'ancienne table.
+     */
+    void evincer(Fragment& fragment, std::vector<std::unique_ptr<Recuperable>>& aRetirer);
+
+    /**
+     * @brief Retire une entrée en construction dont la construction a échoué.
+     * 
+     * @param fragment Le fragment.
+     * @param entree L'entrée.
+     */
+    void abandonner(Fragment& fragment, Entree* entree);
+
+    /**
+     * @brief Confie des objets retirés à la récupération par époques, puis libère ce qui peut l'être.
+     * 
+     * @param objets Objets retirés (plus visibles dans aucune table publiée).
+     */
+    void retirer(std::vector<std::unique_ptr<Recuperable>> objets);
+
+    size_t budget;                                 ///< Mémoire maximale.
+    std::unique_ptr<Fragment[]> fragments;         ///< Fragments.
+    size_t masqueFragments;                        ///< Nombre de fragments - 1.
+    std::unique_ptr<Lecteur[]> lecteurs;           ///< Emplacements des lecteurs.
+    std::atomic<uint64_t> epoque{1};               ///< Époque courante.
+
+    mutable std::mutex mutexRecuperation;          ///< Protège les objets retirés.
+    std::vector<std::pair<uint64_t, std::unique_ptr<Recuperable>>> retires;  ///< Objets retirés et leur époque.
+
+    std::atomic<size_t> echecs{0};                 ///< Rendus construits.
+    std::atomic<size_t> evictions{0};              ///< Rendus évincés.
+    std::atomic<size_t> nbEntrees{0};              ///< Rendus en cache.
+    std::atomic<size_t> octets{0};                 ///< Mémoire des rendus construits.
+};
+
+#endif // CACHE_CONCURRENT_H
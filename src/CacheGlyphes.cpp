@@ -0,0 +1,154 @@
+#include "CacheGlyphes.h"
+#include "Composition.h"
+#include <stdexcept>
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param budget Mémoire maximale, en octets.
+ */
+CacheGlyphes::CacheGlyphes(size_t budget) : budget(budget) {}
+
+/**
+ * @brief Mémoire comptée pour un rendu.
+ * 
+ * @param glyphe Le rendu.
+ * @return size_t Le coût en octets.
+ */
+size_t CacheGlyphes::cout(const GlypheCache& glyphe) {
+    // Nœud de liste et nœud de table, approximativement
+    return glyphe.image.getSizeInBytes() + sizeof(Entree) + 4 * sizeof(void*);
+}
+
+/**
+ * @brief Retourne le rendu d'une lettre, calculé au besoin.
+ * 
+ * @param lettre La lettre.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @return const GlypheCache& Le rendu.
+ */
+const GlypheCache& CacheGlyphes::obtenir(char lettre, StyleRendu style, int taille) {
+    const CleGlyphe cle{lettre, style, taille};
+    const auto trouve = index.find(cle);
+    if (trouve != index.end()) {
+        ++statistiques.succes;
+        entrees.splice(entrees.begin(), entrees, trouve->second); // Devient le plus récent
+        return trouve->second->second;
+    }
+
+    ++statistiques.echecs;
+    GlypheCache glyphe = construire(rendu, lettre, style, taille);
+    statistiques.octets += cout(glyphe);
+    entrees.emplace_front(cle, std::move(glyphe));
+    index.emplace(cle, entrees.begin());
+    ++statistiques.entrees;
+
+    // Retirer les plus anciens, sans jamais retirer le rendu demandé
+    while (statistiques.octets > budget && entrees.size() > 1) {
+        const Entree& ancien = entrees.back();
+        statistiques.octets -= cout(ancien.second);
+        index.erase(ancien.first);
+        entrees.pop_back();
+        --statistiques.entrees;
+        ++statistiques.evictions;
+    }
+    return entrees.front().second;
+}
+
+/**
+ * @brief Rend une lettre et la réduit à la boîte englobante de son encre.
+ * 
+ * @param rendu Moteur de rendu.
+ * @param lettre La lettre.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @return GlypheCache Le rendu réduit.
+ */
+GlypheCache CacheGlyphes::construire(Rendu& rendu, char lettre, StyleRendu style, int taille) {
+    const Bitmap cellule = rendu.rendreLettre(lettre, style, taille);
+    GlypheCache glyphe{Bitmap(1, 1, cellule.getFormat()), false, 0, 0, cellule.getWidth(), cellule.getHeight()};
+    int x0, y0, x1, y1;
+    if (cellule.getInkBounds(x0, y0, x1, y1)) {
+        glyphe.image = Bitmap(x1 - x0 + 1, y1 - y0 + 1, cellule.getFormat());
+        Composition::composer(cellule, Rectangle{x0, y0, x1 - x0 + 1, y1 - y0 + 1}, glyphe.image, 0, 0,
+                              OperateurComposition::Copie);
+        glyphe.encre = true;
+        glyphe.decalageX = x0;
+        glyphe.decalageY = y0;
+    }
+    return glyphe;
+}
+
+/**
+ * @brief Dessine une lettre dans un bitmap.
+ * 
+ * @param lettre La lettre.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @param bitmap Bitmap de destination.
+ * @param effacer Faux si le bitmap est déjà blanc.
+ * @return Rectangle La boîte d'encre dans le bitmap.
+ */
+Rectangle CacheGlyphes::dessiner(char lettre, StyleRendu style, int taille, Bitmap& bitmap, bool effacer) {
+    if (bitmap.getFormat() != Rendu::formatPour(style)) {
+        throw std::invalid_argument("Le format du bitmap ne convient pas au style de rendu.");
+    }
+    return copier(obtenir(lettre, style, taille), bitmap, effacer);
+}
+
+/**
+ * @brief Efface un bitmap et y copie un rendu.
+ * 
+ * @param glyphe Le rendu.
+ * @param bitmap Bitmap de destination.
+ * @param effacer Faux si le bitmap est déjà blanc.
+ * @return Rectangle La boîte d'encre dans le bitmap.
+ */
+Rectangle CacheGlyphes::copier(const GlypheCache& glyphe, Bitmap& bitmap, bool effacer) {
+    if (effacer) {
+        bitmap.clear();
+    }
+    if (!glyphe.encre) {
+        return Rectangle{0, 0, 0, 0};
+    }
+    Composition::composer(glyphe.image, bitmap, glyphe.decalageX, glyphe.decalageY, OperateurComposition::Copie);
+    return Rectangle{glyphe.decalageX, glyphe.decalageY, glyphe.image.getWidth(), glyphe.image.getHeight()};
+}
+
+/**
+ * @brief Compteurs du cache.
+ * 
+ * @return StatistiquesCache Les compteurs.
+ */
+StatistiquesCache CacheGlyphes::getStatistiques() const {
+    return statistiques;
+}
+
+/**
+ * @brief Mémoire maximale des rendus en cache.
+ * 
+ * @return size_t Le budget.
+ */
+size_t CacheGlyphes::getBudget() const {
+    return budget;
+}
+
+/**
+ * @brief Mémoire occupée par les aplatissements des glyphes du moteur de rendu.
+ * 
+ * @return size_t La mémoire, en octets.
+ */
+size_t CacheGlyphes::getMemoireAplatissements() const {
+    return rendu.getMemoireAplatissements();
+}
+
+/**
+ * @brief Retire tous les rendus.
+ */
+void CacheGlyphes::vider() {
+    index.clear();
+    entrees.clear();
+    statistiques.entrees = 0;
+    statistiques.octets = 0;
+}
@@ -0,0 +1,192 @@
+#ifndef CACHE_GLYPHES_H
+#define CACHE_GLYPHES_H
+
+#include "Bitmap.h"
+#include "Composition.h"
+#include "Rendu.h"
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Clé d'un rendu en cache.
+ */
+struct CleGlyphe {
+    char lettre;       ///< La lettre (majuscule).
+    StyleRendu style;  ///< Le style du rendu.
+    int taille;        ///< Hauteur du rendu en pixels.
+
+    /**
+     * @brief Égalité de deux clés.
+     * 
+     * @param autre L'autre clé.
+     * @return bool Vrai si les trois champs sont égaux.
+     */
+    bool operator==(const CleGlyphe& autre) const {
+        return lettre == autre.lettre && style == autre.style && taille == autre.taille;
+    }
+};
+
+/**
+ * @brief Hachage d'une clé de rendu.
+ */
+struct HachageCleGlyphe {
+    /**
+     * @brief Calcule le hachage.
+     * 
+     * @param cle La clé.
+     * @return size_t Lettre, style et taille juxtaposés.
+     */
+    size_t operator()(const CleGlyphe& cle) const {
+        return static_cast<unsigned char>(cle.lettre) | (static_cast<size_t>(cle.style) << 8)
+             | (static_cast<size_t>(cle.taille) << 16);
+    }
+};
+
+/**
+ * @brief Rendu d'une lettre réduit à la boîte englobante de son encre.
+ */
+struct GlypheCache {
+    Bitmap image;   ///< Pixels de la boîte d'encre (1 x 1 blanc si la lettre n'a pas d'encre).
+    bool encre;     ///< Faux si le rendu est entièrement blanc.
+    int decalageX;  ///< Colonne de la boîte dans la cellule de rendu.
+    int decalageY;  ///< Ligne de la boîte dans la cellule de rendu.
+    int largeur;    ///< Largeur de la cellule de rendu (Rendu::largeur()).
+    int hauteur;    ///< Hauteur de la cellule de rendu (la taille).
+};
+
+/**
+ * @brief Compteurs d'un cache de glyphes.
+ */
+struct StatistiquesCache {
+    size_t succes = 0;     ///< Rendus trouvés dans le cache.
+    size_t echecs = 0;     ///< Rendus absents, calculés puis ajoutés.
+    size_t evictions = 0;  ///< Rendus retirés pour respecter le budget.
+    size_t entrees = 0;    ///< Nombre de rendus en cache.
+    size_t octets = 0;     ///< Mémoire occupée par les rendus en cache.
+};
+
+/**
+ * @brief Cache des rendus de lettres, borné en mémoire, avec éviction LRU.
+ * 
+ * Chaque rendu est calculé une fois par Rendu, réduit à la boîte de son encre
+ * et rangé sous la clé (lettre, style, taille). Un succès ne coûte qu'une
+ * recherche dans une table de hachage et, pour dessiner(), un effacement et
+ * une copie de la boîte (Composition::composer()) ; obtenir() donne accès
+ * au rendu sans copie. Quand la mémoire occupée dépasse le budget, les rendus
+ * les moins récemment utilisés sont retirés.
+ * 
+ * Comme Rendu, un cache n'est pas protégé contre les accès concurrents.
+ */
+class CacheGlyphes {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param budget Mémoire maximale des rendus en cache, en octets.
+     */
+    explicit CacheGlyphes(size_t budget = 16 * 1024 * 1024);
+
+    /**
+     * @brief Retourne le rendu d'une lettre, calculé au besoin.
+     * 
+     * Le rendu le plus récent est toujours conservé, même s'il dépasse à lui
+     * seul le budget.
+     * 
+     * @param lettre La lettre (majuscule).
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @return const GlypheCache& Le rendu. La référence reste valide jusqu'à
+     *         l'éviction du rendu (au plus tôt au prochain échec) ou vider().
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0.
+     */
+    const GlypheCache& obtenir(char lettre, StyleRendu style, int taille);
+
+    /**
+     * @brief Dessine une lettre dans un bitmap, comme Rendu::rendreLettre().
+     * 
+     * Le bitmap est effacé puis la boîte d'encre est copiée à sa place ; le
+     * résultat est identique à celui de Rendu::rendreLettre().
+     * 
+     * @param lettre La lettre (majuscule).
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @param bitmap Bitmap de destination, au format Rendu::formatPour(style).
+     * @param effacer Faux si le bitmap est déjà blanc (pris dans un PoolBitmaps,
+     *                par exemple) : seule la boîte d'encre est alors écrite.
+     * @return Rectangle La boîte d'encre dans le bitmap (vide si la lettre n'a pas d'encre).
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0, ou si le format ne convient pas au style.
+     */
+    Rectangle dessiner(char lettre, StyleRendu style, int taille, Bitmap& bitmap, bool effacer = true);
+
+    /**
+     * @brief Rend une lettre et la réduit à la boîte englobante de son encre.
+     * 
+     * @param rendu Moteur de rendu.
+     * @param lettre La lettre (majuscule).
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @return GlypheCache Le rendu réduit.
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0.
+     */
+    static GlypheCache construire(Rendu& rendu, char lettre, StyleRendu style, int taille);
+
+    /**
+     * @brief Efface un bitmap et y copie un rendu à sa place dans la cellule.
+     * 
+     * @param glyphe Le rendu.
+     * @param bitmap Bitmap de destination.
+     * @param effacer Faux si le bitmap est déjà blanc.
+     * @return Rectangle La boîte d'encre dans le bitmap.
+     */
+    static Rectangle copier(const GlypheCache& glyphe, Bitmap& bitmap, bool effacer = true);
+
+    /**
+     * @brief Compteurs du cache.
+     * 
+     * @return StatistiquesCache Succès, échecs, évictions et occupation.
+     */
+    StatistiquesCache getStatistiques() const;
+
+    /**
+     * @brief Mémoire maximale des rendus en cache.
+     * 
+     * @return size_t Le budget en octets.
+     */
+    size_t getBudget() const;
+
+    /**
+     * @brief Mémoire occupée par les aplatissements des glyphes du moteur de rendu.
+     * 
+     * @return size_t La mémoire, en octets (voir Rendu::getMemoireAplatissements()).
+     */
+    size_t getMemoireAplatissements() const;
+
+    /**
+     * @brief Retire tous les rendus (les compteurs de succès, d'échecs et d'évictions sont conservés).
+     */
+    void vider();
+
+private:
+    using Entree = std::pair<CleGlyphe, GlypheCache>;
+
+    /**
+     * @brief Mémoire comptée pour un rendu.
+     * 
+     * @param glyphe Le rendu.
+     * @return size_t Pixels et structures d'index.
+     */
+    static size_t cout(const GlypheCache& glyphe);
+
+    Rendu rendu;                    ///< Moteur des rendus absents du cache.
+    size_t budget;                  ///< Mémoire maximale.
+    std::list<Entree> entrees;      ///< Rendus, du plus récemment utilisé au plus ancien.
+    std::unordered_map<CleGlyphe, std::list<Entree>::iterator, HachageCleGlyphe> index;  ///< Accès par clé.
+    StatistiquesCache statistiques; ///< Compteurs.
+};
+
+#endif // CACHE_GLYPHES_H
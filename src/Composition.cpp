@@ -0,0 +1,594 @@
+#include "Composition.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define COMPOSITION_X86
+#include <immintrin.h>
+#define CIBLE_SSE2 __attribute__((target("sse2")))
+#define CIBLE_AVX2 __attribute__((target("avx2")))
+#endif
+
+/// Noyau 8 bits : combine n pixels de la source (déjà convertie) dans la destination.
+using Noyau = void (*)(uint8_t* destination, const uint8_t* source, size_t n, uint8_t cle);
+
+/// Noyau d'empaquetage : met à 1 le bit i de `bits` si source[i] est non nul (bits nuls au départ).
+using NoyauEmpaquetage = void (*)(const uint8_t* source, size_t n, uint64_t* bits);
+
+/**
+ * @brief Noyaux d'un jeu d'instructions.
+ */
+struct Noyaux {
+    Noyau maximum;                ///< Ou en Coverage8 : maximum des couvertures.
+    Noyau selection;              ///< CleCouleur (et Ou en Index8, avec la clé 0).
+    Noyau sous;                   ///< Sous : la source là où la destination est blanche.
+    Noyau alpha;                  ///< AlphaSur : d = s + d (255 - s) / 255.
+    NoyauEmpaquetage empaqueter;  ///< Conversion d'une ligne 8 bits en bits.
+};
+
+/**
+ * @brief Divise par 255 avec arrondi au plus proche, exactement pour v <= 255 * 255.
+ * 
+ * @param v Le dividende.
+ * @return uint8_t v / 255 arrondi.
+ */
+static uint8_t diviser255(unsigned v) {
+    v += 128;
+    return static_cast<uint8_t>((v + (v >> 8)) >> 8);
+}
+
+/**
+ * @brief Ou en Coverage8 : maximum des couvertures.
+ */
+static void maximumScalaire(uint8_t* d, const uint8_t* s, size_t n, uint8_t) {
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = std::max(d[i], s[i]);
+    }
+}
+
+/**
+ * @brief CleCouleur : les pixels de la source différents de la clé remplacent la destination.
+ */
+static void selectionScalaire(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    for (size_t i = 0; i < n; ++i) {
+        if (s[i] != cle) {
+            d[i] = s[i];
+        }
+    }
+}
+
+/**
+ * @brief Sous : la source n'est posée que sur les pixels blancs de la destination.
+ */
+static void sousScalaire(uint8_t* d, const uint8_t* s, size_t n, uint8_t) {
+    for (size_t i = 0; i < n; ++i) {
+        if (d[i] == 0) {
+            d[i] = s[i];
+        }
+    }
+}
+
+/**
+ * @brief AlphaSur : encre noire de couverture s posée sur d, d = s + d (255 - s) / 255.
+ */
+static void alphaScalaire(uint8_t* d, const uint8_t* s, size_t n, uint8_t) {
+    for (size_t i = 0; i < n; ++i) {
+        d[i] = static_cast<uint8_t>(s[i] + diviser255(d[i] * (255u - s[i])));
+    }
+}
+
+/**
+ * @brief Empaquette une ligne 8 bits en bits : tout pixel non nul est encré.
+ */
+static void empaqueterScalaire(const uint8_t* s, size_t n, uint64_t* bits) {
+    for (size_t i = 0; i < n; ++i) {
+        if (s[i]) {
+            bits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+}
+
+#ifdef COMPOSITION_X86
+
+// Mêmes noyaux sur 16 (SSE2) puis 32 (AVX2) pixels par itération ; la fin de ligne est
+// confiée au noyau scalaire.
+
+CIBLE_SSE2 static void maximumSSE2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_max_epu8(a, b));
+    }
+    maximumScalaire(d + i, s + i, n - i, cle);
+}
+
+CIBLE_SSE2 static void selectionSSE2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    const __m128i cles = _mm_set1_epi8(static_cast<char>(cle));
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i transparent = _mm_cmpeq_epi8(b, cles);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i),
+                         _mm_or_si128(_mm_and_si128(transparent, a), _mm_andnot_si128(transparent, b)));
+    }
+    selectionScalaire(d + i, s + i, n - i, cle);
+}
+
+CIBLE_SSE2 static void sousSSE2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i blanc = _mm_cmpeq_epi8(a, zero);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_or_si128(a, _mm_and_si128(blanc, b)));
+    }
+    sousScalaire(d + i, s + i, n - i, cle);
+}
+
+/**
+ * @brief AlphaSur sur huit pixels étendus à 16 bits (même calcul que diviser255()).
+ */
+CIBLE_SSE2 static __m128i alpha16SSE2(__m128i d16, __m128i s16) {
+    __m128i t = _mm_mullo_epi16(d16, _mm_sub_epi16(_mm_set1_epi16(255), s16));
+    t = _mm_add_epi16(t, _mm_set1_epi16(128));
+    t = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+    return _mm_add_epi16(s16, t);
+}
+
+CIBLE_SSE2 static void alphaSSE2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(d + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const __m128i bas = alpha16SSE2(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        const __m128i haut = alpha16SSE2(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(d + i), _mm_packus_epi16(bas, haut));
+    }
+    alphaScalaire(d + i, s + i, n - i, cle);
+}
+
+CIBLE_SSE2 static void empaqueterSSE2(const uint8_t* s, size_t n, uint64_t* bits) {
+    const __m128i zero = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+        const uint64_t encre = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) & 0xFFFFu;
+        bits[i >> 6] |= encre << (i & 63); // i multiple de 16 : jamais à cheval sur deux mots
+    }
+    for (; i < n; ++i) {
+        if (s[i]) {
+            bits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+}
+
+CIBLE_AVX2 static void maximumAVX2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_max_epu8(a, b));
+    }
+    maximumScalaire(d + i, s + i, n - i, cle);
+}
+
+CIBLE_AVX2 static void selectionAVX2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    const __m256i cles = _mm256_set1_epi8(static_cast<char>(cle));
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_blendv_epi8(b, a, _mm256_cmpeq_epi8(b, cles)));
+    }
+    selectionScalaire(d + i, s + i, n - i, cle);
+}
+
+CIBLE_AVX2 static void sousAVX2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_blendv_epi8(a, b, _mm256_cmpeq_epi8(a, zero)));
+    }
+    sousScalaire(d + i, s + i, n - i, cle);
+}
+
+/**
+ * @brief AlphaSur sur seize pixels étendus à 16 bits (même calcul que diviser255()).
+ */
+CIBLE_AVX2 static __m256i alpha16AVX2(__m256i d16, __m256i s16) {
+    __m256i t = _mm256_mullo_epi16(d16, _mm256_sub_epi16(_mm256_set1_epi16(255), s16));
+    t = _mm256_add_epi16(t, _mm256_set1_epi16(128));
+    t = _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+    return _mm256_add_epi16(s16, t);
+}
+
+CIBLE_AVX2 static void alphaAVX2(uint8_t* d, const uint8_t* s, size_t n, uint8_t cle) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        // Dépaquetage et réempaquetage travaillent tous deux par moitié de 128 bits : l'ordre est conservé
+        const __m256i bas = alpha16AVX2(_mm256_unpacklo_epi8(a, zero), _mm256_unpacklo_epi8(b, zero));
+        const __m256i haut = alpha16AVX2(_mm256_unpackhi_epi8(a, zero), _mm256_unpackhi_epi8(b, zero));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + i), _mm256_packus_epi16(bas, haut));
+    }
+    alphaScalaire(d + i, s + i, n - i, cle);
+}
+
+CIBLE_AVX2 static void empaqueterAVX2(const uint8_t* s, size_t n, uint64_t* bits) {
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+        const uint64_t encre = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+        bits[i >> 6] |= (encre & 0xFFFFFFFFu) << (i & 63); // i multiple de 32 : jamais à cheval sur deux mots
+    }
+    for (; i < n; ++i) {
+        if (s[i]) {
+            bits[i >> 6] |= 1ULL << (i & 63);
+        }
+    }
+}
+
+#endif // COMPOSITION_X86
+
+/**
+ * @brief Meilleur jeu d'instructions pris en charge par le processeur.
+ * 
+ * @return JeuInstructions Le jeu détecté.
+ */
+JeuInstructions Composition::getJeuInstructionsDisponible() {
+#ifdef COMPOSITION_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return JeuInstructions::AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return JeuInstructions::SSE2;
+    }
+#endif
+    return JeuInstructions::Scalaire;
+}
+
+/**
+ * @brief Jeu d'instructions courant, détecté au premier appel.
+ * 
+ * @return std::atomic<JeuInstructions>& Le jeu courant.
+ */
+static std::atomic<JeuInstructions>& jeuCourant() {
+    static std::atomic<JeuInstructions> jeu(Composition::getJeuInstructionsDisponible());
+    return jeu;
+}
+
+/**
+ * @brief Jeu d'instructions utilisé par les noyaux.
+ * 
+ * @return JeuInstructions Le jeu courant.
+ */
+JeuInstructions Composition::getJeuInstructions() {
+    return jeuCourant().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Impose un jeu d'instructions.
+ * 
+ * @param jeu Le jeu à utiliser.
+ */
+void Composition::setJeuInstructions(JeuInstructions jeu) {
+    if (static_cast<int>(jeu) > static_cast<int>(getJeuInstructionsDisponible())) {
+        throw std::invalid_argument(std::string("Jeu d'instructions non pris en charge : ") + nomJeuInstructions(jeu));
+    }
+    jeuCourant().store(jeu, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Nom d'un jeu d'instructions.
+ * 
+ * @param jeu Le jeu d'instructions.
+ * @return Le nom du jeu.
+ */
+const char* Composition::nomJeuInstructions(JeuInstructions jeu) {
+    switch (jeu) {
+    case JeuInstructions::Scalaire:
+        return "scalaire";
+    case JeuInstructions::SSE2:
+        return "sse2";
+    case JeuInstructions::AVX2:
+        return "avx2";
+    }
+    return "";
+}
+
+/**
+ * @brief Noyaux du jeu d'instructions courant.
+ * 
+ * @return const Noyaux& Les noyaux.
+ */
+static const Noyaux& noyaux() {
+    static const Noyaux scalaires = {maximumScalaire, selectionScalaire, sousScalaire, alphaScalaire, empaqueterScalaire};
+#ifdef COMPOSITION_X86
+    static const Noyaux sse2 = {maximumSSE2, selectionSSE2, sousSSE2, alphaSSE2, empaqueterSSE2};
+    static const Noyaux avx2 = {maximumAVX2, selectionAVX2, sousAVX2, alphaAVX2, empaqueterAVX2};
+    switch (Composition::getJeuInstructions()) {
+    case JeuInstructions::AVX2:
+        return avx2;
+    case JeuInstructions::SSE2:
+        return sse2;
+    case JeuInstructions::Scalaire:
+        break;
+    }
+#endif
+    return scalaires;
+}
+
+/**
+ * @brief Table d'expansion de 8 pixels 1 bit en 8 octets (0x00 ou 0xFF).
+ * 
+ * @return Un tableau de 256 mots ; l'octet i du mot (en mémoire) correspond au bit i.
+ */
+static const uint64_t* expansionBits() {
+    struct Table {
+        uint64_t mots[256];
+        Table() {
+            for (int i = 0; i < 256; ++i) {
+                uint8_t octets[8];
+                for (int b = 0; b < 8; ++b) {
+                    octets[b] = ((i >> b) & 1) ? 0xFF : 0x00;
+                }
+                std::memcpy(&mots[i], octets, sizeof(octets));
+            }
+        }
+    };
+    static const Table table;
+    return table.mots;
+}
+
+/**
+ * @brief Lit une portion de ligne de la source, convertie au format de la destination.
+ * 
+ * @param source Bitmap source.
+ * @param y Ligne lue.
+ * @param x0 Première colonne lue.
+ * @param largeur Nombre de pixels.
+ * @param format Format 8 bits de la destination.
+ * @param couleur Couleur Index8 des pixels encrés.
+ * @param tampon Tampon de conversion, agrandi au besoin.
+ * @return const uint8_t* Les pixels convertis (la ligne de la source elle-même si les formats sont égaux).
+ */
+static const uint8_t* ligneConvertie(const Bitmap& source, int y, int x0, int largeur, PixelFormat format,
+                                     uint8_t couleur, std::vector<uint8_t>& tampon) {
+    if (source.getFormat() == format) {
+        return source.row(y) + x0;
+    }
+    const uint8_t valeur = (format == PixelFormat::Coverage8) ? 255 : couleur;
+    tampon.resize((static_cast<size_t>(largeur) + 63) & ~static_cast<size_t>(63));
+
+    if (source.getFormat() == PixelFormat::Bit1) {
+        // 64 pixels par lecture, 8 par consultation de la table
+        const uint64_t* expansion = expansionBits();
+        const uint64_t motValeur = 0x0101010101010101ULL * valeur;
+        const uint64_t* mots = source.rowWords(y);
+        for (int k = 0; k < largeur; k += 64) {
+            const uint64_t bits = Bitmap::readBits(mots, source.getWordsPerRow(), static_cast<long long>(x0) + k);
+            for (int b = 0; b < 8; ++b) {
+                const uint64_t octets = expansion[(bits >> (8 * b)) & 0xFF] & motValeur;
+                std::memcpy(tampon.data() + k + 8 * b, &octets, sizeof(octets));
+            }
+        }
+    } else {
+        const uint8_t* ligne = source.row(y) + x0;
+        for (int x = 0; x < largeur; ++x) {
+            tampon[x] = ligne[x] ? valeur : 0;
+        }
+    }
+    return tampon.data();
+}
+
+/**
+ * @brief Compose des lignes sur une destination 8 bits.
+ * 
+ * @param source Bitmap source.
+ * @param sx Première colonne de la source.
+ * @param sy Première ligne de la source.
+ * @param largeur Nombre de colonnes.
+ * @param hauteur Nombre de lignes.
+ * @param destination Bitmap destination (Index8 ou Coverage8).
+ * @param x Première colonne de la destination.
+ * @param y Première ligne de la destination.
+ * @param operateur Opérateur de composition.
+ * @param couleur Couleur Index8 des pixels encrés.
+ * @param cle Valeur transparente pour CleCouleur.
+ */
+static void composerOctets(const Bitmap& source, int sx, int sy, int largeur, int hauteur, Bitmap& destination,
+                           int x, int y, OperateurComposition operateur, uint8_t couleur, uint8_t cle) {
+    const Noyaux& n = noyaux();
+    const bool couverture = destination.getFormat() == PixelFormat::Coverage8;
+    thread_local std::vector<uint8_t> tampon;
+    const size_t taille = static_cast<size_t>(largeur);
+
+    for (int r = 0; r < hauteur; ++r) {
+        const uint8_t* s = ligneConvertie(source, sy + r, sx, largeur, destination.getFormat(), couleur, tampon);
+        uint8_t* d = destination.row(y + r) + x;
+        switch (operateur) {
+        case OperateurComposition::Copie:
+            std::memcpy(d, s, taille);
+            break;
+        case OperateurComposition::Ou:
+            if (couverture) {
+                n.maximum(d, s, taille, 0);
+            } else {
+                n.selection(d, s, taille, 0);
+            }
+            break;
+        case OperateurComposition::CleCouleur:
+            n.selection(d, s, taille, cle);
+            break;
+        case OperateurComposition::AlphaSur:
+            n.alpha(d, s, taille, 0);
+            break;
+        case OperateurComposition::Sous:
+            n.sous(d, s, taille, 0);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Compose des lignes sur une destination Bit1, par mots de 64 pixels.
+ * 
+ * Chaque mot de la destination est combiné aux 64 pixels correspondants de la
+ * source par un masque des pixels à remplacer ("opaques").
+ * 
+ * @param source Bitmap source.
+ * @param sx Première colonne de la source.
+ * @param sy Première ligne de la source.
+ * @param largeur Nombre de colonnes.
+ * @param hauteur Nombre de lignes.
+ * @param destination Bitmap destination (Bit1).
+ * @param x Première colonne de la destination.
+ * @param y Première ligne de la destination.
+ * @param operateur Opérateur de composition.
+ * @param cle Valeur transparente pour CleCouleur (0 : blanc, sinon encre).
+ */
+static void composerBits(const Bitmap& source, int sx, int sy, int largeur, int hauteur, Bitmap& destination,
+                         int x, int y, OperateurComposition operateur, uint8_t cle) {
+    const int premier = x >> 6;
+    const int dernier = (x + largeur - 1) >> 6;
+    const uint64_t masqueDebut = ~0ULL << (x & 63);
+    const uint64_t masqueFin = ~0ULL >> (63 - ((x + largeur - 1) & 63));
+    thread_local std::vector<uint64_t> tampon;
+
+    for (int r = 0; r < hauteur; ++r) {
+        // Pixels de la source : ligne d'origine en Bit1, sinon empaquetés dans le tampon
+        const uint64_t* mots;
+        int nbMots;
+        long long decalage; // Colonne de `mots` correspondant à la colonne 0 de la destination
+        if (source.getFormat() == PixelFormat::Bit1) {
+            mots = source.rowWords(sy + r);
+            nbMots = source.getWordsPerRow();
+            decalage = static_cast<long long>(sx) - x;
+        } else {
+            nbMots = (largeur + 63) / 64;
+            tampon.assign(nbMots, 0);
+            noyaux().empaqueter(source.row(sy + r) + sx, static_cast<size_t>(largeur), tampon.data());
+            mots = tampon.data();
+            decalage = -static_cast<long long>(x);
+        }
+
+        uint64_t* ligne = destination.rowWords(y + r);
+        for (int j = premier; j <= dernier; ++j) {
+            uint64_t masque = ~0ULL;
+            if (j == premier) {
+                masque &= masqueDebut;
+            }
+            if (j == dernier) {
+                masque &= masqueFin;
+            }
+            const uint64_t v = Bitmap::readBits(mots, nbMots, 64LL * j + decalage);
+            uint64_t opaque;
+            switch (operateur) {
+            case OperateurComposition::Copie:
+                opaque = masque;
+                break;
+            case OperateurComposition::CleCouleur:
+                opaque = (cle ? ~v : v) & masque;
+                break;
+            default: // Ou, Sous : seuls les pixels encrés comptent
+                opaque = v & masque;
+                break;
+            }
+            ligne[j] = (ligne[j] & ~opaque) | (v & opaque);
+        }
+    }
+}
+
+/**
+ * @brief Compose un rectangle d'un bitmap sur un autre.
+ * 
+ * @param source Bitmap source.
+ * @param zone Rectangle de la source à composer.
+ * @param destination Bitmap destination.
+ * @param x Colonne de destination du coin de la zone.
+ * @param y Ligne de destination du coin de la zone.
+ * @param operateur Opérateur de composition.
+ * @param couleur Couleur Index8 des pixels encrés.
+ * @param cle Valeur transparente pour CleCouleur.
+ */
+void Composition::composer(const Bitmap& source, const Rectangle& zone, Bitmap& destination, int x, int y,
+                           OperateurComposition operateur, int couleur, int cle) {
+    TRACE_PORTEE("Composition::composer");
+    if (operateur == OperateurComposition::AlphaSur && destination.getFormat() != PixelFormat::Coverage8) {
+        throw std::invalid_argument("La composition alpha demande une destination au format Coverage8.");
+    }
+    if (&source == &destination) {
+        const Bitmap copie = source; // Les lignes lues ne doivent pas être modifiées en cours de route
+        composer(copie, zone, destination, x, y, operateur, couleur, cle);
+        return;
+    }
+
+    // Découpage aux bords de la source, puis de la destination
+    long long sx0 = zone.x, sy0 = zone.y;
+    long long sx1 = sx0 + std::max(0, zone.largeur), sy1 = sy0 + std::max(0, zone.hauteur);
+    long long dx = x, dy = y;
+    if (sx0 < 0) {
+        dx -= sx0;
+        sx0 = 0;
+    }
+    if (sy0 < 0) {
+        dy -= sy0;
+        sy0 = 0;
+    }
+    if (dx < 0) {
+        sx0 -= dx;
+        dx = 0;
+    }
+    if (dy < 0) {
+        sy0 -= dy;
+        dy = 0;
+    }
+    sx1 = std::min({sx1, static_cast<long long>(source.getWidth()), sx0 + destination.getWidth() - dx});
+    sy1 = std::min({sy1, static_cast<long long>(source.getHeight()), sy0 + destination.getHeight() - dy});
+    if (sx0 >= sx1 || sy0 >= sy1) {
+        return;
+    }
+
+    const int largeur = static_cast<int>(sx1 - sx0);
+    const int hauteur = static_cast<int>(sy1 - sy0);
+    TRACE_PIXELS(static_cast<uint64_t>(largeur) * hauteur);
+    if (destination.getFormat() == PixelFormat::Bit1) {
+        composerBits(source, static_cast<int>(sx0), static_cast<int>(sy0), largeur, hauteur, destination,
+                     static_cast<int>(dx), static_cast<int>(dy), operateur, cle ? 1 : 0);
+    } else {
+        composerOctets(source, static_cast<int>(sx0), static_cast<int>(sy0), largeur, hauteur, destination,
+                       static_cast<int>(dx), static_cast<int>(dy), operateur,
+                       static_cast<uint8_t>(couleur), static_cast<uint8_t>(cle));
+    }
+}
+
+/**
+ * @brief Compose un bitmap entier sur un autre.
+ * 
+ * @param source Bitmap source.
+ * @param destination Bitmap destination.
+ * @param x Colonne de destination de la colonne 0 de la source.
+ * @param y Ligne de destination de la ligne 0 de la source.
+ * @param operateur Opérateur de composition.
+ * @param couleur Couleur Index8 des pixels encrés.
+ * @param cle Valeur transparente pour CleCouleur.
+ */
+void Composition::composer(const Bitmap& source, Bitmap& destination, int x, int y,
+                           OperateurComposition operateur, int couleur, int cle) {
+    composer(source, Rectangle{0, 0, source.getWidth(), source.getHeight()}, destination, x, y, operateur, couleur, cle);
+}
@@ -0,0 +1,118 @@
+#ifndef COMPOSITION_H
+#define COMPOSITION_H
+
+#include "Bitmap.h"
+
+/**
+ * @brief Opérateurs de composition d'une source sur une destination.
+ * 
+ * Les pixels de la source sont d'abord convertis au format de la destination
+ * (voir Composition::composer()), puis combinés pixel à pixel.
+ */
+enum class OperateurComposition {
+    Copie,       ///< La source remplace la destination.
+    Ou,          ///< Les pixels encrés de la source s'ajoutent (OU en Bit1, maximum en Coverage8).
+    CleCouleur,  ///< Les pixels de la source égaux à la clé sont transparents, les autres remplacent la destination.
+    AlphaSur,    ///< La source, lue comme couverture d'encre noire, est posée par-dessus (destination Coverage8).
+    Sous         ///< Les pixels encrés de la source ne sont posés que sur les pixels blancs de la destination.
+};
+
+/**
+ * @brief Jeux d'instructions utilisables par les noyaux de composition.
+ */
+enum class JeuInstructions {
+    Scalaire,  ///< Boucles portables, octet par octet.
+    SSE2,      ///< 16 pixels 8 bits par instruction.
+    AVX2       ///< 32 pixels 8 bits par instruction.
+};
+
+/**
+ * @brief Rectangle de pixels.
+ */
+struct Rectangle {
+    int x;        ///< Première colonne.
+    int y;        ///< Première ligne.
+    int largeur;  ///< Nombre de colonnes.
+    int hauteur;  ///< Nombre de lignes.
+};
+
+/**
+ * @brief Copie et composition de rectangles de pixels entre bitmaps.
+ * 
+ * Le découpage aux bords des deux bitmaps est calculé une fois par appel ;
+ * chaque ligne est ensuite traitée d'un bloc, sans test de bornes par pixel.
+ * Entre formats 8 bits, les lignes passent par des noyaux SSE2 ou AVX2 choisis
+ * à l'exécution selon le processeur (boucles scalaires ailleurs) ; vers une
+ * destination Bit1, par mots de 64 pixels.
+ */
+class Composition {
+public:
+    /**
+     * @brief Compose un rectangle d'un bitmap sur un autre.
+     * 
+     * Conversion des pixels source au format de la destination : en Bit1, tout
+     * pixel non blanc est encré ; en Coverage8, il devient une couverture de
+     * 255 (sauf depuis Coverage8) ; en Index8, un pixel encré d'une source
+     * Bit1 ou Coverage8 prend la couleur `couleur`.
+     * 
+     * @param source Bitmap source.
+     * @param zone Rectangle de la source à composer (découpé aux bords de la source).
+     * @param destination Bitmap destination.
+     * @param x Colonne de la destination recevant le coin supérieur gauche de la zone.
+     * @param y Ligne de la destination recevant le coin supérieur gauche de la zone.
+     * @param operateur Opérateur de composition.
+     * @param couleur Couleur Index8 des pixels encrés d'une source Bit1 ou Coverage8.
+     * @param cle Valeur transparente pour CleCouleur, comparée aux pixels convertis.
+     * 
+     * @throws std::invalid_argument Pour AlphaSur sur une destination qui n'est pas Coverage8.
+     */
+    static void composer(const Bitmap& source, const Rectangle& zone, Bitmap& destination, int x, int y,
+                         OperateurComposition operateur, int couleur = 1, int cle = 0);
+
+    /**
+     * @brief Compose un bitmap entier sur un autre.
+     * 
+     * @param source Bitmap source.
+     * @param destination Bitmap destination.
+     * @param x Colonne de la destination recevant la colonne 0 de la source.
+     * @param y Ligne de la destination recevant la ligne 0 de la source.
+     * @param operateur Opérateur de composition.
+     * @param couleur Couleur Index8 des pixels encrés d'une source Bit1 ou Coverage8.
+     * @param cle Valeur transparente pour CleCouleur.
+     */
+    static void composer(const Bitmap& source, Bitmap& destination, int x, int y,
+                         OperateurComposition operateur, int couleur = 1, int cle = 0);
+
+    /**
+     * @brief Jeu d'instructions utilisé par les noyaux.
+     * 
+     * @return JeuInstructions Le meilleur disponible, sauf choix par setJeuInstructions().
+     */
+    static JeuInstructions getJeuInstructions();
+
+    /**
+     * @brief Meilleur jeu d'instructions pris en charge par le processeur.
+     * 
+     * @return JeuInstructions Le jeu détecté.
+     */
+    static JeuInstructions getJeuInstructionsDisponible();
+
+    /**
+     * @brief Impose un jeu d'instructions (pour les mesures et les comparaisons).
+     * 
+     * @param jeu Le jeu à utiliser.
+     * 
+     * @throws std::invalid_argument Si le processeur ne le prend pas en charge.
+     */
+    static void setJeuInstructions(JeuInstructions jeu);
+
+    /**
+     * @brief Nom d'un jeu d'instructions.
+     * 
+     * @param jeu Le jeu d'instructions.
+     * @return "scalaire", "sse2" ou "avx2".
+     */
+    static const char* nomJeuInstructions(JeuInstructions jeu);
+};
+
+#endif // COMPOSITION_H
@@ -1,6 +1,13 @@
 /// Glyph.cpp
 #include "Glyph.h"
+#include "Composition.h"
+#include "RasteriseurCouverture.h"
+#include "Morphologie.h"
+#include "Trait.h"
+#include "Trace.h"
 #include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <iostream> // Ajoutez cette ligne
 
 /**
@@ -8,44 +15,223 @@
  * 
  * @param curves Liste des courbes de Bézier définissant le glyphe.
  */
-Glyph::Glyph(const std::vector<std::vector<Point>>& curves) : curves(curves) {}
+Glyph::Glyph(const std::vector<std::vector<Point>>& curves) {
+    auto copie = std::make_shared<Stockage>();
+    for (const auto& curve : curves) {
+        if (curve.empty()) {
+            continue;
+        }
+        if (curve.size() > 256) {
+            throw std::invalid_argument("Une courbe ne peut pas avoir plus de 256 points de contrôle.");
+        }
+        copie->courbes.push_back({static_cast<uint32_t>(copie->points.size()), static_cast<uint8_t>(curve.size() - 1)});
+        copie->points.insert(copie->points.end(), curve.begin(), curve.end());
+    }
+    points = copie->points.data();
+    courbes = copie->courbes.data();
+    nbCourbes = copie->courbes.size();
+    stockage = std::move(copie);
+}
+
+/**
+ * @brief Constructeur référençant des courbes externes.
+ * 
+ * @param points Tableau des points de contrôle.
+ * @param courbes Courbes du glyphe.
+ * @param nbCourbes Nombre de courbes.
+ */
+Glyph::Glyph(const Point* points, const CourbeGlyphe* courbes, size_t nbCourbes)
+    : points(points), courbes(courbes), nbCourbes(nbCourbes) {}
+
+/**
+ * @brief Change l'échelle appliquée aux points de contrôle.
+ * 
+ * @param echelle Facteur multiplicatif.
+ */
+void Glyph::setEchelle(float echelle) {
+    if (!(echelle > 0.0f)) {
+        throw std::invalid_argument("L'échelle doit être strictement positive.");
+    }
+    this->echelle = echelle;
+}
+
+/**
+ * @brief Change la tolérance d'aplatissement.
+ * 
+ * @param tolerance Écart maximal en pixels.
+ */
+void Glyph::setTolerance(float tolerance) {
+    if (!(tolerance > 0.0f)) {
+        throw std::invalid_argument("La tolérance doit être strictement positive.");
+    }
+    this->tolerance = tolerance;
+}
+
+/**
+ * @brief Aplatit les courbes du glyphe en contours enchaînés.
+ * 
+ * @param echelle Échelle appliquée aux points de contrôle.
+ * @param tolerance Tolérance d'aplatissement.
+ * @return Le nouvel aplatissement.
+ */
+std::shared_ptr<const Glyph::Aplatissement> Glyph::aplatir(float echelle, float tolerance) const {
+    TRACE_PORTEE("Glyph::aplatir");
+    auto resultat = std::make_shared<Aplatissement>();
+    resultat->echelle = echelle;
+    resultat->tolerance = tolerance;
+    std::vector<Point>& sommets = resultat->sommets;
+    std::vector<size_t>& contours = resultat->contours;
+    resultat->boitesCourbes.reserve(nbCourbes);
+
+    std::vector<Point> controles;
+    const Point* finPrecedente = nullptr;
+    for (size_t c = 0; c < nbCourbes; ++c) {
+        const Point* curve = points + courbes[c].debut;
+        const int nbPoints = courbes[c].degre + 1;
+        bool enchainee = finPrecedente != nullptr
+            && curve[0].getX() == finPrecedente->getX()
+            && curve[0].getY() == finPrecedente->getY();
+        if (enchainee) {
+            sommets.pop_back(); // Le premier sommet de la courbe remplace le dernier du contour
+        } else {
+            contours.push_back(sommets.size());
+        }
+
+        controles.clear();
+        for (int i = 0; i < nbPoints; ++i) {
+            controles.emplace_back(curve[i].getX() * echelle, curve[i].getY() * echelle);
+        }
+        const size_t debut = sommets.size();
+        BezierCourbe::aplatir(controles.data(), static_cast<int>(controles.size()), tolerance, sommets);
+
+        BoiteEnglobante boite{sommets[debut].getX(), sommets[debut].getY(), sommets[debut].getX(), sommets[debut].getY()};
+        for (size_t i = debut + 1; i < sommets.size(); ++i) {
+            boite.minX = std::min(boite.minX, sommets[i].getX());
+            boite.minY = std::min(boite.minY, sommets[i].getY());
+            boite.maxX = std::max(boite.maxX, sommets[i].getX());
+            boite.maxY = std::max(boite.maxY, sommets[i].getY());
+        }
+        resultat->boitesCourbes.push_back(boite);
+        finPrecedente = curve + nbPoints - 1;
+    }
+    contours.push_back(sommets.size());
+
+    if (!resultat->boitesCourbes.empty()) {
+        BoiteEnglobante& boite = resultat->boite;
+        boite = resultat->boitesCourbes.front();
+        for (const auto& boiteCourbe : resultat->boitesCourbes) {
+            boite.minX = std::min(boite.minX, boiteCourbe.minX);
+            boite.minY = std::min(boite.minY, boiteCourbe.minY);
+            boite.maxX = std::max(boite.maxX, boiteCourbe.maxX);
+            boite.maxY = std::max(boite.maxY, boiteCourbe.maxY);
+        }
+    }
+    resultat->remplisseur.construire(sommets.data(), contours.data(), contours.size() - 1);
+    return resultat;
+}
+
+/**
+ * @brief Retourne l'aplatissement courant, en le calculant au besoin.
+ * 
+ * @return L'aplatissement des courbes du glyphe.
+ */
+const Glyph::Aplatissement& Glyph::getAplatissement() const {
+    for (size_t i = 0; i < cache.size(); ++i) {
+        if (cache[i]->echelle == echelle && cache[i]->tolerance == tolerance) {
+            std::rotate(cache.begin(), cache.begin() + i, cache.begin() + i + 1); // Remonter l'entrée en tête
+            return *cache.front();
+        }
+    }
+    if (cache.size() >= CAPACITE_CACHE) {
+        cache.pop_back(); // Évincer l'entrée la moins récemment utilisée
+    }
+    cache.insert(cache.begin(), aplatir(echelle, tolerance));
+    return *cache.front();
+}
+
+/**
+ * @brief Mémoire occupée par le cache d'aplatissements.
+ * 
+ * @return Le nombre d'octets alloués.
+ */
+size_t Glyph::getMemoireCache() const {
+    size_t memoire = cache.capacity() * sizeof(cache[0]);
+    for (const auto& entree : cache) {
+        memoire += entree->getMemoire();
+    }
+    return memoire;
+}
+
+/**
+ * @brief Estime la mémoire occupée par un aplatissement.
+ * 
+ * @return Le nombre d'octets alloués.
+ */
+size_t Glyph::Aplatissement::getMemoire() const {
+    return sizeof(*this)
+        + sommets.capacity() * sizeof(Point)
+        + contours.capacity() * sizeof(size_t)
+        + boitesCourbes.capacity() * sizeof(BoiteEnglobante)
+        + remplisseur.getAretes().capacity() * sizeof(Arete);
+}
+
+/**
+ * @brief Convertit les contours aplatis en polygones de trait.
+ * 
+ * @param style Paramètres du trait.
+ * @param sommets Vecteur réutilisé recevant les sommets des polygones.
+ * @param contours Vecteur réutilisé recevant les bornes des polygones.
+ */
+void Glyph::contournerTraits(const StyleTrait& style, std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours) const {
+    TRACE_PORTEE("Glyph::contournerTraits");
+    const Aplatissement& aplatissement = getAplatissement();
+    const std::vector<Point>& lignes = aplatissement.sommets;
+    const std::vector<size_t>& bornes = aplatissement.contours;
+
+    sommets.clear();
+    contours.clear();
+    for (size_t c = 0; c + 1 < bornes.size(); ++c) {
+        const Point* debut = lignes.data() + bornes[c];
+        const size_t nb = bornes[c + 1] - bornes[c];
+        const bool ferme = nb > 2 && debut[0].getX() == debut[nb - 1].getX() && debut[0].getY() == debut[nb - 1].getY();
+        Trait::contourner(debut, nb, ferme, style, sommets, contours);
+    }
+    if (contours.empty()) {
+        contours.push_back(0);
+    }
+}
 
 /**
  * @brief Dessine le contour du glyphe dans un bitmap.
  * 
- * Utilise l'algorithme de De Casteljau pour tracer les points des courbes
- * définissant le contour du glyphe.
+ * Relie les sommets de chaque contour aplati par des segments tracés par pas entiers : le travail est
+ * proportionnel à la longueur du contour et non au nombre d'échantillons.
  * 
  * @param bitmap Le bitmap où dessiner le contour.
  */
 void Glyph::drawContour(Bitmap& bitmap) const {
-    for (const auto& curve : this->curves) {
-        auto points = BezierCourbe::deCasteljau(curve, 100);
-        for (const auto& point : points) {
-            bitmap.setPixel(static_cast<int>(point.getX()), static_cast<int>(point.getY()), true);
-        }
+    TRACE_PORTEE("Glyph::drawContour");
+    const Aplatissement& aplatissement = getAplatissement();
+    const std::vector<Point>& sommets = aplatissement.sommets;
+    const std::vector<size_t>& contours = aplatissement.contours;
+    for (size_t c = 0; c + 1 < contours.size(); ++c) {
+        bitmap.drawPolyline(sommets.data() + contours[c], contours[c + 1] - contours[c], true);
     }
 }
 
 /**
  * @brief Remplit l'intérieur du glyphe dans un bitmap.
  * 
- * Utilise un algorithme de parité (scanline) pour remplir l'intérieur du glyphe.
+ * Remplit par balayage à partir de la table des arêtes de l'aplatissement
+ * (construite une seule fois) : seules les arêtes actives de chaque ligne
+ * sont parcourues.
  * 
  * @param bitmap Le bitmap où remplir l'intérieur.
+ * @param regle Règle de remplissage.
+ * @param ressource Ressource fournissant la liste des arêtes actives.
  */
-void Glyph::fillInside(Bitmap& bitmap) const {
-    for (int y = 0; y < bitmap.getHeight(); ++y) {
-        bool inside = false;
-        for (int x = 0; x < bitmap.getWidth(); ++x) {
-            if (bitmap.getPixel(x, y)) {
-                inside = !inside;
-            }
-            if (inside) {
-                bitmap.setPixel(x, y, true);
-            }
-        }
-    }
+void Glyph::fillInside(Bitmap& bitmap, RegleRemplissage regle, std::pmr::memory_resource* ressource) const {
+    getAplatissement().remplisseur.remplir(bitmap, regle, true, ressource);
 }
 
 /**
@@ -54,138 +240,147 @@ void Glyph::fillInside(Bitmap& bitmap) const {
  * Trace un contour rouge autour des courbes définissant le glyphe.
  * 
  * @param bitmap Le bitmap où dessiner le contour rouge.
+ * @param ressource Ressource fournissant les bitmaps de travail.
  */
-void Glyph::drawRedContour(Bitmap& bitmap) const {
-    Bitmap temp(bitmap.getWidth(), bitmap.getHeight());
+void Glyph::drawRedContour(Bitmap& bitmap, std::pmr::memory_resource* ressource) const {
+    Bitmap temp(bitmap.getWidth(), bitmap.getHeight(), PixelFormat::Bit1, ressource);
     drawContour(temp);
-    for (int y = 0; y < bitmap.getHeight(); ++y) {
-        for (int x = 0; x < bitmap.getWidth(); ++x) {
-            if (temp.getPixel(x, y)) {
-                for (int dy = -2; dy <= 2; ++dy) {
-                    for (int dx = -2; dx <= 2; ++dx) {
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx >= 0 && nx < bitmap.getWidth() && ny >= 0 && ny < bitmap.getHeight()) {
-                            bitmap.setPixel(nx, ny, true); // Rouge
-                        }
-                    }
-                }
-            }
-        }
-    }
+    Bitmap masque(bitmap.getWidth(), bitmap.getHeight(), PixelFormat::Bit1, ressource);
+    Morphologie::dilaterCarre(temp, 2, masque);
+    Composition::composer(masque, bitmap, 0, 0, OperateurComposition::CleCouleur, 1);
 }
 
 /**
  * @brief Dessine le glyphe en gras.
  * 
- * Épaissit les contours du glyphe en dessinant plusieurs fois autour des points
- * définissant les courbes.
+ * Convertit les courbes aplaties en polygones de trait puis les remplit par
+ * balayage (enroulement non nul, qui réunit les morceaux du trait).
  * 
  * @param bitmap Le bitmap où dessiner le glyphe.
  * @param thickness L'épaisseur du contour (par défaut : 2).
+ * @param jointure Forme des jonctions du trait.
+ * @param ressource Ressource fournissant la mémoire de travail.
  */
-void Glyph::drawBold(Bitmap& bitmap, int thickness) const {
-    for (const auto& curve : curves) {
-        auto points = BezierCourbe::deCasteljau(curve, 100); // Points sur la courbe
-        for (const auto& point : points) {
-            for (int dx = -thickness; dx <= thickness; ++dx) {
-                for (int dy = -thickness; dy <= thickness; ++dy) {
-                    int x = static_cast<int>(point.getX()) + dx;
-                    int y = static_cast<int>(point.getY()) + dy;
-                    if (x >= 0 && x < bitmap.getWidth() && y >= 0 && y < bitmap.getHeight()) {
-                        bitmap.setPixel(x, y, true); // Noircir le pixel
-                    }
-                }
-            }
-        }
-    }
+void Glyph::drawBold(Bitmap& bitmap, int thickness, Jointure jointure, std::pmr::memory_resource* ressource) const {
+    StyleTrait style;
+    style.largeur = 2.0f * std::max(0, thickness) + 1.0f;
+    style.jointure = jointure;
+
+    std::pmr::vector<Point> sommets(ressource);
+    std::pmr::vector<size_t> contours(ressource);
+    contournerTraits(style, sommets, contours);
+
+    Remplisseur remplisseur(ressource);
+    remplisseur.construire(sommets.data(), contours.data(), contours.size() - 1);
+    remplisseur.remplir(bitmap, RegleRemplissage::NonZero, true, ressource); // Noircir les pixels
 }
 
 /**
  * @brief Dessine le glyphe avec son intérieur rempli.
  * 
- * Remplit l'intérieur du glyphe après avoir dessiné son contour.
+ * Trace le contour puis remplit l'intérieur selon la règle choisie ; les
+ * zones extérieures aux contours (creux d'un 'U', espace entre les jambages
+ * d'un 'H') restent vides. Les glyphes sont des squelettes d'un seul trait,
+ * sans contour intérieur : la panse fermée d'un 'O', 'Q', 'B', 'D' ou 'P'
+ * est donc remplie, aucune règle ne pouvant y laisser un trou.
  * 
  * @param bitmap Le bitmap où dessiner le glyphe rempli.
+ * @param regle Règle de remplissage.
+ * @param ressource Ressource fournissant la mémoire de travail.
  */
-void Glyph::drawFilled(Bitmap& bitmap) const {
+void Glyph::drawFilled(Bitmap& bitmap, RegleRemplissage regle, std::pmr::memory_resource* ressource) const {
     drawContour(bitmap);
+    fillInside(bitmap, regle, ressource);
+}
 
-    int minX = bitmap.getWidth(), maxX = 0;
-    int minY = bitmap.getHeight(), maxY = 0;
+/**
+ * @brief Dessine le glyphe rempli avec anti-crénelage.
+ * 
+ * Deux passes d'accumulation : l'intérieur des contours, puis les polygones
+ * du trait de largeur `largeurTrait`. Ces polygones ont tous la même
+ * orientation, leurs recouvrements s'additionnent donc sans se creuser ; la
+ * seconde passe est combinée à la première par maximum.
+ * 
+ * @param bitmap Le bitmap où dessiner (format Coverage8).
+ * @param largeurTrait Épaisseur des traits en pixels.
+ * @param ressource Ressource fournissant la mémoire de travail.
+ */
+void Glyph::drawAntialiased(Bitmap& bitmap, float largeurTrait, std::pmr::memory_resource* ressource) const {
+    const Aplatissement& aplatissement = getAplatissement();
+    if (aplatissement.sommets.empty()) {
+        return;
+    }
 
-    for (const auto& curve : curves) {
-        auto points = BezierCourbe::deCasteljau(curve, 100);
-        for (const auto& point : points) {
-            int x = static_cast<int>(point.getX());
-            int y = static_cast<int>(point.getY());
-            if (x >= 0 && x < bitmap.getWidth() && y >= 0 && y < bitmap.getHeight()) {
-                minX = std::min(minX, x);
-                maxX = std::max(maxX, x);
-                minY = std::min(minY, y);
-                maxY = std::max(maxY, y);
-            }
-        }
+    // L'accumulation ne couvre que la boîte englobante (élargie du demi-trait), bornée au bitmap
+    const float marge = std::max(0.0f, 0.5f * largeurTrait) + 1.0f;
+    const BoiteEnglobante& boite = aplatissement.boite;
+    const int x0 = std::max(0, static_cast<int>(std::floor(std::max(boite.minX - marge, -1.0f))));
+    const int y0 = std::max(0, static_cast<int>(std::floor(std::max(boite.minY - marge, -1.0f))));
+    const int x1 = std::min(bitmap.getWidth(), static_cast<int>(std::ceil(std::min(boite.maxX + marge, static_cast<float>(bitmap.getWidth())))));
+    const int y1 = std::min(bitmap.getHeight(), static_cast<int>(std::ceil(std::min(boite.maxY + marge, static_cast<float>(bitmap.getHeight())))));
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    const Point origine(static_cast<float>(x0), static_cast<float>(y0));
+    std::pmr::vector<Point> sommets(ressource);
+    sommets.reserve(aplatissement.sommets.size());
+    for (const auto& sommet : aplatissement.sommets) {
+        sommets.emplace_back(sommet.getX() - origine.getX(), sommet.getY() - origine.getY());
     }
+    const std::vector<size_t>& contours = aplatissement.contours;
 
-    for (int y = minY; y <= maxY; ++y) {
-        int left = -1, right = -1;
-        for (int x = minX; x <= maxX; ++x) {
-            if (bitmap.getPixel(x, y)) {
-                if (left == -1) {
-                    left = x;
-                }
-                right = x;
-            }
-        }
-        if (left != -1 && right != -1 && right > left) {
-            for (int x = left; x <= right; ++x) {
-                bitmap.setPixel(x, y, true);
-            }
-        }
+    RasteriseurCouverture rasteriseur(x1 - x0, y1 - y0, ressource);
+    rasteriseur.ajouterContours(sommets.data(), contours.data(), contours.size() - 1);
+    rasteriseur.resoudre(bitmap, x0, y0);
+
+    if (largeurTrait <= 0.0f) {
+        return;
     }
+    StyleTrait style;
+    style.largeur = largeurTrait;
+    std::pmr::vector<Point> traits(ressource);
+    std::pmr::vector<size_t> morceaux(ressource);
+    contournerTraits(style, traits, morceaux);
+    for (auto& sommet : traits) {
+        sommet = Point(sommet.getX() - origine.getX(), sommet.getY() - origine.getY());
+    }
+    rasteriseur.ajouterContours(traits.data(), morceaux.data(), morceaux.size() - 1);
+    rasteriseur.resoudre(bitmap, x0, y0);
 }
 
 /**
  * @brief Dessine le glyphe avec un contour rouge épais.
  * 
  * Ajoute un contour rouge autour des courbes du glyphe et recouvre les bords
- * avec des pixels noirs.
+ * avec des pixels noirs : le rouge est le trait de largeur 2 thickness + 1,
+ * posé uniquement sur les pixels blancs, le noir le trait de largeur
+ * 2 (thickness - 4) + 1.
  * 
  * @param bitmap Le bitmap où dessiner le glyphe.
  * @param thickness L'épaisseur du contour rouge (par défaut : 2).
+ * @param jointure Forme des jonctions du trait.
+ * @param ressource Ressource fournissant la mémoire de travail.
  */
-void Glyph::drawWithRedOutline(Bitmap& bitmap, int thickness) const {
-    for (const auto& curve : curves) {
-        auto points = BezierCourbe::deCasteljau(curve, 100); // Points sur la courbe
-        for (const auto& point : points) {
-            for (int dx = -thickness; dx <= thickness; ++dx) {
-                for (int dy = -thickness; dy <= thickness; ++dy) {
-                    int x = static_cast<int>(point.getX()) + dx;
-                    int y = static_cast<int>(point.getY()) + dy;
-
-                    if (x >= 0 && x < bitmap.getWidth() && y >= 0 && y < bitmap.getHeight()) {
-                        if (bitmap.getPixel(x, y) == 0) {
-                            bitmap.setPixel(x, y, 2); // Rouge
-                        }
-                    }
-                }
-            }
-        }
-    }
+void Glyph::drawWithRedOutline(Bitmap& bitmap, int thickness, Jointure jointure, std::pmr::memory_resource* ressource) const {
+    StyleTrait style;
+    style.jointure = jointure;
+    std::pmr::vector<Point> sommets(ressource);
+    std::pmr::vector<size_t> contours(ressource);
+    Remplisseur remplisseur(ressource);
 
-    for (const auto& curve : curves) {
-        auto points = BezierCourbe::deCasteljau(curve, 100);
-        for (const auto& point : points) {
-            for (int dx = -(thickness - 4); dx <= (thickness - 4); ++dx) {
-                for (int dy = -(thickness - 4); dy <= (thickness - 4); ++dy) {
-                    int x = static_cast<int>(point.getX()) + dx;
-                    int y = static_cast<int>(point.getY()) + dy;
-                    if (x >= 0 && x < bitmap.getWidth() && y >= 0 && y < bitmap.getHeight()) {
-                        bitmap.setPixel(x, y, true); // Noircir le pixel
-                    }
-                }
-            }
-        }
+    if (thickness >= 0) {
+        style.largeur = 2.0f * thickness + 1.0f;
+        contournerTraits(style, sommets, contours);
+        remplisseur.construire(sommets.data(), contours.data(), contours.size() - 1);
+
+        Bitmap masque(bitmap.getWidth(), bitmap.getHeight(), PixelFormat::Bit1, ressource);
+        remplisseur.remplir(masque, RegleRemplissage::NonZero, true, ressource);
+        Composition::composer(masque, bitmap, 0, 0, OperateurComposition::Sous, 2); // Rouge, sur les pixels blancs seulement
+    }
+    if (thickness - 4 >= 0) {
+        style.largeur = 2.0f * (thickness - 4) + 1.0f;
+        contournerTraits(style, sommets, contours);
+        remplisseur.construire(sommets.data(), contours.data(), contours.size() - 1);
+        remplisseur.remplir(bitmap, RegleRemplissage::NonZero, true, ressource); // Noircir les pixels
     }
 }
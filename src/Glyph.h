@@ -2,18 +2,70 @@
 #define GLYPH_H
 
 #include "Bitmap.h"
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include "BezierCourbe.h"
 #include "Point.h"
+#include "Remplissage.h"
+#include "Trait.h"
+
+/**
+ * @brief Boîte englobante alignée sur les axes.
+ */
+struct BoiteEnglobante {
+    float minX = 0.0f;  ///< Abscisse minimale.
+    float minY = 0.0f;  ///< Ordonnée minimale.
+    float maxX = 0.0f;  ///< Abscisse maximale.
+    float maxY = 0.0f;  ///< Ordonnée maximale.
+};
+
+/**
+ * @brief Courbe d'un glyphe, repérée dans un tableau de points de contrôle.
+ */
+struct CourbeGlyphe {
+    uint32_t debut;  ///< Indice du premier point de contrôle de la courbe.
+    uint8_t degre;   ///< Degré de la courbe (nombre de points de contrôle moins un).
+};
 
 /**
  * @brief Classe représentant un glyphe (caractère) composé de courbes de Bézier.
  * 
  * Permet de dessiner, remplir, ou appliquer différents styles (gras, contour rouge)
  * sur un glyphe dans un bitmap.
+ * 
+ * Les courbes ne sont aplaties qu'une fois par couple (échelle, tolérance) :
+ * le résultat est conservé dans un petit cache LRU partagé par toutes les
+ * méthodes de dessin. Ce cache n'est pas protégé contre les accès
+ * concurrents ; un même glyphe ne doit pas être dessiné depuis plusieurs
+ * threads à la fois.
  */
 class Glyph {
 public:
+    /**
+     * @brief Courbes du glyphe aplaties pour une échelle et une tolérance données.
+     * 
+     * Le contour i occupe les sommets [contours[i], contours[i + 1]) ; la
+     * courbe j a pour boîte englobante boitesCourbes[j].
+     */
+    struct Aplatissement {
+        float echelle = 1.0f;                        ///< Échelle appliquée aux points de contrôle.
+        float tolerance = 0.0f;                      ///< Tolérance d'aplatissement (en pixels).
+        std::vector<Point> sommets;                  ///< Sommets de tous les contours.
+        std::vector<size_t> contours;                ///< Indices de début des contours, plus l'indice de fin.
+        std::vector<BoiteEnglobante> boitesCourbes;  ///< Boîte englobante de chaque courbe aplatie.
+        BoiteEnglobante boite;                       ///< Boîte englobante du glyphe entier.
+        Remplisseur remplisseur;                     ///< Table des arêtes des contours.
+
+        /**
+         * @brief Estime la mémoire occupée par l'aplatissement.
+         * 
+         * @return Le nombre d'octets alloués (capacités des vecteurs comprises).
+         */
+        size_t getMemoire() const;
+    };
+
     /**
      * @brief Constructeur par défaut pour un glyphe vide.
      */
@@ -22,14 +74,70 @@ public:
     /**
      * @brief Constructeur initialisant le glyphe avec des courbes.
      * 
+     * Les points sont copiés une fois dans un tableau contigu, partagé par
+     * les copies du glyphe. Les courbes vides sont ignorées.
+     * 
      * @param curves Un vecteur de vecteurs de points représentant les courbes de Bézier.
+     * 
+     * @throws std::invalid_argument Si une courbe a plus de 256 points de contrôle.
      */
     Glyph(const std::vector<std::vector<Point>>& curves);
 
+    /**
+     * @brief Constructeur référençant des courbes sans les copier.
+     * 
+     * Le glyphe ne garde que les pointeurs : les tableaux (typiquement une
+     * table constante du programme) doivent lui survivre.
+     * 
+     * @param points Tableau des points de contrôle.
+     * @param courbes Courbes du glyphe, dont les indices désignent des éléments de `points`.
+     * @param nbCourbes Nombre de courbes.
+     */
+    Glyph(const Point* points, const CourbeGlyphe* courbes, size_t nbCourbes);
+
+    /**
+     * @brief Change l'échelle appliquée aux points de contrôle avant le dessin.
+     * 
+     * @param echelle Facteur multiplicatif (1 : coordonnées d'origine).
+     * 
+     * @throws std::invalid_argument Si l'échelle n'est pas strictement positive.
+     */
+    void setEchelle(float echelle);
+
+    /**
+     * @brief Change la tolérance d'aplatissement des courbes.
+     * 
+     * @param tolerance Écart maximal en pixels entre une courbe et ses segments.
+     * 
+     * @throws std::invalid_argument Si la tolérance n'est pas strictement positive.
+     */
+    void setTolerance(float tolerance);
+
+    /**
+     * @brief Retourne l'aplatissement correspondant à l'échelle et à la tolérance courantes.
+     * 
+     * Le calcul n'a lieu qu'au premier appel pour un couple donné ; les
+     * appels suivants renvoient l'entrée du cache. La référence reste valide
+     * tant que le glyphe n'est ni modifié ni détruit et que moins de
+     * CAPACITE_CACHE autres couples ont été demandés depuis.
+     * 
+     * @return L'aplatissement des courbes du glyphe.
+     */
+    const Aplatissement& getAplatissement() const;
+
+    /**
+     * @brief Mémoire occupée par le cache d'aplatissements.
+     * 
+     * @return Le nombre d'octets alloués par les entrées du cache.
+     */
+    size_t getMemoireCache() const;
+
     /**
      * @brief Dessine le contour du glyphe.
      * 
-     * Trace les courbes de Bézier définissant le contour du glyphe dans le bitmap.
+     * Trace les courbes de Bézier définissant le contour du glyphe dans le bitmap :
+     * chaque courbe est aplatie puis ses segments sont tracés pixel par pixel,
+     * ce qui donne un contour continu quelle que soit la taille.
      * 
      * @param bitmap Le bitmap où dessiner le contour.
      */
@@ -38,11 +146,15 @@ public:
     /**
      * @brief Remplit l'intérieur du glyphe.
      * 
-     * Utilise un algorithme pour remplir les pixels à l'intérieur des contours du glyphe.
+     * Les contours aplatis du glyphe (fermés implicitement) sont remplis par
+     * balayage avec une table d'arêtes actives, selon la règle choisie.
      * 
      * @param bitmap Le bitmap où remplir l'intérieur du glyphe.
+     * @param regle Règle de remplissage (par défaut : enroulement non nul).
+     * @param ressource Ressource fournissant la mémoire de travail.
      */
-    void fillInside(Bitmap& bitmap) const;
+    void fillInside(Bitmap& bitmap, RegleRemplissage regle = RegleRemplissage::NonZero,
+                    std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
 
     /**
      * @brief Dessine le contour du glyphe en rouge.
@@ -50,40 +162,118 @@ public:
      * Trace les courbes de Bézier définissant le contour en utilisant la couleur rouge.
      * 
      * @param bitmap Le bitmap où dessiner le contour rouge.
+     * @param ressource Ressource fournissant les bitmaps de travail.
      */
-    void drawRedContour(Bitmap& bitmap) const;
+    void drawRedContour(Bitmap& bitmap, std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
 
     /**
      * @brief Dessine le glyphe rempli (contour + intérieur).
      * 
      * Combine le contour et le remplissage pour dessiner un glyphe complet.
+     * Les glyphes n'ayant pas de contour intérieur, les panses fermées ('O',
+     * 'Q', 'B', 'D', 'P') sont remplies elles aussi.
      * 
      * @param bitmap Le bitmap où dessiner le glyphe rempli.
+     * @param regle Règle de remplissage (par défaut : enroulement non nul).
+     * @param ressource Ressource fournissant la mémoire de travail.
+     */
+    void drawFilled(Bitmap& bitmap, RegleRemplissage regle = RegleRemplissage::NonZero,
+                    std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Dessine le glyphe rempli avec anti-crénelage.
+     * 
+     * L'intérieur des contours et les traits (d'épaisseur `largeurTrait`) sont
+     * rastérisés par accumulation d'aires signées : chaque pixel reçoit sa
+     * couverture exacte, de 0 à 255, sans suréchantillonnage.
+     * 
+     * @param bitmap Le bitmap où dessiner (format Coverage8).
+     * @param largeurTrait Épaisseur des traits en pixels (0 : intérieur seul).
+     * @param ressource Ressource fournissant la mémoire de travail.
+     * 
+     * @throws std::invalid_argument Si le bitmap n'est pas au format Coverage8.
      */
-    void drawFilled(Bitmap& bitmap) const;
+    void drawAntialiased(Bitmap& bitmap, float largeurTrait = 1.0f, std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
 
     /**
      * @brief Dessine le glyphe avec un effet de gras.
      * 
-     * Ajoute de l'épaisseur au contour du glyphe pour produire un effet gras.
+     * Ajoute de l'épaisseur au contour du glyphe pour produire un effet gras :
+     * chaque courbe aplatie est convertie en polygones de trait de largeur
+     * 2 thickness + 1, remplis par balayage (coût proportionnel au périmètre).
      * 
      * @param bitmap Le bitmap où dessiner le glyphe.
      * @param thickness L'épaisseur du contour (valeur par défaut : 2).
+     * @param jointure Forme des jonctions du trait (valeur par défaut : arrondie).
+     * @param ressource Ressource fournissant la mémoire de travail (polygones du trait, arêtes).
      */
-    void drawBold(Bitmap& bitmap, int thickness = 2) const;
+    void drawBold(Bitmap& bitmap, int thickness = 2, Jointure jointure = Jointure::Arrondie,
+                  std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
 
     /**
      * @brief Dessine le glyphe avec un contour rouge et un effet d'épaisseur.
      * 
-     * Trace un contour rouge épais autour des courbes du glyphe.
+     * Trace un contour rouge épais autour des courbes du glyphe, comme trait
+     * polygonal de largeur 2 thickness + 1.
      * 
      * @param bitmap Le bitmap où dessiner le glyphe.
      * @param thickness L'épaisseur du contour rouge (valeur par défaut : 2).
+     * @param jointure Forme des jonctions du trait (valeur par défaut : arrondie).
+     * @param ressource Ressource fournissant la mémoire de travail (polygones du trait, arêtes, masque).
      */
-    void drawWithRedOutline(Bitmap& bitmap, int thickness = 2) const;
+    void drawWithRedOutline(Bitmap& bitmap, int thickness = 2, Jointure jointure = Jointure::Arrondie,
+                            std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
+
+    /// Écart maximal toléré par défaut entre une courbe et son aplatissement (en pixels).
+    static constexpr float TOLERANCE_APLATISSEMENT = 0.25f;
+
+    /// Nombre maximal d'aplatissements conservés par glyphe.
+    static constexpr size_t CAPACITE_CACHE = 4;
 
 private:
-    std::vector<std::vector<Point>> curves; ///< Les courbes de Bézier définissant le glyphe.
+    /**
+     * @brief Aplatit toutes les courbes du glyphe en contours.
+     * 
+     * Les courbes consécutives dont l'une commence là où la précédente se
+     * termine sont enchaînées dans un même contour, sans dupliquer le sommet
+     * commun. Les boîtes englobantes et la table des arêtes sont calculées
+     * dans la foulée.
+     * 
+     * @param echelle Échelle appliquée aux points de contrôle.
+     * @param tolerance Tolérance d'aplatissement.
+     * @return Le nouvel aplatissement.
+     */
+    std::shared_ptr<const Aplatissement> aplatir(float echelle, float tolerance) const;
+
+    /**
+     * @brief Convertit les contours aplatis du glyphe en polygones de trait.
+     * 
+     * Un contour dont le dernier sommet rejoint le premier est traité comme
+     * fermé. Le résultat est au même format que aplatir().
+     * 
+     * @param style Paramètres du trait.
+     * @param sommets Vecteur réutilisé recevant les sommets des polygones.
+     * @param contours Vecteur réutilisé recevant les bornes des polygones.
+     */
+    void contournerTraits(const StyleTrait& style, std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours) const;
+
+    /**
+     * @brief Copie des courbes d'un glyphe construit à partir de vecteurs.
+     */
+    struct Stockage {
+        std::vector<Point> points;          ///< Points de contrôle de toutes les courbes.
+        std::vector<CourbeGlyphe> courbes;  ///< Courbes, indexées dans `points`.
+    };
+
+    const Point* points = nullptr;          ///< Points de contrôle des courbes.
+    const CourbeGlyphe* courbes = nullptr;  ///< Courbes de Bézier définissant le glyphe.
+    size_t nbCourbes = 0;                   ///< Nombre de courbes.
+    std::shared_ptr<const Stockage> stockage; ///< Propriétaire des tableaux, s'ils ne sont pas externes.
+    float echelle = 1.0f;                             ///< Échelle courante.
+    float tolerance = TOLERANCE_APLATISSEMENT;        ///< Tolérance d'aplatissement courante.
+
+    /// Aplatissements récents, le plus récemment utilisé en tête.
+    mutable std::vector<std::shared_ptr<const Aplatissement>> cache;
 };
 
 #endif // GLYPH_H
@@ -1,472 +1,200 @@
 #include "GlyphGenerator.h"
+#include "Trace.h"
+#include <cstddef>
 #include <iostream>
 
+/**
+ * @brief Courbe telle qu'écrite dans la description des lettres.
+ */
+struct CourbeSource {
+    char lettre;      ///< Lettre à laquelle appartient la courbe.
+    uint8_t degre;    ///< Degré de la courbe (1 : segment, 2 : quadratique, 3 : cubique).
+    Point points[4];  ///< Points de contrôle (les degre + 1 premiers sont utilisés).
+};
+
+/// Courbes des lettres A à Z, groupées par lettre et dans l'ordre alphabétique.
+static constexpr CourbeSource COURBES_SOURCE[] = {
+    {'A', 1, {Point(100, 500), Point(300, 100)}},
+    {'A', 1, {Point(300, 100), Point(500, 500)}},
+    {'A', 1, {Point(200, 300), Point(400, 300)}},
+
+    {'B', 1, {Point(100, 100), Point(100, 500)}},
+    {'B', 2, {Point(100, 100), Point(300, 200), Point(100, 300)}},  // Top semi-circle
+    {'B', 2, {Point(100, 300), Point(300, 400), Point(100, 500)}},  // Bottom semi-circle
+
+    {'C', 2, {Point(300, 100), Point(50, 225), Point(300, 350)}},
+
+    {'D', 1, {Point(100, 100), Point(100, 500)}},
+    {'D', 2, {Point(100, 100), Point(400, 300), Point(100, 500)}},
+
+    {'E', 1, {Point(100, 100), Point(100, 500)}},
+    {'E', 1, {Point(100, 100), Point(400, 100)}},
+    {'E', 1, {Point(100, 300), Point(300, 300)}},
+    {'E', 1, {Point(100, 500), Point(400, 500)}},
+
+    {'F', 1, {Point(100, 100), Point(100, 500)}},
+    {'F', 1, {Point(100, 100), Point(400, 100)}},
+    {'F', 1, {Point(100, 300), Point(300, 300)}},
+
+    {'G', 3, {Point(300, 300), Point(500, 433), Point(433, 500), Point(300, 500)}},  // Semi-circle from middle to bottom-right
+    {'G', 3, {Point(300, 500), Point(167, 500), Point(100, 433), Point(100, 300)}},  // Semi-circle from bottom-right to middle-left
+    {'G', 3, {Point(100, 300), Point(100, 167), Point(167, 100), Point(300, 100)}},  // Semi-circle from middle-left to top
+    {'G', 1, {Point(250, 300), Point(350, 300)}},  // Horizontal line for the "G" opening
+
+    {'H', 1, {Point(100, 100), Point(100, 500)}},  // Left vertical line
+    {'H', 1, {Point(400, 100), Point(400, 500)}},  // Right vertical line
+    {'H', 1, {Point(100, 300), Point(400, 300)}},  // Horizontal bar in the middle
+
+    {'I', 1, {Point(250, 300), Point(250, 500)}},  // Vertical line in the center
+    {'I', 1, {Point(200, 300), Point(300, 300)}},  // Optional: Top bar
+    {'I', 1, {Point(200, 500), Point(300, 500)}},  // Optional: Bottom bar
+
+    {'J', 1, {Point(400, 100), Point(400, 400)}},  // Vertical line on the right
+    {'J', 2, {Point(400, 400), Point(300, 500), Point(200, 400)}},  // Semi-circle at the bottom
+    {'J', 1, {Point(350, 100), Point(450, 100)}},  // Optional: Top bar
+
+    {'K', 1, {Point(100, 100), Point(100, 500)}},
+    {'K', 1, {Point(100, 300), Point(200, 100)}},
+    {'K', 1, {Point(100, 300), Point(200, 500)}},
+
+    {'L', 1, {Point(100, 100), Point(100, 500)}},  // Vertical line on the left
+    {'L', 1, {Point(100, 500), Point(400, 500)}},  // Horizontal line at the bottom
+
+    {'M', 1, {Point(100, 100), Point(100, 500)}},  // Left vertical line
+    {'M', 1, {Point(400, 100), Point(400, 500)}},  // Right vertical line
+    {'M', 1, {Point(100, 100), Point(250, 300)}},  // Left diagonal
+    {'M', 1, {Point(250, 300), Point(400, 100)}},  // Right diagonal
+
+    {'N', 1, {Point(100, 100), Point(100, 500)}},  // Left vertical line
+    {'N', 1, {Point(400, 100), Point(400, 500)}},  // Right vertical line
+    {'N', 1, {Point(100, 100), Point(400, 500)}},  // Diagonal line
+
+    {'O', 3, {Point(300, 100), Point(433, 100), Point(500, 167), Point(500, 300)}},  // Quadrant 1: Top-Right
+    {'O', 3, {Point(500, 300), Point(500, 433), Point(433, 500), Point(300, 500)}},  // Quadrant 2: Bottom-Right
+    {'O', 3, {Point(300, 500), Point(167, 500), Point(100, 433), Point(100, 300)}},  // Quadrant 3: Bottom-Left
+    {'O', 3, {Point(100, 300), Point(100, 167), Point(167, 100), Point(300, 100)}},  // Quadrant 4: Top-Left
+
+    {'P', 1, {Point(100, 100), Point(100, 500)}},  // Vertical line on the left
+    {'P', 2, {Point(100, 100), Point(300, 200), Point(100, 300)}},  // Semi-circle for the top curve
+
+    {'Q', 3, {Point(300, 100), Point(433, 100), Point(500, 167), Point(500, 300)}},  // Top-right quadrant of the circle
+    {'Q', 3, {Point(500, 300), Point(500, 433), Point(433, 500), Point(300, 500)}},  // Bottom-right quadrant of the circle
+    {'Q', 3, {Point(300, 500), Point(167, 500), Point(100, 433), Point(100, 300)}},  // Bottom-left quadrant of the circle
+    {'Q', 3, {Point(100, 300), Point(100, 167), Point(167, 100), Point(300, 100)}},  // Top-left quadrant of the circle
+    {'Q', 1, {Point(400, 400), Point(500, 500)}},  // Diagonal tail
+
+    {'R', 1, {Point(100, 100), Point(100, 500)}},  // Vertical line on the left
+    {'R', 2, {Point(100, 100), Point(300, 200), Point(100, 300)}},  // Semi-circle for the top curve
+    {'R', 1, {Point(100, 300), Point(400, 500)}},  // Diagonal line
+
+    {'S', 2, {Point(300, 100), Point(100, 200), Point(300, 300)}},  // Top semi-circle
+    {'S', 2, {Point(300, 300), Point(500, 400), Point(300, 500)}},  // Bottom semi-circle
+
+    {'T', 1, {Point(250, 100), Point(250, 500)}},  // Vertical line in the center
+    {'T', 1, {Point(150, 100), Point(350, 100)}},  // Horizontal line at the top
+
+    {'U', 1, {Point(100, 100), Point(100, 500)}},  // Left vertical line
+    {'U', 1, {Point(400, 100), Point(400, 500)}},  // Right vertical line
+    {'U', 2, {Point(100, 500), Point(250, 550), Point(400, 500)}},  // Bottom curve
+
+    {'V', 1, {Point(100, 100), Point(250, 500)}},  // Left diagonal
+    {'V', 1, {Point(250, 500), Point(400, 100)}},  // Right diagonal
+
+    {'W', 1, {Point(100, 100), Point(100, 500)}},  // Left vertical line
+    {'W', 1, {Point(100, 500), Point(250, 300)}},  // Left diagonal
+    {'W', 1, {Point(250, 300), Point(400, 500)}},  // Right diagonal
+    {'W', 1, {Point(400, 500), Point(400, 100)}},  // Right vertical line
+
+    {'X', 1, {Point(100, 100), Point(400, 500)}},  // Left diagonal
+    {'X', 1, {Point(400, 100), Point(100, 500)}},  // Right diagonal
+
+    {'Y', 1, {Point(100, 100), Point(250, 300)}},  // Left diagonal
+    {'Y', 1, {Point(400, 100), Point(250, 300)}},  // Right diagonal
+    {'Y', 1, {Point(250, 300), Point(250, 500)}},  // Vertical line
+
+    {'Z', 1, {Point(100, 100), Point(400, 100)}},  // Top horizontal line
+    {'Z', 1, {Point(400, 100), Point(100, 500)}},  // Diagonal line
+    {'Z', 1, {Point(100, 500), Point(400, 500)}},  // Bottom horizontal line
+};
+
+static constexpr size_t NB_COURBES = sizeof(COURBES_SOURCE) / sizeof(COURBES_SOURCE[0]);
+static constexpr int NB_LETTRES = 'Z' - 'A' + 1;
+
+/**
+ * @brief Compte les points de contrôle de toutes les courbes.
+ * 
+ * @return La somme des degre + 1.
+ */
+static constexpr size_t compterPoints() {
+    size_t total = 0;
+    for (const auto& courbe : COURBES_SOURCE) {
+        total += courbe.degre + 1;
+    }
+    return total;
+}
+
+static constexpr size_t NB_POINTS = compterPoints();
+
+/**
+ * @brief Plage des courbes d'une lettre dans la table.
+ */
+struct PlageGlyphe {
+    uint16_t premiereCourbe;  ///< Indice de la première courbe.
+    uint16_t nbCourbes;       ///< Nombre de courbes.
+};
+
+/**
+ * @brief Table compacte des glyphes : points de contrôle contigus, courbes et plages par lettre.
+ */
+struct TableGlyphes {
+    Point points[NB_POINTS];            ///< Points de contrôle de toutes les courbes, sans trou.
+    CourbeGlyphe courbes[NB_COURBES];   ///< Courbes, indexées dans `points`.
+    PlageGlyphe plages[NB_LETTRES];     ///< Courbes de chaque lettre, indexées par lettre - 'A'.
+};
+
+/**
+ * @brief Compacte COURBES_SOURCE en une TableGlyphes, à la compilation.
+ * 
+ * @return La table construite.
+ */
+static constexpr TableGlyphes construireTable() {
+    TableGlyphes table{};
+    size_t nbPoints = 0;
+    for (size_t c = 0; c < NB_COURBES; ++c) {
+        const CourbeSource& source = COURBES_SOURCE[c];
+        table.courbes[c] = CourbeGlyphe{static_cast<uint32_t>(nbPoints), source.degre};
+        for (int i = 0; i <= source.degre; ++i) {
+            table.points[nbPoints++] = source.points[i];
+        }
+        PlageGlyphe& plage = table.plages[source.lettre - 'A'];
+        if (plage.nbCourbes == 0) {
+            plage.premiereCourbe = static_cast<uint16_t>(c);
+        }
+        ++plage.nbCourbes;
+    }
+    return table;
+}
+
+/// Table des glyphes, calculée à la compilation et placée en lecture seule.
+static constexpr TableGlyphes TABLE_GLYPHES = construireTable();
+
 /**
  * @brief Génère un glyphe basé sur une lettre donnée.
  * 
- * Cette fonction crée un glyphe correspondant à la lettre spécifiée
- * en utilisant des courbes de Bézier pour définir sa forme.
+ * Le glyphe référence directement la table constante des lettres : la
+ * recherche se limite à un accès indexé, sans allocation ni copie.
  * Si la lettre n'est pas supportée, un glyphe vide est retourné.
  * 
  * @param letter La lettre (en majuscule) pour laquelle générer le glyphe.
  * @return Glyph Le glyphe généré correspondant à la lettre.
  */
-
-
 Glyph generateGlyph(char letter) {
-    std::vector<std::vector<Point>> curves;
-    switch (letter) {
-    case 'A':
-        curves.push_back({Point(100, 500), Point(300, 100)});
-        curves.push_back({Point(300, 100), Point(500, 500)});
-        curves.push_back({Point(200, 300), Point(400, 300)});
-        break;
-
-    case 'B':
-        curves.push_back({
-            Point(100, 100),  
-            Point(100, 500)  
-        });
-
-        // Top semi-circle
-        curves.push_back({
-            Point(100, 100),  
-            Point(300, 200),  
-            Point(100, 300)   
-        });
-
-        // Bottom semi-circle
-        curves.push_back({
-            Point(100, 300),
-            Point(300, 400), 
-            Point(100, 500)  
-        });
-        break;
-
-    case 'C':
-        curves.push_back({Point(300, 100), Point(50, 225), Point(300, 350)});
-        break;
-
-    case 'D':
-        curves.push_back({
-            Point(100, 100),
-            Point(100, 500)  
-        });
-
-        curves.push_back({
-            Point(100, 100),  
-            Point(400, 300),  
-            Point(100, 500)  
-        });
-        break;
-
-
-    case 'E':
-        curves.push_back({
-            Point(100, 100), 
-            Point(100, 500)
-        });
-
-        curves.push_back({
-            Point(100, 100), 
-            Point(400, 100) 
-        });
-
-        curves.push_back({
-            Point(100, 300),  
-            Point(300, 300)  
-        });
-
-        curves.push_back({
-            Point(100, 500),  
-            Point(400, 500)  
-        });
-        break;
-
-
-    case 'F':
-
-        curves.push_back({
-            Point(100, 100),  
-            Point(100, 500)   
-        });
-
-        curves.push_back({
-            Point(100, 100),
-            Point(400, 100) 
-        });
-
-
-        curves.push_back({
-            Point(100, 300), 
-            Point(300, 300) 
-        });
-        break;
-
-
-    
-    case 'G': 
-        // Semi-circle from middle to bottom-right
-        curves.push_back({
-            Point(300, 300),  // P0: Start point
-            Point(500, 433),  // P1: Control point 1
-            Point(433, 500),  // P2: Control point 2
-            Point(300, 500)   // P3: End point
-        });
-
-        // Semi-circle from bottom-right to middle-left
-        curves.push_back({
-            Point(300, 500),  // P0: Start point
-            Point(167, 500),  // P1: Control point 1
-            Point(100, 433),  // P2: Control point 2
-            Point(100, 300)   // P3: End point
-        });
-
-        // Semi-circle from middle-left to top
-        curves.push_back({
-            Point(100, 300),  // P0: Start point
-            Point(100, 167),  // P1: Control point 1
-            Point(167, 100),  // P2: Control point 2
-            Point(300, 100)   // P3: End point
-        });
-
-        // Horizontal line for the "G" opening
-        curves.push_back({
-            Point(250, 300),  // Start of the horizontal line
-            Point(350, 300)   // End of the horizontal line
-        });
-
-        break;
-
-    case 'H':
-        // Left vertical line
-        curves.push_back({
-            Point(100, 100),  // Start of the left vertical line (top-left)
-            Point(100, 500)   // End of the left vertical line (bottom-left)
-        });
-
-        // Right vertical line
-        curves.push_back({
-            Point(400, 100),  // Start of the right vertical line (top-right)
-            Point(400, 500)   // End of the right vertical line (bottom-right)
-        });
-
-        // Horizontal bar in the middle
-        curves.push_back({
-            Point(100, 300),  // Start of the horizontal bar (middle-left)
-            Point(400, 300)   // End of the horizontal bar (middle-right)
-        });
-        break;
-
-
-    case 'I':
-        // Vertical line in the center
-        curves.push_back({
-            Point(250, 300),  // Start of the vertical line (top-center)
-            Point(250, 500)   // End of the vertical line (bottom-center)
-        });
-
-        // Optional: Top bar
-        curves.push_back({
-            Point(200, 300),  // Start of the top bar (top-left)
-            Point(300, 300)   // End of the top bar (top-right)
-        });
-
-        // Optional: Bottom bar
-        curves.push_back({
-            Point(200, 500),  // Start of the bottom bar (bottom-left)
-            Point(300, 500)   // End of the bottom bar (bottom-right)
-        });
-        break;
-
-
-    case 'J':
-        // Vertical line on the right
-        curves.push_back({
-            Point(400, 100),  // Start of the vertical line (top-right)
-            Point(400, 400)   // End of the vertical line (near bottom-right)
-        });
-
-        // Semi-circle at the bottom
-        curves.push_back({
-            Point(400, 400),  // Start of the semi-circle (bottom-right)
-            Point(300, 500),  // Control point (center-bottom, bulging outward)
-            Point(200, 400)   // End of the semi-circle (bottom-left)
-        });
-
-        // Optional: Top bar
-        curves.push_back({
-            Point(350, 100),  // Start of the top bar (top-left)
-            Point(450, 100)   // End of the top bar (top-right)
-        });
-        break;
-
-
-    case 'K':
-        curves.push_back({Point(100, 100), Point(100, 500)});
-        curves.push_back({Point(100, 300), Point(200, 100)});
-        curves.push_back({Point(100, 300), Point(200, 500)});
-        break;
-
-
-    case 'L':
-        // Vertical line on the left
-        curves.push_back({
-            Point(100, 100),  // Start of the vertical line (top-left)
-            Point(100, 500)   // End of the vertical line (bottom-left)
-        });
-
-        // Horizontal line at the bottom
-        curves.push_back({
-            Point(100, 500),  // Start of the horizontal line (bottom-left)
-            Point(400, 500)   // End of the horizontal line (bottom-right)
-        });
-        break;
-
-
-    case 'M':
-        // Left vertical line
-        curves.push_back({
-            Point(100, 100),  // Start of the left vertical line (top-left)
-            Point(100, 500)   // End of the left vertical line (bottom-left)
-        });
-
-        // Right vertical line
-        curves.push_back({
-            Point(400, 100),  // Start of the right vertical line (top-right)
-            Point(400, 500)   // End of the right vertical line (bottom-right)
-        });
-
-        // Left diagonal
-        curves.push_back({
-            Point(100, 100),  // Start of the left diagonal (top-left)
-            Point(250, 300)   // End of the left diagonal (middle peak)
-        });
-
-        // Right diagonal
-        curves.push_back({
-            Point(250, 300),  // Start of the right diagonal (middle peak)
-            Point(400, 100)   // End of the right diagonal (top-right)
-        });
-        break;
-
-
-    case 'N':
-        // Left vertical line
-        curves.push_back({
-            Point(100, 100),  // Start of the left vertical line (top-left)
-            Point(100, 500)   // End of the left vertical line (bottom-left)
-        });
-
-        // Right vertical line
-        curves.push_back({
-            Point(400, 100),  // Start of the right vertical line (top-right)
-            Point(400, 500)   // End of the right vertical line (bottom-right)
-        });
-
-        // Diagonal line
-        curves.push_back({
-            Point(100, 100),  // Start of the diagonal (top-left)
-            Point(400, 500)   // End of the diagonal (bottom-right)
-        });
-        break;
-
-
-    case 'O': // For the letter 'O' representing the circle
-        // Quadrant 1: Top-Right
-        curves.push_back({
-            Point(300, 100),  // P0: Start point
-            Point(433, 100),  // P1: Control point 1
-            Point(500, 167),  // P2: Control point 2
-            Point(500, 300)   // P3: End point
-        });
-
-        // Quadrant 2: Bottom-Right
-        curves.push_back({
-            Point(500, 300),  // P0: Start point
-            Point(500, 433),  // P1: Control point 1
-            Point(433, 500),  // P2: Control point 2
-            Point(300, 500)   // P3: End point
-        });
-
-        // Quadrant 3: Bottom-Left
-        curves.push_back({
-            Point(300, 500),  // P0: Start point
-            Point(167, 500),  // P1: Control point 1
-            Point(100, 433),  // P2: Control point 2
-            Point(100, 300)   // P3: End point
-        });
-
-        // Quadrant 4: Top-Left
-        curves.push_back({
-            Point(100, 300),  // P0: Start point
-            Point(100, 167),  // P1: Control point 1
-            Point(167, 100),  // P2: Control point 2
-            Point(300, 100)   // P3: End point
-        });
-        break;
-
-
-
-    case 'P':
-        // Vertical line on the left
-        curves.push_back({
-            Point(100, 100),  // Start of the vertical line (top-left)
-            Point(100, 500)   // End of the vertical line (bottom-left)
-        });
-
-        // Semi-circle for the top curve
-        curves.push_back({
-            Point(100, 100),  // Start of the semi-circle (top-left)
-            Point(300, 200),  // Control point (center-right, bulging outward)
-            Point(100, 300)   // End of the semi-circle (middle-left)
-        });
-        break;
-
-
-
-    case 'Q':
-        // Top-right quadrant of the circle
-        curves.push_back({
-            Point(300, 100),  // Start
-            Point(433, 100),  // Control point 1
-            Point(500, 167),  // Control point 2
-            Point(500, 300)   // End
-        });
-
-        // Bottom-right quadrant of the circle
-        curves.push_back({
-            Point(500, 300),  // Start
-            Point(500, 433),  // Control point 1
-            Point(433, 500),  // Control point 2
-            Point(300, 500)   // End
-        });
-
-        // Bottom-left quadrant of the circle
-        curves.push_back({
-            Point(300, 500),  // Start
-            Point(167, 500),  // Control point 1
-            Point(100, 433),  // Control point 2
-            Point(100, 300)   // End
-        });
-
-        // Top-left quadrant of the circle
-        curves.push_back({
-            Point(100, 300),  // Start
-            Point(100, 167),  // Control point 1
-            Point(167, 100),  // Control point 2
-            Point(300, 100)   // End
-        });
-
-        // Diagonal tail
-        curves.push_back({
-            Point(400, 400),  // Start of the tail
-            Point(500, 500)   // End of the tail
-        });
-        break;
-
-
-    case 'R':
-        // Vertical line on the left
-        curves.push_back({
-            Point(100, 100),  // Start of the vertical line (top-left)
-            Point(100, 500)   // End of the vertical line (bottom-left)
-        });
-
-        // Semi-circle for the top curve
-        curves.push_back({
-            Point(100, 100),  // Start of the semi-circle (top-left)
-            Point(300, 200),  // Control point (center-right, bulging outward)
-            Point(100, 300)   // End of the semi-circle (middle-left)
-        });
-
-        // Diagonal line
-        curves.push_back({
-            Point(100, 300),  // Start of the diagonal line (middle-left)
-            Point(400, 500)   // End of the diagonal line (bottom-right)
-        });
-        break;
-
-
-    case 'S':
-        // Top semi-circle
-        curves.push_back({
-            Point(300, 100),  // Start of the top semi-circle (top-middle)
-            Point(100, 200),  // Control point (left-middle, bulging outward)
-            Point(300, 300)   // End of the top semi-circle (center-middle)
-        });
-
-        // Bottom semi-circle
-        curves.push_back({
-            Point(300, 300),  // Start of the bottom semi-circle (center-middle)
-            Point(500, 400),  // Control point (right-middle, bulging outward)
-            Point(300, 500)   // End of the bottom semi-circle (bottom-middle)
-        });
-        break;
-
-
-    case 'T':
-        // Vertical line in the center
-        curves.push_back({
-            Point(250, 100),  // Start of the vertical line (top-center)
-            Point(250, 500)   // End of the vertical line (bottom-center)
-        });
-
-        // Horizontal line at the top
-        curves.push_back({
-            Point(150, 100),  // Start of the horizontal line (top-left)
-            Point(350, 100)   // End of the horizontal line (top-right)
-        });
-        break;
-
-
-    case 'U':
-        curves.push_back({Point(100, 100), Point(100, 500)});  // Left vertical line
-        curves.push_back({Point(400, 100), Point(400, 500)});  // Right vertical line
-        curves.push_back({Point(100, 500), Point(250, 550), Point(400, 500)});  // Bottom curve
-        break;
-
-
-    case 'V':
-        curves.push_back({Point(100, 100), Point(250, 500)});  // Left diagonal
-        curves.push_back({Point(250, 500), Point(400, 100)});  // Right diagonal
-        break;
-
-
-    case 'W':
-        curves.push_back({Point(100, 100), Point(100, 500)});  // Left vertical line
-        curves.push_back({Point(100, 500), Point(250, 300)});  // Left diagonal
-        curves.push_back({Point(250, 300), Point(400, 500)});  // Right diagonal
-        curves.push_back({Point(400, 500), Point(400, 100)});  // Right vertical line
-        break;
-
-
-    case 'X':
-        curves.push_back({Point(100, 100), Point(400, 500)});  // Left diagonal
-        curves.push_back({Point(400, 100), Point(100, 500)});  // Right diagonal
-        break;
-
-
-    case 'Y':
-        curves.push_back({Point(100, 100), Point(250, 300)});  // Left diagonal
-        curves.push_back({Point(400, 100), Point(250, 300)});  // Right diagonal
-        curves.push_back({Point(250, 300), Point(250, 500)});  // Vertical line
-        break;
-
-
-    case 'Z':
-        curves.push_back({Point(100, 100), Point(400, 100)});  // Top horizontal line
-        curves.push_back({Point(400, 100), Point(100, 500)});  // Diagonal line
-        curves.push_back({Point(100, 500), Point(400, 500)});  // Bottom horizontal line
-        break;
-
-
-    default:
+    TRACE_PORTEE("generateGlyph");
+    if (letter < 'A' || letter > 'Z') {
         // Gérer les lettres non supportées
         std::cerr << "Lettre non supportée : " << letter << std::endl;
-        return Glyph(std::vector<std::vector<Point>>{}); // Glyphe vide
+        return Glyph(); // Glyphe vide
     }
-
-
-    return Glyph(curves);
+    const PlageGlyphe& plage = TABLE_GLYPHES.plages[letter - 'A'];
+    return Glyph(TABLE_GLYPHES.points, TABLE_GLYPHES.courbes + plage.premiereCourbe, plage.nbCourbes);
 }
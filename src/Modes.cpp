@@ -0,0 +1,86 @@
+#include "Modes.h"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+/**
+ * @brief Lance un mode et transforme ses exceptions en message d'erreur.
+ * 
+ * @param mode Le mode.
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du mode, ou 1 s'il a levé une exception.
+ */
+int executerMode(const ModeProgramme& mode, const std::vector<std::string>& arguments) {
+    try {
+        return mode.executer(arguments);
+    } catch (const std::exception& e) {
+        std::cerr << "Erreur : " << e.what() << std::endl;
+        return 1;
+    }
+}
+
+/**
+ * @brief Argument de rang `indice`, ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return std::string L'argument.
+ */
+std::string argumentTexte(const std::vector<std::string>& arguments, size_t indice, const std::string& defaut) {
+    return indice < arguments.size() ? arguments[indice] : defaut;
+}
+
+/**
+ * @brief Argument entier de rang `indice`, ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return int L'entier.
+ */
+int argumentEntier(const std::vector<std::string>& arguments, size_t indice, int defaut) {
+    return indice < arguments.size() ? std::atoi(arguments[indice].c_str()) : defaut;
+}
+
+/**
+ * @brief Argument réel de rang `indice`, ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return double Le réel.
+ */
+double argumentReel(const std::vector<std::string>& arguments, size_t indice, double defaut) {
+    return indice < arguments.size() ? std::atof(arguments[indice].c_str()) : defaut;
+}
+
+/**
+ * @brief Argument de taille mémoire de rang `indice`, ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return size_t La taille, en octets.
+ */
+size_t argumentOctets(const std::vector<std::string>& arguments, size_t indice, size_t defaut) {
+    return indice < arguments.size() ? std::strtoull(arguments[indice].c_str(), nullptr, 10) : defaut;
+}
+
+/**
+ * @brief Découpe une liste de tailles séparées par des virgules.
+ * 
+ * @param liste La liste.
+ * @return std::vector<int> Les tailles.
+ */
+std::vector<int> listeTailles(const std::string& liste) {
+    std::vector<int> tailles;
+    size_t debut = 0;
+    while (debut <= liste.size()) {
+        const size_t fin = std::min(liste.find(',', debut), liste.size());
+        tailles.push_back(std::atoi(liste.substr(debut, fin - debut).c_str()));
+        debut = fin + 1;
+    }
+    return tailles;
+}
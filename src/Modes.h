@@ -0,0 +1,180 @@
+#ifndef MODES_H
+#define MODES_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Mode du programme choisi par une option de la ligne de commande.
+ * 
+ * Le point d'entrée reçoit les arguments qui suivent l'option et renvoie le
+ * code de retour du programme. main() garde une table de ces modes ;
+ * executerMode() les lance tous avec la même gestion des erreurs.
+ */
+struct ModeProgramme {
+    const char* option;       ///< Option qui choisit le mode, par exemple "--rendu".
+    size_t nbArgumentsRequis; ///< Nombre d'arguments obligatoires après l'option.
+    const char* usage;        ///< Arguments du mode, pour le message d'usage.
+    int (*executer)(const std::vector<std::string>& arguments); ///< Point d'entrée du mode.
+};
+
+/**
+ * @brief Lance un mode et transforme ses exceptions en message d'erreur.
+ * 
+ * @param mode Le mode.
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du mode, ou 1 s'il a levé une exception.
+ */
+int executerMode(const ModeProgramme& mode, const std::vector<std::string>& arguments);
+
+/**
+ * @brief Argument de rang `indice`, ou une valeur par défaut s'il est absent.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return std::string L'argument.
+ */
+std::string argumentTexte(const std::vector<std::string>& arguments, size_t indice, const std::string& defaut);
+
+/**
+ * @brief Argument entier de rang `indice` (std::atoi), ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return int L'entier.
+ */
+int argumentEntier(const std::vector<std::string>& arguments, size_t indice, int defaut);
+
+/**
+ * @brief Argument réel de rang `indice` (std::atof), ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return double Le réel.
+ */
+double argumentReel(const std::vector<std::string>& arguments, size_t indice, double defaut);
+
+/**
+ * @brief Argument de taille mémoire de rang `indice` (en octets), ou une valeur par défaut.
+ * 
+ * @param arguments Arguments du mode.
+ * @param indice Rang de l'argument.
+ * @param defaut Valeur si l'argument est absent.
+ * @return size_t La taille.
+ */
+size_t argumentOctets(const std::vector<std::string>& arguments, size_t indice, size_t defaut);
+
+/**
+ * @brief Découpe une liste de tailles séparées par des virgules (par exemple "32,64,128").
+ * 
+ * @param liste La liste.
+ * @return std::vector<int> Les tailles.
+ */
+std::vector<int> listeTailles(const std::string& liste);
+
+// Modes de rendu (ModesRendu.cpp)
+
+/**
+ * @brief `--rendu <lettres> [contour|gras|rouge|lisse] [taille] [préfixe]` :
+ * dessine des lettres sans affichage et les enregistre au format Netpbm.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeRendu(const std::vector<std::string>& arguments);
+
+/**
+ * @brief `--lot <tailles> [dossier] [threads]` : rend toutes les lettres dans
+ * les trois styles des polices aux tailles données, en parallèle.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeLot(const std::vector<std::string>& arguments);
+
+/**
+ * @brief `--atlas <lettres> [taille] [fichier]` : range les lettres des trois
+ * styles dans un atlas de glyphes sérialisé.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeAtlas(const std::vector<std::string>& arguments);
+
+// Mesures des caches (ModesCache.cpp)
+
+/**
+ * @brief `--cache <lettres> [contour|gras|rouge|lisse] [taille] [passages] [budget]` :
+ * compare le rendu direct et le cache de glyphes.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeCache(const std::vector<std::string>& arguments);
+
+/**
+ * @brief `--cache-concurrent [threads] [durée ms]` : éprouve le cache partagé
+ * entre threads et mesure sa montée en charge.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeCacheConcurrent(const std::vector<std::string>& arguments);
+
+// Bancs d'essai et vérifications (ModesEssai.cpp)
+
+/**
+ * @brief `--bancs [fichier.json] [répétitions] [groupe]` : mesure les chemins
+ * critiques du rendu et écrit les résultats en JSON.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeBancs(const std::vector<std::string>& arguments);
+
+/**
+ * @brief `--regression <dossier> [generer|verifier] [taille] [écarts débit] [tolérance]` :
+ * compare les lettres des trois polices et le débit du rendu aux références
+ * (code de retour 2 si seul le débit est insuffisant).
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeRegression(const std::vector<std::string>& arguments);
+
+/**
+ * @brief `--allocations [tailles]` : vérifie qu'un rendu en régime établi
+ * n'appelle plus l'allocateur global.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeAllocations(const std::vector<std::string>& arguments);
+
+/**
+ * @brief `--pool [passages] [budget]` : compare les bitmaps neufs et ceux
+ * d'un pool pour dessiner les lettres des polices.
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modePool(const std::vector<std::string>& arguments);
+
+#ifndef SANS_SDL
+
+/**
+ * @brief `--mesure-affichage [répétitions]` : compare les deux chemins
+ * d'affichage SDL (programmes compilés avec SDL seulement).
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int Code de retour du programme.
+ */
+int modeMesureAffichage(const std::vector<std::string>& arguments);
+
+#endif // SANS_SDL
+
+#endif // MODES_H
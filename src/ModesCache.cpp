@@ -0,0 +1,246 @@
+#include "CacheConcurrent.h"
+#include "CacheGlyphes.h"
+#include "Modes.h"
+#include "PoolThreads.h"
+#include "Rendu.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Compare le rendu direct et le rendu par le cache de glyphes.
+ * 
+ * Dessine `repetitions` fois chaque lettre dans le style et à la taille
+ * donnés, d'abord par Rendu::rendreLettre() puis par CacheGlyphes::dessiner(),
+ * vérifie que les deux chemins produisent les mêmes pixels et affiche le temps
+ * moyen par lettre ainsi que les compteurs du cache.
+ * 
+ * @param lettres Les lettres à dessiner.
+ * @param style Style de rendu.
+ * @param taille Hauteur des rendus en pixels.
+ * @param repetitions Nombre de passages sur les lettres.
+ * @param budget Mémoire maximale du cache, en octets.
+ * @return int 0 si les deux chemins donnent les mêmes pixels, 1 sinon.
+ */
+static int mesurerCache(const std::string& lettres, StyleRendu style, int taille, int repetitions, size_t budget) {
+    std::string majuscules = lettres;
+    for (char& lettre : majuscules) {
+        lettre = static_cast<char>(std::toupper(static_cast<unsigned char>(lettre)));
+    }
+    Rendu rendu;
+    CacheGlyphes cache(budget);
+    Bitmap direct = Rendu::creerBitmap(style, taille);
+    Bitmap enCache = Rendu::creerBitmap(style, taille);
+
+    auto mesurer = [&](auto&& dessiner) {
+        const auto debut = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            for (char lettre : majuscules) {
+                dessiner(lettre);
+            }
+        }
+        const std::chrono::duration<double, std::micro> duree = std::chrono::steady_clock::now() - debut;
+        return duree.count() / std::max<size_t>(1, static_cast<size_t>(repetitions) * majuscules.size());
+    };
+    const double tempsDirect = mesurer([&](char lettre) { rendu.rendreLettre(lettre, style, taille, direct); });
+    const double tempsCache = mesurer([&](char lettre) { cache.dessiner(lettre, style, taille, enCache); });
+
+    bool identiques = true;
+    for (char lettre : majuscules) {
+        rendu.rendreLettre(lettre, style, taille, direct);
+        cache.dessiner(lettre, style, taille, enCache);
+        for (int y = 0; y < taille && identiques; ++y) {
+            identiques = std::equal(direct.row(y), direct.row(y) + direct.getStride(), enCache.row(y));
+        }
+    }
+
+    const StatistiquesCache statistiques = cache.getStatistiques();
+    std::cout << "Style " << Rendu::nomStyle(style) << ", taille " << taille << ", " << repetitions << " passage(s)" << std::endl;
+    std::cout << "  rendu direct  : " << tempsDirect << " µs/lettre" << std::endl;
+    std::cout << "  cache         : " << tempsCache << " µs/lettre (x" << tempsDirect / tempsCache << ")" << std::endl;
+    std::cout << "  compteurs     : " << statistiques.succes << " succès, " << statistiques.echecs << " échecs, "
+              << statistiques.evictions << " évictions" << std::endl;
+    std::cout << "  occupation    : " << statistiques.entrees << " rendus, " << statistiques.octets << " / "
+              << cache.getBudget() << " octets" << std::endl;
+    std::cout << "  comparaison   : " << (identiques ? "rendus identiques" : "rendus différents") << std::endl;
+    return identiques ? 0 : 1;
+}
+
+/**
+ * @brief Éprouve le cache concurrent depuis plusieurs threads et mesure sa montée en charge.
+ * 
+ * Trois étapes :
+ * - regroupement : tous les threads demandent en même temps un même rendu
+ *   absent, qui ne doit être construit qu'une fois ;
+ * - épreuve : pendant `duree` ms, les threads tirent au hasard des rendus
+ *   parmi 312 (26 lettres, 4 styles, 3 tailles) dans un cache au budget
+ *   volontairement trop petit, ce qui force évictions et récupérations ; chaque
+ *   résultat est comparé à un rendu de référence ;
+ * - montée en charge : débit des succès avec 1, 2, 4... threads, comparé à
+ *   celui d'un CacheGlyphes protégé par un seul mutex.
+ * 
+ * @param nbThreads Nombre maximal de threads (0 : un par cœur).
+ * @param duree Durée de chaque mesure en millisecondes.
+ * @return int 0 si aucun rendu n'est faux et si le regroupement a fonctionné, 1 sinon.
+ */
+static int eprouverCacheConcurrent(size_t nbThreads, int duree) {
+    PoolThreads pool(nbThreads);
+    nbThreads = pool.getNbThreads();
+    using Horloge = std::chrono::steady_clock;
+
+    const StyleRendu styles[] = {StyleRendu::Contour, StyleRendu::RempliGras, StyleRendu::ContourRouge, StyleRendu::Lisse};
+    const int tailles[] = {24, 40, 64};
+    std::vector<CleGlyphe> cles;
+    std::vector<Bitmap> references;
+    Rendu rendu;
+    for (StyleRendu style : styles) {
+        for (int taille : tailles) {
+            for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+                cles.push_back(CleGlyphe{lettre, style, taille});
+                references.push_back(rendu.rendreLettre(lettre, style, taille));
+            }
+        }
+    }
+
+    // Moteur de rendu et bitmaps de chaque thread
+    struct Ouvrier {
+        Rendu rendu;
+        std::vector<Bitmap> bitmaps;
+    };
+    std::vector<Ouvrier> ouvriers(nbThreads);
+    for (Ouvrier& ouvrier : ouvriers) {
+        for (const Bitmap& reference : references) {
+            ouvrier.bitmaps.emplace_back(reference.getWidth(), reference.getHeight(), reference.getFormat());
+        }
+    }
+    auto lancer = [&](const std::function<void(Ouvrier&)>& travail) {
+        for (size_t i = 0; i < nbThreads; ++i) {
+            pool.soumettre([&travail, &ouvriers](size_t indice) { travail(ouvriers[indice]); });
+        }
+        pool.attendre();
+    };
+
+    // Regroupement des demandes simultanées d'un même rendu
+    CacheConcurrent regroupement;
+    std::atomic<size_t> prets{0};
+    lancer([&](Ouvrier& ouvrier) {
+        Bitmap bitmap = Rendu::creerBitmap(StyleRendu::Lisse, 300);
+        prets.fetch_add(1);
+        while (prets.load() < nbThreads) {
+            std::this_thread::yield();
+        }
+        regroupement.dessiner(ouvrier.rendu, 'W', StyleRendu::Lisse, 300, bitmap);
+    });
+    const StatistiquesCacheConcurrent demandes = regroupement.getStatistiques();
+    std::cout << "Regroupement (" << nbThreads << " thread(s), un même rendu) : " << demandes.echecs << " construction(s), "
+              << demandes.regroupes << " attente(s), " << demandes.succes << " succès" << std::endl;
+
+    // Épreuve : tirages aléatoires, budget trop petit, résultats vérifiés
+    CacheConcurrent epreuve(64 * 1024, 8);
+    std::atomic<size_t> operations{0};
+    std::atomic<size_t> erreurs{0};
+    std::atomic<uint64_t> graine{1};
+    const auto finEpreuve = Horloge::now() + std::chrono::milliseconds(duree);
+    lancer([&](Ouvrier& ouvrier) {
+        uint64_t etat = graine.fetch_add(0x9E3779B97F4A7C15ull) | 1;
+        size_t nombre = 0;
+        while (Horloge::now() < finEpreuve) {
+            for (int i = 0; i < 64; ++i, ++nombre) {
+                etat ^= etat << 13;
+                etat ^= etat >> 7;
+                etat ^= etat << 17;
+                const size_t k = etat % cles.size();
+                Bitmap& bitmap = ouvrier.bitmaps[k];
+                epreuve.dessiner(ouvrier.rendu, cles[k].lettre, cles[k].style, cles[k].taille, bitmap);
+                for (int y = 0; y < bitmap.getHeight(); ++y) {
+                    if (!std::equal(bitmap.row(y), bitmap.row(y) + bitmap.getStride(), references[k].row(y))) {
+                        erreurs.fetch_add(1);
+                        break;
+                    }
+                }
+            }
+        }
+        operations.fetch_add(nombre);
+    });
+    const StatistiquesCacheConcurrent mesures = epreuve.getStatistiques();
+    std::cout << "Épreuve (" << nbThreads << " thread(s), " << duree << " ms, budget " << epreuve.getBudget() << " octets) : "
+              << operations.load() << " rendus, " << erreurs.load() << " faux" << std::endl;
+    std::cout << "  " << mesures.succes << " succès, " << mesures.regroupes << " attentes, " << mesures.echecs << " constructions, "
+              << mesures.evictions << " évictions, " << mesures.entrees << " en cache (" << mesures.octets << " octets), "
+              << mesures.aRecuperer << " objets à récupérer" << std::endl;
+
+    // Montée en charge des succès : cache concurrent contre cache sous mutex
+    CacheConcurrent concurrent;
+    CacheGlyphes protege(SIZE_MAX);
+    std::mutex mutex;
+    for (size_t k = 0; k < cles.size(); ++k) {
+        concurrent.dessiner(rendu, cles[k].lettre, cles[k].style, cles[k].taille, ouvriers[0].bitmaps[k]);
+        protege.dessiner(cles[k].lettre, cles[k].style, cles[k].taille, ouvriers[0].bitmaps[k]);
+    }
+    auto debit = [&](size_t actifs, bool sousMutex) {
+        std::atomic<size_t> total{0};
+        std::atomic<size_t> indice{0};
+        const auto fin = Horloge::now() + std::chrono::milliseconds(duree);
+        lancer([&](Ouvrier& ouvrier) {
+            const size_t numero = indice.fetch_add(1);
+            if (numero >= actifs) {
+                return;
+            }
+            size_t nombre = 0;
+            size_t k = numero * 7;
+            while (Horloge::now() < fin) {
+                for (int i = 0; i < 64; ++i, ++nombre) {
+                    k = (k + 1) % cles.size();
+                    Bitmap& bitmap = ouvrier.bitmaps[k];
+                    if (sousMutex) {
+                        std::lock_guard<std::mutex> verrou(mutex);
+                        protege.dessiner(cles[k].lettre, cles[k].style, cles[k].taille, bitmap);
+                    } else {
+                        concurrent.dessiner(ouvrier.rendu, cles[k].lettre, cles[k].style, cles[k].taille, bitmap);
+                    }
+                }
+            }
+            total.fetch_add(nombre);
+        });
+        return total.load() * 1e3 / duree;
+    };
+    std::cout << "Montée en charge des succès (rendus/s), " << std::thread::hardware_concurrency() << " cœur(s) :" << std::endl;
+    for (size_t actifs = 1; actifs <= nbThreads; actifs = actifs < nbThreads ? std::min(actifs * 2, nbThreads) : actifs + 1) {
+        const double sansVerrou = debit(actifs, false);
+        const double avecMutex = debit(actifs, true);
+        std::cout << "  " << actifs << " thread(s) : concurrent " << sansVerrou << ", mutex " << avecMutex
+                  << " (x" << sansVerrou / avecMutex << ")" << std::endl;
+    }
+    return erreurs.load() == 0 && demandes.echecs == 1 ? 0 : 1;
+}
+
+/**
+ * @brief Mode `--cache` : voir mesurerCache().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si les deux chemins donnent les mêmes pixels, 1 sinon.
+ */
+int modeCache(const std::vector<std::string>& arguments) {
+    const StyleRendu style = Rendu::styleDepuisNom(argumentTexte(arguments, 1, "contour"));
+    const int taille = argumentEntier(arguments, 2, 64);
+    const int repetitions = std::max(1, argumentEntier(arguments, 3, 100));
+    const size_t budget = argumentOctets(arguments, 4, 16 * 1024 * 1024);
+    return mesurerCache(arguments[0], style, taille, repetitions, budget);
+}
+
+/**
+ * @brief Mode `--cache-concurrent` : voir eprouverCacheConcurrent().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si aucun rendu n'est faux et si le regroupement a fonctionné, 1 sinon.
+ */
+int modeCacheConcurrent(const std::vector<std::string>& arguments) {
+    const size_t nbThreads = static_cast<size_t>(std::max(0, argumentEntier(arguments, 0, 0)));
+    return eprouverCacheConcurrent(nbThreads, std::max(1, argumentEntier(arguments, 1, 500)));
+}
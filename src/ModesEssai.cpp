@@ -0,0 +1,396 @@
+#include "BancEssai.h"
+#include "Composition.h"
+#include "GlyphGenerator.h"
+#include "Modes.h"
+#include "Netpbm.h"
+#include "Police1.h"
+#include "Police2.h"
+#include "Police3.h"
+#include "PoolBitmaps.h"
+#include "Regression.h"
+#include "Rendu.h"
+#include "Sdl.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+/**
+ * @brief Mesure les chemins critiques du rendu et écrit les résultats en JSON.
+ * 
+ * Groupes de mesures (un seul si `groupe` n'est pas vide) :
+ * - "bezier" : courbeLineaire, courbeQuadratique et deCasteljau pour
+ *   plusieurs degrés et résolutions ;
+ * - "glyph" : chaque méthode Glyph::draw* (et fillInside) à plusieurs
+ *   tailles et épaisseurs ; un appel dessine les 26 lettres ;
+ * - "sortie" : Bitmap::saveToFile et Netpbm::ecrire d'une lettre 600 x 600 ;
+ * - "sdl" : les deux chemins d'affichage SDL avec le pilote "dummy"
+ *   (programmes compilés avec SDL seulement).
+ * 
+ * Chaque résultat donne la durée moyenne d'un appel, son écart type entre
+ * répétitions et le nombre d'allocations par appel (voir BancEssai), ce qui
+ * permet de comparer deux compilations en comparant leurs fichiers JSON.
+ * 
+ * @param fichier Fichier JSON produit.
+ * @param repetitions Répétitions chronométrées par mesure.
+ * @param groupe Groupe à mesurer ("" : tous).
+ * @return int 0 si succès.
+ */
+static int executerBancs(const std::string& fichier, size_t repetitions, const std::string& groupe) {
+    BancEssai banc(repetitions);
+    auto mesurer = [&](const std::string& groupeMesure, const std::string& nom, const std::function<void()>& operation) {
+        if (!groupe.empty() && groupe != groupeMesure) {
+            return;
+        }
+        const ResultatMesure& r = banc.mesurer(groupeMesure, nom, operation);
+        std::cout << "  " << groupeMesure << "/" << nom << " : " << r.moyenne / 1e3 << " µs ± " << r.ecartType / 1e3
+                  << " (" << r.allocations << " allocations)" << std::endl;
+    };
+
+    // Courbes de Bézier
+    for (int nbPoints : {16, 256}) {
+        mesurer("bezier", "courbeLineaire/points=" + std::to_string(nbPoints),
+                [nbPoints]() { BezierCourbe::courbeLineaire(Point(0, 0), Point(100, 50), nbPoints); });
+        mesurer("bezier", "courbeQuadratique/points=" + std::to_string(nbPoints),
+                [nbPoints]() { BezierCourbe::courbeQuadratique(Point(0, 0), Point(50, 100), Point(100, 0), nbPoints); });
+    }
+    for (int degre : {2, 3, 5, 8}) {
+        std::vector<Point> controle;
+        for (int i = 0; i <= degre; ++i) {
+            controle.emplace_back(100.0f * i / degre, (i % 2 == 0 ? 0.0f : 100.0f));
+        }
+        for (int resolution : {16, 64, 256}) {
+            mesurer("bezier", "deCasteljau/degre=" + std::to_string(degre) + "/resolution=" + std::to_string(resolution),
+                    [controle, resolution]() { BezierCourbe::deCasteljau(controle, resolution); });
+        }
+    }
+
+    // Méthodes de dessin des glyphes, pour les 26 lettres
+    std::vector<Glyph> glyphes;
+    for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+        glyphes.push_back(generateGlyph(lettre));
+    }
+    for (int taille : {64, 256, 600}) {
+        for (Glyph& glyph : glyphes) {
+            glyph.setEchelle(static_cast<float>(taille) / Rendu::TAILLE_DESSIN);
+        }
+        Bitmap monochrome(taille, taille, PixelFormat::Bit1);
+        Bitmap couleur(taille, taille, PixelFormat::Index8);
+        Bitmap couverture(taille, taille, PixelFormat::Coverage8);
+        auto pourChaque = [&glyphes](auto&& dessiner) {
+            return [&glyphes, dessiner]() {
+                for (const Glyph& glyph : glyphes) {
+                    dessiner(glyph);
+                }
+            };
+        };
+        const std::string suffixe = "/taille=" + std::to_string(taille);
+        mesurer("glyph", "drawContour" + suffixe, pourChaque([&](const Glyph& g) { g.drawContour(monochrome); }));
+        mesurer("glyph", "fillInside" + suffixe, pourChaque([&](const Glyph& g) { g.fillInside(monochrome); }));
+        mesurer("glyph", "drawFilled" + suffixe, pourChaque([&](const Glyph& g) { g.drawFilled(monochrome); }));
+        mesurer("glyph", "drawRedContour" + suffixe, pourChaque([&](const Glyph& g) { g.drawRedContour(couleur); }));
+        mesurer("glyph", "drawAntialiased" + suffixe, pourChaque([&](const Glyph& g) { g.drawAntialiased(couverture); }));
+        for (int epaisseur : {1, 4, 15}) {
+            const std::string nom = suffixe + "/epaisseur=" + std::to_string(epaisseur);
+            mesurer("glyph", "drawBold" + nom, pourChaque([&, epaisseur](const Glyph& g) { g.drawBold(monochrome, epaisseur); }));
+            mesurer("glyph", "drawWithRedOutline" + nom,
+                    pourChaque([&, epaisseur](const Glyph& g) { g.drawWithRedOutline(couleur, epaisseur); }));
+        }
+    }
+
+    // Écriture d'une lettre dans un fichier
+    Rendu rendu;
+    const Bitmap lettre = rendu.rendreLettre('A', StyleRendu::ContourRouge, Rendu::TAILLE_DESSIN);
+    const std::string temporaire = fichier + ".tmp";
+    mesurer("sortie", "saveToFile/600x600", [&]() { lettre.saveToFile(temporaire); });
+    mesurer("sortie", "Netpbm::ecrire/600x600",
+            [&]() { Netpbm::ecrire(lettre, temporaire, Netpbm::formatNaturel(lettre)); });
+    std::remove(temporaire.c_str());
+
+#ifndef SANS_SDL
+    // Affichage SDL, sans fenêtre réelle
+    if (groupe.empty() || groupe == "sdl") {
+        Bitmap ecran(1200, 600);
+        rendu.rendreLettre('A', StyleRendu::ContourRouge, 600, ecran);
+        SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+        SDL sdl(1200, 600, "Bancs d'essai");
+        mesurer("sdl", "renderBitmap/1200x600", [&]() { sdl.renderBitmap(ecran); });
+        mesurer("sdl", "renderBitmapPerPoint/1200x600", [&]() { sdl.renderBitmapPerPoint(ecran); });
+    }
+#endif
+
+    std::ofstream sortie(fichier);
+    if (!sortie) {
+        throw std::ios_base::failure("Impossible de créer le fichier : " + fichier);
+    }
+    banc.ecrireJson(sortie, {{"jeu_instructions", Composition::nomJeuInstructions(Composition::getJeuInstructions())}});
+    if (!sortie.flush()) {
+        throw std::ios_base::failure("Erreur d'écriture dans le fichier : " + fichier);
+    }
+    std::cout << banc.getResultats().size() << " mesure(s) écrite(s) dans " << fichier << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Non-régression : rend les 26 lettres des trois polices et les compare aux références.
+ * 
+ * En mode "generer", écrit les images et le débit de référence dans le
+ * dossier ; en mode "verifier", compare les rendus et le débit actuels aux
+ * références (voir Regression).
+ * 
+ * @param dossier Dossier des références.
+ * @param mode "generer" ou "verifier".
+ * @param options Réglages de la vérification.
+ * @return int 0 si la vérification réussit (ou après génération), 1 si des
+ *         images diffèrent ou manquent, 2 si seul le débit est insuffisant.
+ * 
+ * @throws std::invalid_argument Si le mode est inconnu ou les réglages invalides.
+ */
+static int verifierRegression(const std::string& dossier, const std::string& mode, const OptionsRegression& options) {
+    const Regression regression(dossier, options);
+    if (mode == "generer") {
+        regression.generer(std::cout);
+        return 0;
+    }
+    if (mode != "verifier") {
+        throw std::invalid_argument("Mode de non-régression inconnu : " + mode);
+    }
+    const BilanRegression bilan = regression.verifier(std::cout);
+    if (!bilan.imagesConformes()) {
+        return 1;
+    }
+    return bilan.debitInsuffisant ? 2 : 0;
+}
+
+/**
+ * @brief Vérifie qu'un rendu en régime établi n'appelle pas l'allocateur global.
+ * 
+ * Pour chaque style et chaque taille, les 26 lettres sont rendues deux fois
+ * dans un bitmap réutilisé (mise en température : glyphes aplatis, arène de
+ * travail à sa taille), puis une troisième fois en comptant les appels à
+ * operator new (voir BancEssai::getNbAllocations()).
+ * 
+ * @param tailles Tailles des rendus en pixels.
+ * @return int 0 si aucun rendu n'a alloué, 1 sinon.
+ */
+static int verifierAllocations(const std::vector<int>& tailles) {
+    Rendu rendu;
+    bool sansAllocation = true;
+    for (StyleRendu style : {StyleRendu::Contour, StyleRendu::RempliGras, StyleRendu::ContourRouge, StyleRendu::Lisse}) {
+        for (int taille : tailles) {
+            Bitmap bitmap = Rendu::creerBitmap(style, taille);
+            for (int passage = 0; passage < 2; ++passage) {
+                for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+                    rendu.rendreLettre(lettre, style, taille, bitmap);
+                }
+            }
+            const size_t allocations = BancEssai::getNbAllocations();
+            const size_t octets = BancEssai::getOctetsAlloues();
+            for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+                rendu.rendreLettre(lettre, style, taille, bitmap);
+            }
+            const size_t nbAllocations = BancEssai::getNbAllocations() - allocations;
+            std::cout << "  " << Rendu::nomStyle(style) << " " << taille << " : " << nbAllocations << " allocation(s), "
+                      << BancEssai::getOctetsAlloues() - octets << " octet(s) pour 26 lettres" << std::endl;
+            sansAllocation = sansAllocation && nbAllocations == 0;
+        }
+    }
+    std::cout << (sansAllocation ? "Aucune allocation en régime établi" : "ÉCHEC : des rendus allouent encore") << std::endl;
+    return sansAllocation ? 0 : 1;
+}
+
+/**
+ * @brief Compare les bitmaps neufs et les bitmaps d'un pool pour afficher des lettres.
+ * 
+ * Pour chaque police à 1200 x 600 (les dimensions de la fenêtre), les 26
+ * lettres sont dessinées `repetitions` fois par PoliceBase::dessinerLettre(),
+ * qui alloue et efface un bitmap complet à chaque appel, puis par
+ * PoliceBase::dessinerDansPool() suivi de PoolBitmaps::rendre(), comme le
+ * fait SDL::showImage(). Les deux chemins doivent produire les mêmes pixels ;
+ * affiche le temps et les allocations par lettre ainsi que les compteurs du pool.
+ * 
+ * @param repetitions Nombre de passages sur les lettres.
+ * @param budget Mémoire maximale des bitmaps libres du pool, en octets.
+ * @return int 0 si les deux chemins donnent les mêmes pixels, 1 sinon.
+ */
+static int mesurerPool(int repetitions, size_t budget) {
+    const Police1 police1(1200, 600);
+    const Police2 police2(1200, 600);
+    const Police3 police3(1200, 600);
+    PoolBitmaps pool(budget);
+    bool identiques = true;
+    for (const PoliceBase* police : {static_cast<const PoliceBase*>(&police1), static_cast<const PoliceBase*>(&police2),
+                                     static_cast<const PoliceBase*>(&police3)}) {
+        // Vérification, qui met aussi les rendus en cache
+        for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+            Rectangle zone{0, 0, 0, 0};
+            const Bitmap neuf = police->dessinerLettre(lettre);
+            Bitmap canevas = police->dessinerDansPool(lettre, pool, zone);
+            for (int y = 0; y < neuf.getHeight() && identiques; ++y) {
+                identiques = std::equal(neuf.row(y), neuf.row(y) + neuf.getStride(), canevas.row(y));
+            }
+            pool.rendre(std::move(canevas), zone);
+        }
+
+        auto mesurer = [&](auto&& dessiner, size_t& allocations) {
+            const size_t depart = BancEssai::getNbAllocations();
+            const auto debut = std::chrono::steady_clock::now();
+            for (int i = 0; i < repetitions; ++i) {
+                for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+                    dessiner(lettre);
+                }
+            }
+            const std::chrono::duration<double, std::micro> duree = std::chrono::steady_clock::now() - debut;
+            allocations = BancEssai::getNbAllocations() - depart;
+            return duree.count() / (26.0 * repetitions);
+        };
+        size_t allocationsNeuf = 0;
+        size_t allocationsPool = 0;
+        const double tempsNeuf = mesurer([&](char lettre) {
+            const Bitmap bitmap = police->dessinerLettre(lettre);
+        }, allocationsNeuf);
+        const double tempsPool = mesurer([&](char lettre) {
+            Rectangle zone{0, 0, 0, 0};
+            Bitmap bitmap = police->dessinerDansPool(lettre, pool, zone);
+            pool.rendre(std::move(bitmap), zone);
+        }, allocationsPool);
+
+        std::cout << police->getNom() << " (" << Rendu::nomStyle(police->getStyle()) << "), 1200x600, "
+                  << repetitions << " passage(s)" << std::endl;
+        std::cout << "  bitmap neuf   : " << tempsNeuf << " µs/lettre, "
+                  << allocationsNeuf / (26.0 * repetitions) << " allocation(s)/lettre" << std::endl;
+        std::cout << "  pool          : " << tempsPool << " µs/lettre (x" << tempsNeuf / tempsPool << "), "
+                  << allocationsPool / (26.0 * repetitions) << " allocation(s)/lettre" << std::endl;
+    }
+
+    const StatistiquesPoolBitmaps statistiques = pool.getStatistiques();
+    std::cout << "Pool : " << statistiques.succes << " succès, " << statistiques.echecs << " échecs (taux "
+              << statistiques.tauxSucces() * 100.0 << " %), " << statistiques.evictions << " évictions, "
+              << statistiques.rejets << " rejets" << std::endl;
+    std::cout << "  occupation    : " << statistiques.entrees << " bitmap(s), " << statistiques.octets << " / "
+              << pool.getBudget() << " octets" << std::endl;
+    std::cout << "  effacement    : " << statistiques.pixelsEffaces / std::max<size_t>(1, statistiques.succes + statistiques.echecs)
+              << " pixels/lettre au lieu de " << 1200 * 600 << std::endl;
+    std::cout << "  comparaison   : " << (identiques ? "rendus identiques" : "rendus différents") << std::endl;
+    return identiques ? 0 : 1;
+}
+
+#ifndef SANS_SDL
+
+/**
+ * @brief Compare les deux chemins d'affichage d'un bitmap SDL.
+ * 
+ * Affiche `repetitions` fois une lettre à contour rouge, d'abord pixel par
+ * pixel puis par la texture de streaming, et donne le temps moyen de chaque
+ * chemin. Sans affichage disponible, le pilote vidéo "dummy" est utilisé
+ * (la variable d'environnement SDL_VIDEODRIVER reste prioritaire) ; avec le
+ * renderer logiciel, les deux images sont aussi relues et comparées.
+ * 
+ * @param repetitions Nombre d'affichages par chemin.
+ * @return int 0 si les images sont identiques (ou non relisibles), 1 sinon.
+ */
+static int mesurerAffichage(int repetitions) {
+    const int width = 1200;
+    const int height = 600;
+    Bitmap bitmap(width, height);
+    Rendu().rendreLettre('A', StyleRendu::ContourRouge, height, bitmap);
+
+    SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy");
+    SDL sdl(width, height, "Mesure de l'affichage");
+
+    auto mesurer = [&](void (SDL::*rendu)(const Bitmap&)) {
+        const auto debut = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            (sdl.*rendu)(bitmap);
+        }
+        const std::chrono::duration<double, std::milli> duree = std::chrono::steady_clock::now() - debut;
+        return duree.count() / repetitions;
+    };
+    const double parPoint = mesurer(&SDL::renderBitmapPerPoint);
+    const double parTexture = mesurer(&SDL::renderBitmap);
+
+    std::cout << "Affichage " << width << "x" << height << ", " << repetitions << " répétitions" << std::endl;
+    std::cout << "  pixel par pixel : " << parPoint << " ms/image" << std::endl;
+    std::cout << "  texture         : " << parTexture << " ms/image" << std::endl;
+    std::cout << "  accélération    : x" << parPoint / parTexture << std::endl;
+
+    const int pitch = width * 4;
+    std::vector<uint8_t> imagePoints(static_cast<size_t>(pitch) * height);
+    std::vector<uint8_t> imageTexture(imagePoints.size());
+    sdl.renderBitmapPerPoint(bitmap);
+    const bool relue = sdl.readPixels(imagePoints.data(), pitch);
+    sdl.renderBitmap(bitmap);
+    if (!relue || !sdl.readPixels(imageTexture.data(), pitch)) {
+        std::cout << "  comparaison     : relecture des pixels indisponible" << std::endl;
+        return 0;
+    }
+    const bool identiques = imagePoints == imageTexture;
+    std::cout << "  comparaison     : " << (identiques ? "images identiques" : "images différentes") << std::endl;
+    return identiques ? 0 : 1;
+}
+
+#endif // SANS_SDL
+
+/**
+ * @brief Mode `--bancs` : voir executerBancs().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si succès.
+ */
+int modeBancs(const std::vector<std::string>& arguments) {
+    const size_t repetitions = static_cast<size_t>(std::max(1, argumentEntier(arguments, 1, 10)));
+    return executerBancs(argumentTexte(arguments, 0, "bancs.json"), repetitions, argumentTexte(arguments, 2, ""));
+}
+
+/**
+ * @brief Mode `--regression` : voir verifierRegression().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si la vérification réussit (ou après génération), 1 si des
+ *         images diffèrent ou manquent, 2 si seul le débit est insuffisant.
+ */
+int modeRegression(const std::vector<std::string>& arguments) {
+    OptionsRegression options;
+    options.taille = argumentEntier(arguments, 2, options.taille);
+    options.ecartsDebit = argumentReel(arguments, 3, options.ecartsDebit);
+    options.toleranceDifferences = argumentReel(arguments, 4, options.toleranceDifferences);
+    return verifierRegression(arguments[0], argumentTexte(arguments, 1, "verifier"), options);
+}
+
+/**
+ * @brief Mode `--allocations` : voir verifierAllocations().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si aucun rendu n'a alloué, 1 sinon.
+ */
+int modeAllocations(const std::vector<std::string>& arguments) {
+    return verifierAllocations(listeTailles(argumentTexte(arguments, 0, "64,256,600")));
+}
+
+/**
+ * @brief Mode `--pool` : voir mesurerPool().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si les deux chemins donnent les mêmes pixels, 1 sinon.
+ */
+int modePool(const std::vector<std::string>& arguments) {
+    const int repetitions = std::max(1, argumentEntier(arguments, 0, 20));
+    return mesurerPool(repetitions, argumentOctets(arguments, 1, 64 * 1024 * 1024));
+}
+
+#ifndef SANS_SDL
+
+/**
+ * @brief Mode `--mesure-affichage` : voir mesurerAffichage().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si les images sont identiques (ou non relisibles), 1 sinon.
+ */
+int modeMesureAffichage(const std::vector<std::string>& arguments) {
+    return mesurerAffichage(std::max(1, argumentEntier(arguments, 0, 20)));
+}
+
+#endif // SANS_SDL
@@ -0,0 +1,136 @@
+#include "AtlasGlyphes.h"
+#include "Modes.h"
+#include "Netpbm.h"
+#include "Rendu.h"
+#include "RenduLot.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+
+/**
+ * @brief Dessine des lettres sans affichage et les enregistre au format Netpbm binaire.
+ * 
+ * N'utilise que le moteur de rendu : aucun sous-système vidéo n'est
+ * initialisé. Chaque lettre est écrite dans `<prefixe><lettre>.pbm`
+ * (ou `.pgm` en style lissé, `.ppm` en couleur, voir Netpbm::formatNaturel()).
+ * Affiche la durée et la mémoire des contours aplatis conservés par le rendu.
+ * 
+ * @param lettres Les lettres à dessiner.
+ * @param style Style de rendu.
+ * @param taille Hauteur des rendus en pixels.
+ * @param prefixe Préfixe des fichiers produits.
+ * @return int 0 si succès.
+ */
+static int rendreSansAffichage(const std::string& lettres, StyleRendu style, int taille, const std::string& prefixe) {
+    const auto debut = std::chrono::steady_clock::now();
+    Rendu rendu;
+    Bitmap bitmap = Rendu::creerBitmap(style, taille);
+    for (char lettre : lettres) {
+        lettre = static_cast<char>(std::toupper(static_cast<unsigned char>(lettre)));
+        rendu.rendreLettre(lettre, style, taille, bitmap);
+        const FormatNetpbm format = Netpbm::formatNaturel(bitmap);
+        Netpbm::ecrire(bitmap, prefixe + lettre + Netpbm::extension(format), format);
+    }
+    const std::chrono::duration<double, std::micro> duree = std::chrono::steady_clock::now() - debut;
+    std::cout << lettres.size() << " lettre(s) rendue(s) en " << duree.count() << " µs, contours aplatis en cache : "
+              << rendu.getMemoireAplatissements() << " octets" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Rend toutes les lettres, dans les trois styles des polices, à plusieurs tailles.
+ * 
+ * Le travail est réparti sur un groupe de threads (un par cœur par défaut) ;
+ * affiche le débit et le temps passé dans chaque étape.
+ * 
+ * @param tailles Tailles des rendus en pixels.
+ * @param dossier Dossier de sortie.
+ * @param nbThreads Nombre de threads (0 : un par cœur).
+ * @return int 0 si succès.
+ */
+static int rendreLot(const std::vector<int>& tailles, const std::string& dossier, size_t nbThreads) {
+    const RenduLot lot(tailles, {StyleRendu::Contour, StyleRendu::RempliGras, StyleRendu::ContourRouge}, dossier);
+    PoolThreads pool(nbThreads);
+    const StatistiquesLot mesures = lot.executer(pool);
+
+    const double parGlyphe = 1e6 / std::max<size_t>(1, mesures.nbGlyphes);
+    std::cout << mesures.nbGlyphes << " glyphes en " << mesures.duree * 1e3 << " ms sur "
+              << pool.getNbThreads() << " thread(s) : " << mesures.nbGlyphes / mesures.duree << " glyphes/s" << std::endl;
+    std::cout << "Temps cumulé par étape (moyenne par glyphe) :" << std::endl;
+    std::cout << "  génération    : " << mesures.generation * 1e3 << " ms (" << mesures.generation * parGlyphe << " µs)" << std::endl;
+    std::cout << "  aplatissement : " << mesures.aplatissement * 1e3 << " ms (" << mesures.aplatissement * parGlyphe << " µs)" << std::endl;
+    std::cout << "  rastérisation : " << mesures.rasterisation * 1e3 << " ms (" << mesures.rasterisation * parGlyphe << " µs)" << std::endl;
+    std::cout << "  encodage      : " << mesures.encodage * 1e3 << " ms (" << mesures.encodage * parGlyphe << " µs)" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Construit l'atlas des lettres dans les trois styles des polices et l'enregistre.
+ * 
+ * Écrit le bloc sérialisé dans `fichier` et un aperçu Netpbm à côté, affiche
+ * la taille et le remplissage de l'atlas, puis relit le fichier et vérifie
+ * que le bloc relu est identique.
+ * 
+ * @param lettres Les lettres à rendre.
+ * @param taille Hauteur des rendus en pixels.
+ * @param fichier Chemin du bloc sérialisé.
+ * @return int 0 si le bloc relu est identique, 1 sinon.
+ */
+static int construireAtlas(const std::string& lettres, int taille, const std::string& fichier) {
+    const auto debut = std::chrono::steady_clock::now();
+    const AtlasGlyphes atlas(lettres, {StyleRendu::Contour, StyleRendu::RempliGras, StyleRendu::ContourRouge}, taille);
+    const std::chrono::duration<double, std::milli> duree = std::chrono::steady_clock::now() - debut;
+
+    atlas.ecrire(fichier);
+    const FormatNetpbm format = Netpbm::formatNaturel(atlas.getBitmap());
+    Netpbm::ecrire(atlas.getBitmap(), fichier + Netpbm::extension(format), format);
+
+    size_t octetsCellules = 0;
+    for (const MetriqueGlyphe& metrique : atlas.getMetriques()) {
+        octetsCellules += static_cast<size_t>(Rendu::largeur(metrique.style, taille)) * taille;
+    }
+    const std::vector<uint8_t> bloc = atlas.serialiser();
+    std::cout << atlas.getMetriques().size() << " glyphes en " << duree.count() << " ms, atlas "
+              << atlas.getBitmap().getWidth() << "x" << atlas.getBitmap().getHeight() << std::endl;
+    std::cout << "  bloc          : " << bloc.size() << " octets (cellules complètes en 8 bits : "
+              << octetsCellules << " octets)" << std::endl;
+    std::cout << "  remplissage   : " << atlas.getTauxRemplissage() * 100 << " %" << std::endl;
+
+    const bool identique = AtlasGlyphes::lire(fichier).serialiser() == bloc;
+    std::cout << "  relecture     : " << (identique ? "bloc identique" : "bloc différent") << std::endl;
+    return identique ? 0 : 1;
+}
+
+/**
+ * @brief Mode `--rendu` : voir rendreSansAffichage().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si succès.
+ */
+int modeRendu(const std::vector<std::string>& arguments) {
+    const StyleRendu style = Rendu::styleDepuisNom(argumentTexte(arguments, 1, "contour"));
+    const int taille = argumentEntier(arguments, 2, Rendu::TAILLE_DESSIN);
+    return rendreSansAffichage(arguments[0], style, taille, argumentTexte(arguments, 3, "lettre_"));
+}
+
+/**
+ * @brief Mode `--lot` : voir rendreLot().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si succès.
+ */
+int modeLot(const std::vector<std::string>& arguments) {
+    const size_t nbThreads = static_cast<size_t>(std::max(0, argumentEntier(arguments, 2, 0)));
+    return rendreLot(listeTailles(arguments[0]), argumentTexte(arguments, 1, "lot"), nbThreads);
+}
+
+/**
+ * @brief Mode `--atlas` : voir construireAtlas().
+ * 
+ * @param arguments Arguments qui suivent l'option.
+ * @return int 0 si le bloc relu est identique, 1 sinon.
+ */
+int modeAtlas(const std::vector<std::string>& arguments) {
+    return construireAtlas(arguments[0], argumentEntier(arguments, 1, 64), argumentTexte(arguments, 2, "atlas.bin"));
+}
@@ -0,0 +1,272 @@
+#include "Morphologie.h"
+#include "Trace.h"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+/**
+ * @brief Vérifie que la source et la destination sont compatibles.
+ * 
+ * @param source Le bitmap source.
+ * @param rayon Le rayon demandé.
+ * @param destination Le bitmap destination.
+ * 
+ * @throws std::invalid_argument Si les tailles diffèrent ou si le rayon est négatif.
+ */
+static void verifierDilatation(const Bitmap& source, int rayon, const Bitmap& destination) {
+    if (source.getWidth() != destination.getWidth() || source.getHeight() != destination.getHeight()) {
+        throw std::invalid_argument("La source et la destination doivent avoir la même taille.");
+    }
+    if (rayon < 0) {
+        throw std::invalid_argument("Le rayon de dilatation doit être positif.");
+    }
+}
+
+/**
+ * @brief Lit un pixel comme une intensité de 0 à 255.
+ * 
+ * @param bitmap Le bitmap lu.
+ * @param ligne Ligne brute du bitmap.
+ * @param x Coordonnée X du pixel.
+ * @return uint8_t 255 pour un pixel encré (ou sa couverture en Coverage8), 0 sinon.
+ */
+static uint8_t lireIntensite(const Bitmap& bitmap, const uint8_t* ligne, int x) {
+    const int valeur = bitmap.getPixelRaw(ligne, x);
+    if (bitmap.getFormat() == PixelFormat::Coverage8) {
+        return static_cast<uint8_t>(valeur);
+    }
+    return valeur ? 255 : 0;
+}
+
+/**
+ * @brief Écrit une intensité de 0 à 255 dans un pixel.
+ * 
+ * @param bitmap Le bitmap écrit.
+ * @param ligne Ligne brute du bitmap.
+ * @param x Coordonnée X du pixel.
+ * @param intensite Intensité à écrire.
+ */
+static void ecrireIntensite(Bitmap& bitmap, uint8_t* ligne, int x, uint8_t intensite) {
+    if (bitmap.getFormat() == PixelFormat::Coverage8) {
+        ligne[x] = intensite;
+    } else {
+        bitmap.setPixelRaw(ligne, x, intensite ? 1 : 0);
+    }
+}
+
+/**
+ * @brief Filtre maximum de van Herk / Gil-Werman sur une suite d'octets.
+ * 
+ * La suite complétée (rayon zéros avant, des zéros après jusqu'à un nombre
+ * entier de blocs de k = 2 rayon + 1) est découpée en blocs : g est le maximum
+ * cumulé depuis le début du bloc, h depuis la fin. Toute fenêtre de k
+ * éléments est la réunion de la fin d'un bloc et du début du suivant, d'où
+ * sortie[i] = max(h[i], g[i + 2 rayon]) en indices complétés : trois maxima
+ * par élément, indépendamment du rayon.
+ * 
+ * @param complete Suite complétée, de longueur multiple de k.
+ * @param total Longueur de la suite complétée.
+ * @param n Nombre d'éléments de sortie.
+ * @param rayon Demi-largeur de la fenêtre.
+ * @param g Tampon de travail de `total` octets.
+ * @param h Tampon de travail de `total` octets.
+ * @param sortie Les n valeurs filtrées.
+ */
+static void maximumGlissant(const uint8_t* complete, int total, int n, int rayon,
+                            uint8_t* g, uint8_t* h, uint8_t* sortie) {
+    const int k = 2 * rayon + 1;
+    for (int b = 0; b < total; b += k) {
+        g[b] = complete[b];
+        for (int i = b + 1; i < b + k; ++i) {
+            g[i] = std::max(g[i - 1], complete[i]);
+        }
+        h[b + k - 1] = complete[b + k - 1];
+        for (int i = b + k - 2; i >= b; --i) {
+            h[i] = std::max(h[i + 1], complete[i]);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        sortie[i] = std::max(h[i], g[i + 2 * rayon]);
+    }
+}
+
+/**
+ * @brief Même filtre sur une suite de vecteurs, composante par composante.
+ * 
+ * Appliqué aux lignes d'une image (vecteurs de `largeur` octets), il réalise
+ * la passe verticale en parcourant la mémoire ligne par ligne ; les boucles
+ * internes sur les composantes se vectorisent.
+ * 
+ * @param complete Vecteurs complétés, contigus, en nombre multiple de k.
+ * @param total Nombre de vecteurs complétés.
+ * @param n Nombre de vecteurs de sortie.
+ * @param largeur Nombre d'octets par vecteur.
+ * @param rayon Demi-largeur de la fenêtre.
+ * @param g Tampon de travail de total * largeur octets.
+ * @param h Tampon de travail de total * largeur octets.
+ * @param sortie Les n vecteurs filtrés, contigus.
+ */
+static void maximumGlissantVecteurs(const uint8_t* complete, int total, int n, size_t largeur, int rayon,
+                                    uint8_t* g, uint8_t* h, uint8_t* sortie) {
+    const int k = 2 * rayon + 1;
+    for (int b = 0; b < total; b += k) {
+        std::copy(complete + b * largeur, complete + (b + 1) * largeur, g + b * largeur);
+        for (int i = b + 1; i < b + k; ++i) {
+            const uint8_t* precedent = g + (i - 1) * largeur;
+            const uint8_t* entree = complete + i * largeur;
+            uint8_t* gi = g + i * largeur;
+            for (size_t j = 0; j < largeur; ++j) {
+                gi[j] = std::max(precedent[j], entree[j]);
+            }
+        }
+        const int dernier = b + k - 1;
+        std::copy(complete + dernier * largeur, complete + (dernier + 1) * largeur, h + dernier * largeur);
+        for (int i = dernier - 1; i >= b; --i) {
+            const uint8_t* suivant = h + (i + 1) * largeur;
+            const uint8_t* entree = complete + i * largeur;
+            uint8_t* hi = h + i * largeur;
+            for (size_t j = 0; j < largeur; ++j) {
+                hi[j] = std::max(suivant[j], entree[j]);
+            }
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        const uint8_t* hi = h + i * largeur;
+        const uint8_t* gi = g + (i + 2 * rayon) * largeur;
+        uint8_t* si = sortie + i * largeur;
+        for (size_t j = 0; j < largeur; ++j) {
+            si[j] = std::max(hi[j], gi[j]);
+        }
+    }
+}
+
+/**
+ * @brief Dilate un bitmap 1 bit par un carré, 64 pixels par opération.
+ * 
+ * Le OU d'une fenêtre de rayon + 1 pixels est obtenu par doublements
+ * successifs : après a |= a décalé de 1, 2, 4..., chaque bit couvre une
+ * fenêtre deux fois plus large, et un dernier décalage complète la fenêtre ;
+ * soit log2(rayon + 1) décalages-OU de lignes entières. Une fenêtre vers
+ * l'avant puis une vers l'arrière couvrent [x - rayon, x + rayon]. La passe
+ * verticale fait de même avec des lignes entières de mots. Tout se fait sur
+ * place dans la destination.
+ * 
+ * @param source Le bitmap à dilater (Bit1).
+ * @param rayon Demi-côté du carré.
+ * @param destination Bitmap Bit1 recevant le résultat.
+ */
+static void dilaterCarreBits(const Bitmap& source, int rayon, Bitmap& destination) {
+    const int hauteur = destination.getHeight();
+    const int nbMots = destination.getWordsPerRow();
+    const uint64_t masqueLargeur = ~0ULL >> (63 - ((destination.getWidth() - 1) & 63));
+
+    // Passe horizontale
+    for (int y = 0; y < hauteur; ++y) {
+        uint64_t* mots = destination.rowWords(y);
+        std::copy(source.rowWords(y), source.rowWords(y) + nbMots, mots);
+        for (int couvert = 1; couvert <= rayon;) {
+            const int pas = std::min(couvert, rayon + 1 - couvert);
+            // Vers l'avant, par mots croissants : readBits ne consulte que des mots d'indice >= j, encore intacts
+            for (int j = 0; j < nbMots; ++j) {
+                mots[j] |= Bitmap::readBits(mots, nbMots, 64LL * j + pas);
+            }
+            couvert += pas;
+        }
+        for (int couvert = 1; couvert <= rayon;) {
+            const int pas = std::min(couvert, rayon + 1 - couvert);
+            // Vers l'arrière, par mots décroissants
+            for (int j = nbMots - 1; j >= 0; --j) {
+                mots[j] |= Bitmap::readBits(mots, nbMots, 64LL * j - pas);
+            }
+            couvert += pas;
+        }
+        mots[nbMots - 1] &= masqueLargeur;
+    }
+
+    // Passe verticale, même principe sur des lignes entières
+    for (int couvert = 1; couvert <= rayon;) {
+        const int pas = std::min(couvert, rayon + 1 - couvert);
+        for (int y = 0; y + pas < hauteur; ++y) {
+            uint64_t* mots = destination.rowWords(y);
+            const uint64_t* dessous = destination.rowWords(y + pas);
+            for (int j = 0; j < nbMots; ++j) {
+                mots[j] |= dessous[j];
+            }
+        }
+        couvert += pas;
+    }
+    for (int couvert = 1; couvert <= rayon;) {
+        const int pas = std::min(couvert, rayon + 1 - couvert);
+        for (int y = hauteur - 1; y - pas >= 0; --y) {
+            uint64_t* mots = destination.rowWords(y);
+            const uint64_t* dessus = destination.rowWords(y - pas);
+            for (int j = 0; j < nbMots; ++j) {
+                mots[j] |= dessus[j];
+            }
+        }
+        couvert += pas;
+    }
+}
+
+/**
+ * @brief Dilate un bitmap par un carré, en deux passes séparées.
+ * 
+ * Entre deux bitmaps Bit1, les passes opèrent sur des mots de 64 pixels
+ * (voir dilaterCarreBits()). Sinon, seule la boîte englobante de l'encre, élargie du rayon, est traitée ; le
+ * reste de la destination est effacé.
+ * 
+ * @param source Le bitmap à dilater.
+ * @param rayon Demi-côté du carré.
+ * @param destination Bitmap recevant le résultat.
+ */
+void Morphologie::dilaterCarre(const Bitmap& source, int rayon, Bitmap& destination) {
+    TRACE_PORTEE("Morphologie::dilaterCarre");
+    verifierDilatation(source, rayon, destination);
+    TRACE_PIXELS(static_cast<uint64_t>(destination.getWidth()) * destination.getHeight());
+    if (source.getFormat() == PixelFormat::Bit1 && destination.getFormat() == PixelFormat::Bit1) {
+        dilaterCarreBits(source, rayon, destination);
+        return;
+    }
+    destination.clear();
+
+    int bx0, by0, bx1, by1;
+    if (!source.getInkBounds(bx0, by0, bx1, by1)) {
+        return;
+    }
+    const int x0 = std::max(0, bx0 - rayon);
+    const int y0 = std::max(0, by0 - rayon);
+    const int largeur = std::min(source.getWidth() - 1, bx1 + rayon) - x0 + 1;
+    const int hauteur = std::min(source.getHeight() - 1, by1 + rayon) - y0 + 1;
+    const int k = 2 * rayon + 1;
+    const size_t w = static_cast<size_t>(largeur);
+
+    // Image de la zone, complétée de `rayon` lignes vides au-dessus et de lignes vides en dessous
+    const int totalLignes = ((hauteur + 2 * rayon + k - 1) / k) * k;
+    std::vector<uint8_t> image(totalLignes * w, 0);
+
+    // Passe horizontale, directement depuis la source
+    const int totalColonnes = ((largeur + 2 * rayon + k - 1) / k) * k;
+    std::vector<uint8_t> complete(totalColonnes, 0), g(totalColonnes), h(totalColonnes);
+    for (int y = 0; y < hauteur; ++y) {
+        const uint8_t* ligne = source.row(y0 + y);
+        for (int x = 0; x < largeur; ++x) {
+            complete[rayon + x] = lireIntensite(source, ligne, x0 + x);
+        }
+        maximumGlissant(complete.data(), totalColonnes, largeur, rayon, g.data(), h.data(),
+                        image.data() + (rayon + y) * w);
+    }
+
+    // Passe verticale sur les lignes entières
+    std::vector<uint8_t> gc(totalLignes * w), hc(totalLignes * w), resultat(hauteur * w);
+    maximumGlissantVecteurs(image.data(), totalLignes, hauteur, w, rayon, gc.data(), hc.data(), resultat.data());
+
+    for (int y = 0; y < hauteur; ++y) {
+        uint8_t* ligne = destination.row(y0 + y);
+        const uint8_t* valeurs = resultat.data() + y * w;
+        for (int x = 0; x < largeur; ++x) {
+            if (valeurs[x]) {
+                ecrireIntensite(destination, ligne, x0 + x, valeurs[x]);
+            }
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef MORPHOLOGIE_H
+#define MORPHOLOGIE_H
+
+#include "Bitmap.h"
+
+/**
+ * @brief Opérations de morphologie mathématique sur les bitmaps.
+ * 
+ * La dilatation a un coût proportionnel au nombre de pixels, quel que soit
+ * le rayon : le carré est séparé en une passe par ligne et une passe par
+ * colonne d'un filtre maximum de van Herk / Gil-Werman. Entre deux bitmaps
+ * Bit1, le carré est calculé par décalages et OU logiques sur des mots de
+ * 64 pixels.
+ */
+class Morphologie {
+public:
+    /**
+     * @brief Dilate un bitmap par un carré de côté 2 rayon + 1.
+     * 
+     * Un pixel de la destination est encré si au moins un pixel de la source
+     * est encré dans le carré centré sur lui ; en Coverage8, la destination
+     * reçoit le maximum des couvertures du carré.
+     * 
+     * @param source Le bitmap à dilater.
+     * @param rayon Demi-côté du carré (0 : simple copie).
+     * @param destination Bitmap de même taille recevant le résultat (entièrement réécrit).
+     * 
+     * @throws std::invalid_argument Si les tailles diffèrent ou si le rayon est négatif.
+     */
+    static void dilaterCarre(const Bitmap& source, int rayon, Bitmap& destination);
+};
+
+#endif
@@ -0,0 +1,421 @@
+#include "Netpbm.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ios>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using Fichier = std::unique_ptr<FILE, int (*)(FILE*)>;
+
+/**
+ * @brief Ouvre un fichier, en lecture ou en écriture binaire.
+ * 
+ * @param chemin Chemin du fichier.
+ * @param mode Mode d'ouverture de fopen().
+ * @return Fichier Le fichier ouvert, fermé à la destruction.
+ * 
+ * @throws std::ios_base::failure Si le fichier ne peut pas être ouvert.
+ */
+static Fichier ouvrir(const std::string& chemin, const char* mode) {
+    Fichier fichier(std::fopen(chemin.c_str(), mode), &std::fclose);
+    if (!fichier) {
+        throw std::ios_base::failure("Impossible d'ouvrir le fichier : " + chemin);
+    }
+    return fichier;
+}
+
+/**
+ * @brief Tampon d'écriture vidé par blocs de Netpbm::TAILLE_TAMPON octets.
+ * 
+ * Le fichier n'a pas de tampon propre : chaque vidage est un seul appel
+ * système, et les lignes sont encodées directement dans le tampon.
+ */
+class Sortie {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param fichier Fichier de destination.
+     * @param chemin Chemin du fichier, pour les messages d'erreur.
+     */
+    Sortie(FILE* fichier, const std::string& chemin)
+        : fichier(fichier), chemin(chemin), tampon(Netpbm::TAILLE_TAMPON) {
+        std::setvbuf(fichier, nullptr, _IONBF, 0);
+    }
+
+    /**
+     * @brief Réserve de la place à la fin du tampon, en le vidant si nécessaire.
+     * 
+     * @param taille Nombre d'octets à écrire.
+     * @return uint8_t* Zone de `taille` octets à remplir.
+     */
+    uint8_t* reserver(size_t taille) {
+        if (utilise + taille > tampon.size()) {
+            vider();
+            if (taille > tampon.size()) {
+                tampon.resize(taille); // Ligne plus longue que le tampon
+            }
+        }
+        uint8_t* zone = tampon.data() + utilise;
+        utilise += taille;
+        return zone;
+    }
+
+    /**
+     * @brief Écrit le contenu du tampon dans le fichier.
+     * 
+     * @throws std::ios_base::failure Si l'écriture échoue.
+     */
+    void vider() {
+        if (utilise > 0 && std::fwrite(tampon.data(), 1, utilise, fichier) != utilise) {
+            throw std::ios_base::failure("Erreur d'écriture dans le fichier : " + chemin);
+        }
+        utilise = 0;
+    }
+
+private:
+    FILE* fichier;                 ///< Fichier de destination.
+    const std::string& chemin;     ///< Chemin du fichier.
+    std::vector<uint8_t> tampon;   ///< Octets en attente d'écriture.
+    size_t utilise = 0;            ///< Nombre d'octets en attente.
+};
+
+/**
+ * @brief Table d'inversion de l'ordre des bits d'un octet.
+ * 
+ * Bit1 range le pixel x dans le bit de poids faible, P4 dans le bit de poids fort.
+ * 
+ * @return Un tableau de 256 octets.
+ */
+static const uint8_t* inversionBits() {
+    struct Table {
+        uint8_t octets[256];
+        Table() {
+            for (int i = 0; i < 256; ++i) {
+                uint8_t inverse = 0;
+                for (int b = 0; b < 8; ++b) {
+                    inverse |= static_cast<uint8_t>(((i >> b) & 1) << (7 - b));
+                }
+                octets[i] = inverse;
+            }
+        }
+    };
+    static const Table table;
+    return table.octets;
+}
+
+/**
+ * @brief Écrit un bitmap dans un fichier Netpbm binaire.
+ * 
+ * @param bitmap Le bitmap à écrire.
+ * @param chemin Chemin du fichier.
+ * @param format Format du fichier.
+ */
+void Netpbm::ecrire(const Bitmap& bitmap, const std::string& chemin, FormatNetpbm format) {
+    TRACE_PORTEE("Netpbm::ecrire");
+    const int largeur = bitmap.getWidth();
+    const int hauteur = bitmap.getHeight();
+    Fichier fichier = ouvrir(chemin, "wb");
+    Sortie sortie(fichier.get(), chemin);
+
+    static const char* const MAGIQUES[] = {"P4", "P5", "P6"};
+    char entete[64];
+    const int tailleEntete = std::snprintf(entete, sizeof(entete), format == FormatNetpbm::PBM ? "%s\n%d %d\n" : "%s\n%d %d\n255\n",
+                                           MAGIQUES[static_cast<int>(format)], largeur, hauteur);
+    std::memcpy(sortie.reserver(static_cast<size_t>(tailleEntete)), entete, static_cast<size_t>(tailleEntete));
+
+    const size_t octetsPbm = (static_cast<size_t>(largeur) + 7) / 8;
+    std::vector<uint32_t> couleurs(bitmap.getFormat() == PixelFormat::Bit1 && format == FormatNetpbm::PBM ? 0 : largeur);
+
+    for (int y = 0; y < hauteur; ++y) {
+        if (format == FormatNetpbm::PBM && bitmap.getFormat() == PixelFormat::Bit1) {
+            // Même disposition qu'en mémoire, à l'ordre des bits près
+            const uint8_t* inversion = inversionBits();
+            const uint8_t* ligne = bitmap.row(y);
+            uint8_t* destination = sortie.reserver(octetsPbm);
+            for (size_t i = 0; i < octetsPbm; ++i) {
+                destination[i] = inversion[ligne[i]];
+            }
+            if (largeur & 7) {
+                destination[octetsPbm - 1] &= static_cast<uint8_t>(0xFF00u >> (largeur & 7)); // Bits de remplissage à zéro
+            }
+            continue;
+        }
+
+        bitmap.rowToARGB(y, couleurs.data());
+        switch (format) {
+        case FormatNetpbm::PBM: {
+            uint8_t* destination = sortie.reserver(octetsPbm);
+            std::memset(destination, 0, octetsPbm);
+            for (int x = 0; x < largeur; ++x) {
+                if (couleurs[x] != 0xFFFFFFFFu) {
+                    destination[x >> 3] |= static_cast<uint8_t>(0x80u >> (x & 7));
+                }
+            }
+            break;
+        }
+        case FormatNetpbm::PGM: {
+            uint8_t* destination = sortie.reserver(static_cast<size_t>(largeur));
+            for (int x = 0; x < largeur; ++x) {
+                const uint32_t c = couleurs[x];
+                // Luminance entière : exacte pour les gris (77 + 150 + 29 = 256)
+                destination[x] = static_cast<uint8_t>((77u * ((c >> 16) & 0xFFu) + 150u * ((c >> 8) & 0xFFu) + 29u * (c & 0xFFu)) >> 8);
+            }
+            break;
+        }
+        case FormatNetpbm::PPM: {
+            uint8_t* destination = sortie.reserver(static_cast<size_t>(largeur) * 3);
+            for (int x = 0; x < largeur; ++x, destination += 3) {
+                const uint32_t c = couleurs[x];
+                destination[0] = static_cast<uint8_t>(c >> 16);
+                destination[1] = static_cast<uint8_t>(c >> 8);
+                destination[2] = static_cast<uint8_t>(c);
+            }
+            break;
+        }
+        }
+    }
+    sortie.vider();
+
+    if (std::fclose(fichier.release()) != 0) {
+        throw std::ios_base::failure("Erreur d'écriture dans le fichier : " + chemin);
+    }
+}
+
+/**
+ * @brief Choisit le format le plus compact qui conserve toutes les couleurs d'un bitmap.
+ * 
+ * @param bitmap Le bitmap à écrire.
+ * @return FormatNetpbm Le format choisi.
+ */
+FormatNetpbm Netpbm::formatNaturel(const Bitmap& bitmap) {
+    switch (bitmap.getFormat()) {
+    case PixelFormat::Bit1:
+        return FormatNetpbm::PBM;
+    case PixelFormat::Coverage8:
+        return FormatNetpbm::PGM;
+    case PixelFormat::Index8:
+        break;
+    }
+    for (int y = 0; y < bitmap.getHeight(); ++y) {
+        if (std::memchr(bitmap.row(y), 2, static_cast<size_t>(bitmap.getWidth()))) {
+            return FormatNetpbm::PPM; // Du rouge
+        }
+    }
+    return FormatNetpbm::PBM;
+}
+
+/**
+ * @brief Extension de fichier usuelle d'un format.
+ * 
+ * @param format Format Netpbm.
+ * @return L'extension, point compris.
+ */
+const char* Netpbm::extension(FormatNetpbm format) {
+    switch (format) {
+    case FormatNetpbm::PBM:
+        return ".pbm";
+    case FormatNetpbm::PGM:
+        return ".pgm";
+    case FormatNetpbm::PPM:
+        return ".ppm";
+    }
+    return "";
+}
+
+/**
+ * @brief Lecteur de l'en-tête et de la trame d'un fichier chargé en mémoire.
+ */
+struct Lecteur {
+    const std::vector<uint8_t>& octets;  ///< Contenu du fichier.
+    const std::string& chemin;           ///< Chemin du fichier, pour les messages d'erreur.
+    size_t position = 0;                 ///< Prochain octet à lire.
+
+    /**
+     * @brief Signale un fichier invalide.
+     * 
+     * @param message Description du problème.
+     */
+    [[noreturn]] void invalide(const char* message) const {
+        throw std::runtime_error(std::string("Fichier Netpbm invalide (") + message + ") : " + chemin);
+    }
+
+    /**
+     * @brief Saute les blancs et les commentaires.
+     */
+    void sauterBlancs() {
+        while (position < octets.size()) {
+            const uint8_t c = octets[position];
+            if (c == '#') {
+                while (position < octets.size() && octets[position] != '\n') {
+                    ++position;
+                }
+            } else if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f') {
+                ++position;
+            } else {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Lit un entier décimal positif de l'en-tête.
+     * 
+     * @return int L'entier lu.
+     */
+    int entier() {
+        sauterBlancs();
+        if (position >= octets.size() || octets[position] < '0' || octets[position] > '9') {
+            invalide("entier attendu");
+        }
+        long valeur = 0;
+        while (position < octets.size() && octets[position] >= '0' && octets[position] <= '9') {
+            valeur = valeur * 10 + (octets[position++] - '0');
+            if (valeur > 1000000) {
+                invalide("dimension trop grande");
+            }
+        }
+        return static_cast<int>(valeur);
+    }
+
+    /**
+     * @brief Vérifie qu'il reste assez d'octets pour la trame.
+     * 
+     * @param taille Taille attendue de la trame.
+     * @return const uint8_t* Début de la trame.
+     */
+    const uint8_t* trame(size_t taille) {
+        ++position; // Le blanc unique qui sépare l'en-tête de la trame
+        if (position > octets.size() || octets.size() - position < taille) {
+            throw std::ios_base::failure("Fichier tronqué : " + chemin);
+        }
+        return octets.data() + position;
+    }
+};
+
+/**
+ * @brief Lit un fichier Netpbm (P1, P4, P5 ou P6).
+ * 
+ * @param chemin Chemin du fichier.
+ * @return Bitmap Le bitmap lu.
+ */
+Bitmap Netpbm::lire(const std::string& chemin) {
+    std::vector<uint8_t> octets;
+    {
+        Fichier fichier = ouvrir(chemin, "rb");
+        uint8_t bloc[TAILLE_TAMPON];
+        size_t lus;
+        while ((lus = std::fread(bloc, 1, sizeof(bloc), fichier.get())) > 0) {
+            octets.insert(octets.end(), bloc, bloc + lus);
+        }
+        if (std::ferror(fichier.get())) {
+            throw std::ios_base::failure("Erreur de lecture du fichier : " + chemin);
+        }
+    }
+
+    Lecteur lecteur{octets, chemin};
+    if (octets.size() < 2 || octets[0] != 'P' || octets[1] < '1' || octets[1] > '6') {
+        lecteur.invalide("signature inconnue");
+    }
+    const char type = static_cast<char>(octets[1]);
+    if (type == '2' || type == '3') {
+        lecteur.invalide("format texte P2/P3 non pris en charge");
+    }
+    lecteur.position = 2;
+    const int largeur = lecteur.entier();
+    const int hauteur = lecteur.entier();
+    int maximum = 1;
+    if (type == '5' || type == '6') {
+        maximum = lecteur.entier();
+        if (maximum < 1 || maximum > 255) {
+            lecteur.invalide("valeur maximale hors de [1, 255]");
+        }
+    }
+
+    if (type == '1') {
+        Bitmap bitmap(largeur, hauteur, PixelFormat::Bit1);
+        for (int y = 0; y < hauteur; ++y) {
+            uint8_t* ligne = bitmap.row(y);
+            for (int x = 0; x < largeur; ++x) {
+                lecteur.sauterBlancs();
+                if (lecteur.position >= octets.size()) {
+                    throw std::ios_base::failure("Fichier tronqué : " + chemin);
+                }
+                const uint8_t c = octets[lecteur.position++];
+                if (c != '0' && c != '1') {
+                    lecteur.invalide("pixel P1 différent de 0 et 1");
+                }
+                bitmap.setPixelRaw(ligne, x, c - '0');
+            }
+        }
+        return bitmap;
+    }
+
+    if (type == '4') {
+        const size_t octetsLigne = (static_cast<size_t>(largeur) + 7) / 8;
+        const uint8_t* source = lecteur.trame(octetsLigne * hauteur);
+        const uint8_t* inversion = inversionBits();
+        Bitmap bitmap(largeur, hauteur, PixelFormat::Bit1);
+        for (int y = 0; y < hauteur; ++y, source += octetsLigne) {
+            uint8_t* ligne = bitmap.row(y);
+            for (size_t i = 0; i < octetsLigne; ++i) {
+                ligne[i] = inversion[source[i]];
+            }
+            if (largeur & 7) {
+                ligne[octetsLigne - 1] &= static_cast<uint8_t>((1u << (largeur & 7)) - 1); // Ignorer le remplissage
+            }
+        }
+        return bitmap;
+    }
+
+    // Gris (0 = noir) vers couverture (255 = noir), remis sur [0, 255]
+    uint8_t couverture[256];
+    for (int v = 0; v < 256; ++v) {
+        couverture[v] = static_cast<uint8_t>(255 - (std::min(v, maximum) * 255 + maximum / 2) / maximum);
+    }
+
+    if (type == '5') {
+        const uint8_t* source = lecteur.trame(static_cast<size_t>(largeur) * hauteur);
+        Bitmap bitmap(largeur, hauteur, PixelFormat::Coverage8);
+        for (int y = 0; y < hauteur; ++y, source += largeur) {
+            uint8_t* ligne = bitmap.row(y);
+            for (int x = 0; x < largeur; ++x) {
+                ligne[x] = couverture[source[x]];
+            }
+        }
+        return bitmap;
+    }
+
+    // P6 : indices de couleur si possible, sinon niveaux de gris
+    const size_t nbPixels = static_cast<size_t>(largeur) * hauteur;
+    const uint8_t* source = lecteur.trame(nbPixels * 3);
+    bool indices = true;
+    bool gris = true;
+    for (size_t i = 0; i < nbPixels && (indices || gris); ++i) {
+        const uint8_t r = couverture[source[3 * i]], v = couverture[source[3 * i + 1]], b = couverture[source[3 * i + 2]];
+        gris = gris && r == v && v == b;
+        indices = indices && ((r == v && v == b && (r == 0 || r == 255)) || (r == 0 && v == 255 && b == 255));
+    }
+    if (!indices && !gris) {
+        lecteur.invalide("couleurs hors de la palette");
+    }
+
+    Bitmap bitmap(largeur, hauteur, indices ? PixelFormat::Index8 : PixelFormat::Coverage8);
+    for (int y = 0; y < hauteur; ++y) {
+        uint8_t* ligne = bitmap.row(y);
+        for (int x = 0; x < largeur; ++x, source += 3) {
+            const uint8_t r = couverture[source[0]], v = couverture[source[1]];
+            if (!indices) {
+                ligne[x] = r;
+            } else if (r != v) {
+                ligne[x] = 2; // Rouge
+            } else {
+                ligne[x] = r ? 1 : 0;
+            }
+        }
+    }
+    return bitmap;
+}
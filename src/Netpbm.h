@@ -0,0 +1,79 @@
+#ifndef NETPBM_H
+#define NETPBM_H
+
+#include "Bitmap.h"
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Formats binaires Netpbm.
+ */
+enum class FormatNetpbm {
+    PBM,  ///< P4 : 1 bit par pixel, 8 pixels par octet (poids fort d'abord), 1 = noir.
+    PGM,  ///< P5 : 1 octet de gris par pixel, 0 = noir, 255 = blanc.
+    PPM   ///< P6 : 3 octets (rouge, vert, bleu) par pixel.
+};
+
+/**
+ * @brief Lecture et écriture de bitmaps aux formats Netpbm binaires.
+ * 
+ * Les écritures convertissent les lignes directement depuis le stockage du
+ * bitmap dans un tampon de TAILLE_TAMPON octets, vidé en un seul appel
+ * système lorsqu'il est plein : aucun formatage caractère par caractère, et
+ * aucun tampon de la taille de l'image. Les lectures chargent la trame en
+ * un seul bloc.
+ */
+class Netpbm {
+public:
+    /// Taille du tampon d'écriture, en octets.
+    static constexpr size_t TAILLE_TAMPON = 64 * 1024;
+
+    /**
+     * @brief Écrit un bitmap dans un fichier Netpbm binaire.
+     * 
+     * En PBM, tout pixel non blanc est noir. En PGM et PPM, les couleurs sont
+     * celles de Bitmap::toARGB() (en PGM, converties en luminance ; en
+     * Coverage8, le gris est 255 - couverture).
+     * 
+     * @param bitmap Le bitmap à écrire.
+     * @param chemin Chemin du fichier.
+     * @param format Format du fichier.
+     * 
+     * @throws std::ios_base::failure Si le fichier ne peut pas être créé ou écrit.
+     */
+    static void ecrire(const Bitmap& bitmap, const std::string& chemin, FormatNetpbm format);
+
+    /**
+     * @brief Choisit le format le plus compact qui conserve toutes les couleurs d'un bitmap.
+     * 
+     * @param bitmap Le bitmap à écrire.
+     * @return FormatNetpbm PBM pour Bit1 ou un Index8 noir et blanc, PGM pour
+     *         Coverage8, PPM pour un Index8 contenant d'autres couleurs.
+     */
+    static FormatNetpbm formatNaturel(const Bitmap& bitmap);
+
+    /**
+     * @brief Extension de fichier usuelle d'un format.
+     * 
+     * @param format Format Netpbm.
+     * @return ".pbm", ".pgm" ou ".ppm".
+     */
+    static const char* extension(FormatNetpbm format);
+
+    /**
+     * @brief Lit un fichier Netpbm (P1, P4, P5 ou P6).
+     * 
+     * P1 et P4 donnent un bitmap Bit1, P5 un bitmap Coverage8 (couverture
+     * 255 - gris). P6 donne un bitmap Index8 si toutes les couleurs sont
+     * blanc, noir ou rouge, ou Coverage8 si tous les pixels sont gris.
+     * 
+     * @param chemin Chemin du fichier.
+     * @return Bitmap Le bitmap lu.
+     * 
+     * @throws std::ios_base::failure Si le fichier ne peut pas être ouvert ou est tronqué.
+     * @throws std::runtime_error Si le contenu n'est pas un fichier Netpbm pris en charge.
+     */
+    static Bitmap lire(const std::string& chemin);
+};
+
+#endif // NETPBM_H
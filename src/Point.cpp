@@ -1,33 +1,5 @@
 #include "Point.h"
 
-/**
- * Constructeur du point.
- * Initialise les coordonnées x et y.
- */
-Point::Point(float x, float y) : x(x), y(y) {}
-
-/**
- * Destructeur du point.
- * Rien de particulier à gérer ici, mais inclus pour la complétude.
- */
-Point::~Point() {}
-
-/**
- * Getter pour la coordonnée X.
- * @return La valeur de X.
- */
-float Point::getX() const {
-    return x;
-}
-
-/**
- * Getter pour la coordonnée Y.
- * @return La valeur de Y.
- */
-float Point::getY() const {
-    return y;
-}
-
 /**
  * Setter pour la coordonnée X.
  * @param x La nouvelle valeur de X.
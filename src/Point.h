@@ -9,25 +9,21 @@ public:
     /**
      * Constructeur par défaut.
      * Initialise le point à (0, 0).
+     * Utilisable à la compilation : des tables de points peuvent être constexpr.
      */
-    Point(float x = 0.0f, float y = 0.0f);
-
-    /**
-     * Destructeur.
-     */
-    ~Point();
+    constexpr Point(float x = 0.0f, float y = 0.0f) : x(x), y(y) {}
 
     /**
      * Getter pour la coordonnée X.
      * @return La coordonnée X.
      */
-    float getX() const;
+    constexpr float getX() const { return x; }
 
     /**
      * Getter pour la coordonnée Y.
      * @return La coordonnée Y.
      */
-    float getY() const;
+    constexpr float getY() const { return y; }
 
     /**
      * Setter pour la coordonnée X.
@@ -20,22 +20,36 @@ public:
     Police1(int width, int height) : PoliceBase(width, height) {}
 
     /**
-     * @brief Affiche une lettre en utilisant la police 1.
+     * @brief Dessine une lettre en utilisant la police 1.
      * 
-     * Cette méthode génère un glyphe correspondant à la lettre spécifiée,
-     * dessine son contour sur un bitmap, puis affiche le résultat dans une
-     * fenêtre SDL.
+     * Cette méthode récupère le glyphe correspondant à la lettre spécifiée
+     * et dessine son contour sur un bitmap.
      * 
-     * @param lettre La lettre à afficher.
+     * @param lettre La lettre à dessiner.
+     * @return Bitmap Le bitmap contenant le contour de la lettre.
      */
-    void afficherLettre(char lettre) const override {
-        Bitmap bitmap(width, height);
-        Glyph glyph = generateGlyph(lettre);
-        glyph.drawContour(bitmap);
+    Bitmap dessinerLettre(char lettre) const override {
+        Bitmap bitmap(width, height, Rendu::formatPour(StyleRendu::Contour));
+        cache.dessiner(lettre, StyleRendu::Contour, height, bitmap);
+        return bitmap;
+    }
 
-        SDL sdl(width, height, std::string("Police 1 - ").append(1, lettre).c_str());
-        sdl.renderBitmap(bitmap);
-        sdl.mainLoop();
+    /**
+     * @brief Nom de la police 1.
+     * 
+     * @return "Police 1".
+     */
+    std::string getNom() const override {
+        return "Police 1";
+    }
+
+    /**
+     * @brief Style de rendu de la police 1.
+     * 
+     * @return StyleRendu::Contour.
+     */
+    StyleRendu getStyle() const override {
+        return StyleRendu::Contour;
     }
 };
 
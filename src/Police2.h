@@ -18,47 +18,37 @@ public:
     Police2(int width, int height) : PoliceBase(width, height) {}
 
     /**
-     * @brief Affiche une lettre en utilisant la police 2.
+     * @brief Dessine une lettre en utilisant la police 2.
      * 
-     * Cette méthode génère un glyphe pour la lettre spécifiée, dessine à la fois
-     * son intérieur rempli et sa version en gras, et les affiche côte à côte
-     * dans une même fenêtre SDL.
+     * Cette méthode récupère le glyphe de la lettre spécifiée, dessine à la fois
+     * son intérieur rempli et sa version en gras, et les place côte à côte
+     * dans un même bitmap.
      * 
-     * @param lettre La lettre à afficher.
+     * @param lettre La lettre à dessiner.
+     * @return Bitmap Le bitmap contenant les deux versions de la lettre.
      */
-    void afficherLettre(char lettre) const override {
-
-        Glyph glyph = generateGlyph(lettre);
-
-        // Créer un bitmap principal pour le rendu final
-        Bitmap bitmap(width, height);
-
-        // Créer des bitmaps temporaires pour le remplissage et le gras
-        Bitmap filledBitmap(width, height); 
-        Bitmap boldBitmap(width, height);  
-
-        // Dessiner la lettre remplie
-        glyph.drawFilled(filledBitmap);
-
-        // Dessiner la lettre en gras
-        glyph.drawBold(boldBitmap, 15);
+    Bitmap dessinerLettre(char lettre) const override {
+        Bitmap bitmap(width, height, Rendu::formatPour(StyleRendu::RempliGras));
+        cache.dessiner(lettre, StyleRendu::RempliGras, height, bitmap);
+        return bitmap;
+    }
 
-        // Copier les deux versions dans le bitmap principal
-        for (int y = 0; y < bitmap.getHeight(); ++y) {
-            for (int x = 0; x < (width / 2); ++x) {
-                if (filledBitmap.getPixel(x, y)) {
-                    bitmap.setPixel(x, y, 1); // Noir pour la partie remplie
-                }
-                if (boldBitmap.getPixel(x, y)) {
-                    bitmap.setPixel(x + (width / 2), y, 1); // Noir pour la partie en gras
-                }
-            }
-        }
+    /**
+     * @brief Nom de la police 2.
+     * 
+     * @return "Police 2".
+     */
+    std::string getNom() const override {
+        return "Police 2";
+    }
 
-        // Afficher le bitmap dans une fenêtre SDL
-        SDL sdl(width, height, std::string("Police 2 - ").append(1, lettre).c_str());
-        sdl.renderBitmap(bitmap);
-        sdl.mainLoop();
+    /**
+     * @brief Style de rendu de la police 2.
+     * 
+     * @return StyleRendu::RempliGras.
+     */
+    StyleRendu getStyle() const override {
+        return StyleRendu::RempliGras;
     }
 };
 
@@ -18,21 +18,36 @@ public:
     Police3(int width, int height) : PoliceBase(width, height) {}
 
     /**
-     * @brief Affiche une lettre en utilisant la police 3.
+     * @brief Dessine une lettre en utilisant la police 3.
      * 
-     * Cette méthode génère un glyphe pour la lettre spécifiée, applique un contour
-     * rouge épais à la lettre, et l'affiche dans une fenêtre SDL.
+     * Cette méthode récupère le glyphe de la lettre spécifiée et lui applique
+     * un contour rouge épais.
      * 
-     * @param lettre La lettre à afficher.
+     * @param lettre La lettre à dessiner.
+     * @return Bitmap Le bitmap contenant la lettre.
      */
-    void afficherLettre(char lettre) const override {
-        Bitmap bitmap(width, height);
-        Glyph glyph = generateGlyph(lettre);
-        glyph.drawWithRedOutline(bitmap, 15);
+    Bitmap dessinerLettre(char lettre) const override {
+        Bitmap bitmap(width, height, Rendu::formatPour(StyleRendu::ContourRouge));
+        cache.dessiner(lettre, StyleRendu::ContourRouge, height, bitmap);
+        return bitmap;
+    }
 
-        SDL sdl(width, height, std::string("Police 3 - ").append(1, lettre).c_str());
-        sdl.renderBitmap(bitmap);
-        sdl.mainLoop();
+    /**
+     * @brief Nom de la police 3.
+     * 
+     * @return "Police 3".
+     */
+    std::string getNom() const override {
+        return "Police 3";
+    }
+
+    /**
+     * @brief Style de rendu de la police 3.
+     * 
+     * @return StyleRendu::ContourRouge.
+     */
+    StyleRendu getStyle() const override {
+        return StyleRendu::ContourRouge;
     }
 };
 
@@ -1,23 +1,29 @@
 #ifndef POLICEBASE_H
 #define POLICEBASE_H
 
-#include "Glyph.h"
 #include "Bitmap.h"
-#include "Sdl.h"
-#include "GlyphGenerator.h"
+#include "CacheGlyphes.h"
+#include "PoolBitmaps.h"
+#include "Rendu.h"
+#include <string>
 
 /**
  * @brief Classe de base pour les différentes polices de caractères.
  * 
  * Cette classe définit une interface commune pour afficher des lettres
  * dans différents styles de police. Les classes dérivées doivent implémenter
- * la méthode abstraite `afficherLettre`.
+ * les méthodes abstraites `dessinerLettre` et `getNom`. Le dessin ne dépend
+ * d'aucune bibliothèque d'affichage ; l'affichage SDL est assuré par la
+ * classe SDL (voir SDL::queueLetter()).
  */
 class PoliceBase {
 protected:
     int width;   ///< Largeur du bitmap.
     int height;  ///< Hauteur du bitmap.
 
+    /// Rendus déjà calculés : une lettre réaffichée n'est plus que copiée.
+    mutable CacheGlyphes cache;
+
 public:
     /**
      * @brief Constructeur de la classe PoliceBase.
@@ -37,14 +43,57 @@ public:
     virtual ~PoliceBase() = default;
 
     /**
-     * @brief Méthode abstraite pour afficher une lettre.
+     * @brief Mémoire occupée par les aplatissements des glyphes de la police.
+     * 
+     * @return size_t La mémoire, en octets (voir CacheGlyphes::getMemoireAplatissements()).
+     */
+    size_t getMemoireAplatissements() const {
+        return cache.getMemoireAplatissements();
+    }
+
+    /**
+     * @brief Méthode abstraite pour dessiner une lettre.
      * 
      * Cette méthode doit être implémentée par les classes dérivées pour dessiner
      * une lettre spécifique dans le style de police correspondant.
      * 
-     * @param lettre La lettre à afficher.
+     * @param lettre La lettre à dessiner.
+     * @return Bitmap Le bitmap (width x height) contenant la lettre.
+     */
+    virtual Bitmap dessinerLettre(char lettre) const = 0;
+
+    /**
+     * @brief Dessine une lettre dans un bitmap pris dans un pool.
+     * 
+     * Le bitmap (width x height) est pris blanc dans `pool` : il n'est ni
+     * alloué ni effacé, seule la boîte d'encre de la lettre est écrite. Une
+     * fois affiché, il se rend au pool avec cette boîte (PoolBitmaps::rendre()),
+     * qui est la seule zone à effacer.
+     * 
+     * @param lettre La lettre à dessiner.
+     * @param pool Pool fournissant le bitmap.
+     * @param zone Reçoit la boîte d'encre de la lettre dans le bitmap.
+     * @return Bitmap Le bitmap contenant la lettre, identique à celui de dessinerLettre().
+     */
+    Bitmap dessinerDansPool(char lettre, PoolBitmaps& pool, Rectangle& zone) const {
+        Bitmap bitmap = pool.prendre(width, height, Rendu::formatPour(getStyle()));
+        zone = cache.dessiner(lettre, getStyle(), height, bitmap, false);
+        return bitmap;
+    }
+
+    /**
+     * @brief Style de rendu de la police.
+     * 
+     * @return StyleRendu Le style.
+     */
+    virtual StyleRendu getStyle() const = 0;
+
+    /**
+     * @brief Nom de la police, utilisé dans le titre de la fenêtre.
+     * 
+     * @return Le nom de la police.
      */
-    virtual void afficherLettre(char lettre) const = 0;
+    virtual std::string getNom() const = 0;
 };
 
 #endif
@@ -0,0 +1,138 @@
+#include "PoolBitmaps.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstring>
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param budget Mémoire maximale des bitmaps libres, en octets.
+ */
+PoolBitmaps::PoolBitmaps(size_t budget) : budget(budget) {}
+
+/**
+ * @brief Donne un bitmap blanc, libre ou neuf.
+ * 
+ * @param largeur Largeur en pixels.
+ * @param hauteur Hauteur en pixels.
+ * @param format Format des pixels.
+ * @return Bitmap Le bitmap.
+ */
+Bitmap PoolBitmaps::prendre(int largeur, int hauteur, PixelFormat format) {
+    {
+        std::lock_guard<std::mutex> verrouPool(verrou);
+        // Le plus récemment rendu d'abord : ses pixels sont les plus chauds en cache
+        for (auto it = libres.rbegin(); it != libres.rend(); ++it) {
+            if (it->getWidth() == largeur && it->getHeight() == hauteur && it->getFormat() == format) {
+                Bitmap bitmap = std::move(*it);
+                libres.erase(std::next(it).base());
+                ++statistiques.succes;
+                --statistiques.entrees;
+                statistiques.octets -= bitmap.getSizeInBytes();
+                return bitmap;
+            }
+        }
+        ++statistiques.echecs;
+    }
+    return Bitmap(largeur, hauteur, format);
+}
+
+/**
+ * @brief Efface la zone modifiée d'un bitmap et le remet dans le pool.
+ * 
+ * @param bitmap Le bitmap.
+ * @param zoneModifiee Zone où des pixels ont pu être écrits.
+ */
+void PoolBitmaps::rendre(Bitmap&& bitmap, const Rectangle& zoneModifiee) {
+    TRACE_PORTEE("PoolBitmaps::rendre");
+    const size_t taille = bitmap.getSizeInBytes();
+    if (taille > budget) {
+        std::lock_guard<std::mutex> verrouPool(verrou);
+        ++statistiques.rejets;
+        return;
+    }
+
+    const int x0 = std::max(zoneModifiee.x, 0);
+    const int y0 = std::max(zoneModifiee.y, 0);
+    const int x1 = std::min(zoneModifiee.x + zoneModifiee.largeur, bitmap.getWidth()) - 1;
+    const int y1 = std::min(zoneModifiee.y + zoneModifiee.hauteur, bitmap.getHeight()) - 1;
+    size_t pixels = 0;
+    if (x0 <= x1 && y0 <= y1) {
+        if (x0 == 0 && x1 == bitmap.getWidth() - 1) {
+            // Lignes entières : un seul bloc contigu, bourrage de fin de ligne compris
+            std::memset(bitmap.row(y0), 0, static_cast<size_t>(y1 - y0 + 1) * bitmap.getStride());
+            TRACE_PIXELS(static_cast<size_t>(y1 - y0 + 1) * bitmap.getWidth());
+        } else {
+            for (int y = y0; y <= y1; ++y) {
+                bitmap.fillSpan(y, x0, x1, 0);
+            }
+        }
+        pixels = static_cast<size_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+
+    std::lock_guard<std::mutex> verrouPool(verrou);
+    statistiques.pixelsEffaces += pixels;
+    liberer(taille);
+    libres.push_back(std::move(bitmap));
+    ++statistiques.entrees;
+    statistiques.octets += taille;
+}
+
+/**
+ * @brief Efface la boîte d'encre d'un bitmap et le remet dans le pool.
+ * 
+ * @param bitmap Le bitmap.
+ */
+void PoolBitmaps::rendre(Bitmap&& bitmap) {
+    int x0, y0, x1, y1;
+    if (!bitmap.getInkBounds(x0, y0, x1, y1)) {
+        rendre(std::move(bitmap), Rectangle{0, 0, 0, 0});
+        return;
+    }
+    rendre(std::move(bitmap), Rectangle{x0, y0, x1 - x0 + 1, y1 - y0 + 1});
+}
+
+/**
+ * @brief Compteurs du pool.
+ * 
+ * @return StatistiquesPoolBitmaps Les compteurs.
+ */
+StatistiquesPoolBitmaps PoolBitmaps::getStatistiques() const {
+    std::lock_guard<std::mutex> verrouPool(verrou);
+    return statistiques;
+}
+
+/**
+ * @brief Mémoire maximale des bitmaps libres.
+ * 
+ * @return size_t Le budget.
+ */
+size_t PoolBitmaps::getBudget() const {
+    return budget;
+}
+
+/**
+ * @brief Abandonne tous les bitmaps libres.
+ */
+void PoolBitmaps::vider() {
+    std::lock_guard<std::mutex> verrouPool(verrou);
+    libres.clear();
+    statistiques.entrees = 0;
+    statistiques.octets = 0;
+}
+
+/**
+ * @brief Abandonne les bitmaps libres les plus anciens pour faire place à `octets`.
+ * 
+ * @param octets Mémoire à ajouter.
+ */
+void PoolBitmaps::liberer(size_t octets) {
+    size_t nb = 0;
+    while (nb < libres.size() && statistiques.octets + octets > budget) {
+        statistiques.octets -= libres[nb].getSizeInBytes();
+        ++nb;
+    }
+    libres.erase(libres.begin(), libres.begin() + nb);
+    statistiques.entrees -= nb;
+    statistiques.evictions += nb;
+}
@@ -0,0 +1,124 @@
+#ifndef POOL_BITMAPS_H
+#define POOL_BITMAPS_H
+
+#include "Bitmap.h"
+#include "Composition.h"
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+/**
+ * @brief Compteurs d'un pool de bitmaps.
+ */
+struct StatistiquesPoolBitmaps {
+    size_t succes = 0;          ///< Bitmaps servis depuis le pool.
+    size_t echecs = 0;          ///< Bitmaps construits faute de bitmap libre aux bonnes dimensions.
+    size_t evictions = 0;       ///< Bitmaps libres abandonnés pour respecter le budget.
+    size_t rejets = 0;          ///< Bitmaps rendus plus gros que le budget, abandonnés.
+    size_t entrees = 0;         ///< Bitmaps libres dans le pool.
+    size_t octets = 0;          ///< Mémoire des bitmaps libres.
+    size_t pixelsEffaces = 0;   ///< Pixels remis à blanc au retour des bitmaps.
+
+    /**
+     * @brief Part des demandes servies depuis le pool.
+     * 
+     * @return double Le taux, entre 0 et 1 (0 sans demande).
+     */
+    double tauxSucces() const {
+        const size_t demandes = succes + echecs;
+        return demandes == 0 ? 0.0 : static_cast<double>(succes) / demandes;
+    }
+};
+
+/**
+ * @brief Réserve de bitmaps blancs réutilisés d'un rendu à l'autre.
+ * 
+ * prendre() donne un bitmap blanc aux dimensions demandées : un bitmap libre
+ * du pool s'il y en a un, sinon un bitmap neuf. rendre() le remet dans le
+ * pool en n'effaçant que la zone modifiée pendant son usage (la boîte d'une
+ * lettre, par exemple) au lieu de tout le bitmap. Des rendus répétés à la
+ * même taille ne paient donc ni allocation ni effacement complet.
+ * 
+ * La mémoire des bitmaps libres est bornée par un budget : au-delà, les plus
+ * anciens sont abandonnés. Le pool est protégé par un verrou ; l'effacement
+ * a lieu hors du verrou.
+ */
+class PoolBitmaps {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param budget Mémoire maximale des bitmaps libres, en octets.
+     */
+    explicit PoolBitmaps(size_t budget = 64 * 1024 * 1024);
+
+    PoolBitmaps(const PoolBitmaps&) = delete;
+    PoolBitmaps& operator=(const PoolBitmaps&) = delete;
+
+    /**
+     * @brief Donne un bitmap blanc.
+     * 
+     * @param largeur Largeur en pixels.
+     * @param hauteur Hauteur en pixels.
+     * @param format Format des pixels.
+     * @return Bitmap Le bitmap, entièrement blanc.
+     * 
+     * @throws std::invalid_argument Si les dimensions sont invalides (comme Bitmap).
+     */
+    Bitmap prendre(int largeur, int hauteur, PixelFormat format = PixelFormat::Index8);
+
+    /**
+     * @brief Remet un bitmap dans le pool en effaçant la zone modifiée.
+     * 
+     * Les pixels hors de `zoneModifiee` doivent être restés blancs depuis
+     * prendre() : ils ne sont pas réexaminés. La zone est ramenée aux limites
+     * du bitmap.
+     * 
+     * @param bitmap Le bitmap, obtenu par prendre() ou alloué par la ressource par défaut.
+     * @param zoneModifiee Seule zone où des pixels ont pu être écrits.
+     */
+    void rendre(Bitmap&& bitmap, const Rectangle& zoneModifiee);
+
+    /**
+     * @brief Remet un bitmap dans le pool sans connaître la zone modifiée.
+     * 
+     * La zone effacée est la boîte d'encre du bitmap (Bitmap::getInkBounds()).
+     * 
+     * @param bitmap Le bitmap, obtenu par prendre() ou alloué par la ressource par défaut.
+     */
+    void rendre(Bitmap&& bitmap);
+
+    /**
+     * @brief Compteurs du pool.
+     * 
+     * @return StatistiquesPoolBitmaps Les compteurs.
+     */
+    StatistiquesPoolBitmaps getStatistiques() const;
+
+    /**
+     * @brief Mémoire maximale des bitmaps libres.
+     * 
+     * @return size_t Le budget, en octets.
+     */
+    size_t getBudget() const;
+
+    /**
+     * @brief Abandonne tous les bitmaps libres (les compteurs sont conservés).
+     */
+    void vider();
+
+private:
+    /**
+     * @brief Abandonne les bitmaps libres les plus anciens jusqu'à ce que `octets` tienne dans le budget.
+     * 
+     * @param octets Mémoire à ajouter.
+     */
+    void liberer(size_t octets);
+
+    size_t budget;                        ///< Mémoire maximale des bitmaps libres.
+    std::vector<Bitmap> libres;           ///< Bitmaps blancs, le plus récemment rendu en dernier.
+    StatistiquesPoolBitmaps statistiques; ///< Compteurs.
+    mutable std::mutex verrou;            ///< Protège libres et statistiques.
+};
+
+#endif // POOL_BITMAPS_H
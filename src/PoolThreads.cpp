@@ -0,0 +1,161 @@
+#include "PoolThreads.h"
+#include <algorithm>
+
+/// Groupe auquel appartient le thread courant (nul hors d'un groupe).
+static thread_local const PoolThreads* poolCourant = nullptr;
+
+/// Indice du thread courant dans son groupe.
+static thread_local size_t indiceCourant = 0;
+
+/**
+ * @brief Constructeur : démarre les threads.
+ * 
+ * @param nbThreads Nombre de threads (0 : un par cœur disponible).
+ */
+PoolThreads::PoolThreads(size_t nbThreads) {
+    if (nbThreads == 0) {
+        nbThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (size_t i = 0; i < nbThreads; ++i) {
+        files.push_back(std::make_unique<File>());
+    }
+    for (size_t i = 0; i < nbThreads; ++i) {
+        threads.emplace_back(&PoolThreads::boucle, this, i);
+    }
+}
+
+/**
+ * @brief Destructeur : termine les tâches en attente puis arrête les threads.
+ */
+PoolThreads::~PoolThreads() {
+    arret.store(true);
+    {
+        std::lock_guard<std::mutex> verrou(mutexEtat); // Aucun thread entre son test et son attente
+    }
+    reveil.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+/**
+ * @brief Nombre de threads du groupe.
+ * 
+ * @return Le nombre de threads.
+ */
+size_t PoolThreads::getNbThreads() const {
+    return threads.size();
+}
+
+/**
+ * @brief Ajoute une tâche.
+ * 
+ * @param tache La tâche à exécuter.
+ */
+void PoolThreads::soumettre(Tache tache) {
+    const size_t indice = (poolCourant == this) ? indiceCourant
+                                                : prochaineFile.fetch_add(1, std::memory_order_relaxed) % files.size();
+    nbNonTerminees.fetch_add(1); // Avant la publication : la tâche ne peut pas se terminer avant d'être comptée
+    {
+        // nbEnFile change sous le verrou de la file, comme la file : il ne compte
+        // jamais une tâche déjà prise ni ne manque une tâche publiée
+        std::lock_guard<std::mutex> verrou(files[indice]->mutex);
+        files[indice]->taches.push_back(std::move(tache));
+        nbEnFile.fetch_add(1);
+    }
+    // Un thread qui s'endort incrémente nbEndormis avant de relire nbEnFile :
+    // l'un des deux voit toujours l'écriture de l'autre
+    if (nbEndormis.load() > 0) {
+        {
+            std::lock_guard<std::mutex> verrou(mutexEtat);
+        }
+        reveil.notify_one();
+    }
+}
+
+/**
+ * @brief Attend la fin de toutes les tâches soumises.
+ */
+void PoolThreads::attendre() {
+    std::unique_lock<std::mutex> verrou(mutexEtat);
+    termine.wait(verrou, [this]() { return nbNonTerminees.load() == 0; });
+    if (erreur) {
+        std::exception_ptr premiere = erreur;
+        erreur = nullptr;
+        std::rethrow_exception(premiere);
+    }
+}
+
+/**
+ * @brief Prend une tâche dans la file du thread, ou en vole une ailleurs.
+ * 
+ * @param indice Indice du thread.
+ * @param tache Reçoit la tâche prise.
+ * @return true si une tâche a été prise.
+ */
+bool PoolThreads::prendre(size_t indice, Tache& tache) {
+    {
+        File& file = *files[indice];
+        std::lock_guard<std::mutex> verrou(file.mutex);
+        if (!file.taches.empty()) {
+            tache = std::move(file.taches.back()); // La plus récente
+            file.taches.pop_back();
+            nbEnFile.fetch_sub(1);
+            return true;
+        }
+    }
+    for (size_t decalage = 1; decalage < files.size(); ++decalage) {
+        File& victime = *files[(indice + decalage) % files.size()];
+        std::lock_guard<std::mutex> verrou(victime.mutex);
+        if (!victime.taches.empty()) {
+            tache = std::move(victime.taches.front()); // La plus ancienne
+            victime.taches.pop_front();
+            nbEnFile.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Boucle d'un thread : exécute des tâches jusqu'à l'arrêt.
+ * 
+ * @param indice Indice du thread.
+ */
+void PoolThreads::boucle(size_t indice) {
+    poolCourant = this;
+    indiceCourant = indice;
+
+    Tache tache;
+    while (true) {
+        if (!prendre(indice, tache)) {
+            // Rien trouvé : dormir tant qu'aucune file n'a de tâche. Si nbEnFile
+            // est non nul, une tâche a été publiée depuis le parcours : reprendre
+            std::unique_lock<std::mutex> verrou(mutexEtat);
+            nbEndormis.fetch_add(1);
+            reveil.wait(verrou, [this]() { return nbEnFile.load() > 0 || arret.load(); });
+            nbEndormis.fetch_sub(1);
+            if (arret.load() && nbEnFile.load() == 0) {
+                return; // Arrêt demandé et plus rien à faire
+            }
+            continue;
+        }
+
+        try {
+            tache(indice);
+        } catch (...) {
+            std::lock_guard<std::mutex> verrou(mutexEtat);
+            if (!erreur) {
+                erreur = std::current_exception();
+            }
+        }
+        tache = nullptr;
+
+        if (nbNonTerminees.fetch_sub(1) == 1) {
+            {
+                std::lock_guard<std::mutex> verrou(mutexEtat); // attendre() est soit avant son test, soit en attente
+            }
+            termine.notify_all();
+        }
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef POOL_THREADS_H
+#define POOL_THREADS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Groupe de threads exécutant des tâches, avec vol de travail.
+ * 
+ * Chaque thread possède sa propre file : il y dépile ses tâches par la fin
+ * (la plus récente, encore chaude en cache) et, quand elle est vide, vole
+ * la plus ancienne tâche de la file d'un autre thread. Les tâches reçoivent
+ * l'indice du thread qui les exécute, ce qui permet à chacun d'utiliser
+ * ses propres tampons de travail sans synchronisation.
+ */
+class PoolThreads {
+public:
+    /// Tâche exécutée par le groupe ; reçoit l'indice du thread, de 0 à getNbThreads() - 1.
+    using Tache = std::function<void(size_t)>;
+
+    /**
+     * @brief Constructeur : démarre les threads.
+     * 
+     * @param nbThreads Nombre de threads (0 : un par cœur disponible).
+     */
+    explicit PoolThreads(size_t nbThreads = 0);
+
+    /**
+     * @brief Destructeur : termine les tâches en attente puis arrête les threads.
+     */
+    ~PoolThreads();
+
+    PoolThreads(const PoolThreads&) = delete;
+    PoolThreads& operator=(const PoolThreads&) = delete;
+
+    /**
+     * @brief Nombre de threads du groupe.
+     * 
+     * @return Le nombre de threads.
+     */
+    size_t getNbThreads() const;
+
+    /**
+     * @brief Ajoute une tâche.
+     * 
+     * Appelée depuis une tâche du groupe, la nouvelle tâche va dans la file
+     * du thread appelant ; sinon, les files sont servies à tour de rôle.
+     * 
+     * @param tache La tâche à exécuter.
+     */
+    void soumettre(Tache tache);
+
+    /**
+     * @brief Attend la fin de toutes les tâches soumises.
+     * 
+     * Ne doit pas être appelée depuis une tâche du groupe.
+     * 
+     * @throws Relance la première exception levée par une tâche depuis le dernier appel.
+     */
+    void attendre();
+
+private:
+    /**
+     * @brief File de tâches d'un thread.
+     */
+    struct File {
+        std::mutex mutex;          ///< Protège les tâches.
+        std::deque<Tache> taches;  ///< Tâches en attente.
+    };
+
+    /**
+     * @brief Boucle d'un thread : exécute des tâches jusqu'à l'arrêt.
+     * 
+     * @param indice Indice du thread.
+     */
+    void boucle(size_t indice);
+
+    /**
+     * @brief Prend une tâche dans la file du thread, ou en vole une ailleurs.
+     * 
+     * @param indice Indice du thread.
+     * @param tache Reçoit la tâche prise.
+     * @return true si une tâche a été prise.
+     */
+    bool prendre(size_t indice, Tache& tache);
+
+    std::vector<std::unique_ptr<File>> files;  ///< Une file par thread.
+    std::vector<std::thread> threads;          ///< Threads du groupe.
+
+    // Les compteurs sont atomiques : le verrou n'est pris que pour s'endormir,
+    // réveiller un thread endormi ou ranger une exception
+    std::mutex mutexEtat;                     ///< Accompagne les attentes ; protège l'erreur.
+    std::condition_variable reveil;           ///< Signale une nouvelle tâche ou l'arrêt.
+    std::condition_variable termine;          ///< Signale que toutes les tâches sont terminées.
+    std::atomic<size_t> nbEnFile{0};          ///< Tâches dans les files (modifié sous le verrou de la file).
+    std::atomic<size_t> nbNonTerminees{0};    ///< Tâches soumises pas encore terminées.
+    std::atomic<size_t> nbEndormis{0};        ///< Threads en attente d'une tâche.
+    std::atomic<size_t> prochaineFile{0};     ///< File servie par la prochaine soumission externe.
+    std::atomic<bool> arret{false};           ///< Demande d'arrêt des threads.
+    std::exception_ptr erreur;                ///< Première exception levée par une tâche.
+};
+
+#endif // POOL_THREADS_H
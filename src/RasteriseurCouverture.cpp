@@ -0,0 +1,196 @@
+#include "RasteriseurCouverture.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/**
+ * @brief Constructeur du rastériseur.
+ * 
+ * @param width Largeur de la zone de rendu.
+ * @param height Hauteur de la zone de rendu.
+ * @param ressource Ressource fournissant le tampon d'accumulation.
+ * 
+ * @throws std::invalid_argument Si la largeur ou la hauteur est <= 0.
+ */
+RasteriseurCouverture::RasteriseurCouverture(int width, int height, std::pmr::memory_resource* ressource)
+    : width(width), height(height), pas(width + 2), yMin(height), yMax(-1), accumulation(ressource) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("La largeur et la hauteur doivent être positives.");
+    }
+    accumulation.assign(static_cast<size_t>(pas) * height, 0.0f);
+}
+
+/**
+ * @brief Accumule la contribution d'un segment orienté.
+ * 
+ * Le segment est parcouru rangée par rangée. Sur chaque rangée, la portion
+ * [x, xsuivant] de hauteur dy apporte une couverture d = ±dy répartie entre
+ * les cellules traversées selon l'aire située à leur droite. Les abscisses
+ * sont bornées à [0, largeur] : ce qui est à gauche du bitmap couvre toute la
+ * rangée, ce qui est à droite n'en couvre aucun pixel.
+ * 
+ * @param p0 Origine du segment.
+ * @param p1 Extrémité du segment.
+ */
+void RasteriseurCouverture::ajouterSegment(const Point& p0, const Point& p1) {
+    if (p0.getY() == p1.getY()) {
+        return;
+    }
+    const float sens = (p0.getY() < p1.getY()) ? 1.0f : -1.0f;
+    const Point& haut = (sens > 0.0f) ? p0 : p1;
+    const Point& bas = (sens > 0.0f) ? p1 : p0;
+
+    const float dxdy = (bas.getX() - haut.getX()) / (bas.getY() - haut.getY());
+    float x = haut.getX();
+    if (haut.getY() < 0.0f) {
+        x -= haut.getY() * dxdy;
+    }
+
+    const int yDebut = std::max(0, static_cast<int>(std::floor(haut.getY())));
+    const int yFin = std::min(height, static_cast<int>(std::ceil(bas.getY())));
+    if (yDebut >= yFin) {
+        return;
+    }
+    yMin = std::min(yMin, yDebut);
+    yMax = std::max(yMax, yFin - 1);
+
+    const float largeur = static_cast<float>(width);
+    for (int y = yDebut; y < yFin; ++y) {
+        float* rangee = accumulation.data() + static_cast<size_t>(y) * pas;
+        const float dy = std::min(static_cast<float>(y + 1), bas.getY()) - std::max(static_cast<float>(y), haut.getY());
+        const float xSuivant = x + dxdy * dy;
+        const float d = dy * sens;
+
+        const float x0 = std::max(0.0f, std::min(largeur, std::min(x, xSuivant)));
+        const float x1 = std::max(0.0f, std::min(largeur, std::max(x, xSuivant)));
+        const float x0Plancher = std::floor(x0);
+        const int x0i = static_cast<int>(x0Plancher);
+        const float x1Plafond = std::ceil(x1);
+        const int x1i = static_cast<int>(x1Plafond);
+
+        if (x1i <= x0i + 1) {
+            // La portion tient dans une cellule : partage selon l'abscisse moyenne
+            const float xm = 0.5f * (x0 + x1) - x0Plancher;
+            rangee[x0i] += d - d * xm;
+            rangee[x0i + 1] += d * xm;
+        } else {
+            const float s = 1.0f / (x1 - x0);
+            const float x0f = x0 - x0Plancher;
+            const float a0 = 0.5f * s * (1.0f - x0f) * (1.0f - x0f);
+            const float x1f = x1 - x1Plafond + 1.0f;
+            const float am = 0.5f * s * x1f * x1f;
+            rangee[x0i] += d * a0;
+            if (x1i == x0i + 2) {
+                rangee[x0i + 1] += d * (1.0f - a0 - am);
+            } else {
+                const float a1 = s * (1.5f - x0f);
+                rangee[x0i + 1] += d * (a1 - a0);
+                for (int xi = x0i + 2; xi < x1i - 1; ++xi) {
+                    rangee[xi] += d * s;
+                }
+                const float a2 = a1 + (x1i - x0i - 3) * s;
+                rangee[x1i - 1] += d * (1.0f - a2 - am);
+            }
+            rangee[x1i] += d * am;
+        }
+        x = xSuivant;
+    }
+}
+
+/**
+ * @brief Accumule des contours aplatis, chacun refermé implicitement.
+ * 
+ * @param sommets Sommets de tous les contours.
+ * @param contours Indices de début des contours, suivis de l'indice de fin.
+ * @param nbContours Nombre de contours.
+ */
+void RasteriseurCouverture::ajouterContours(const Point* sommets, const size_t* contours, size_t nbContours) {
+    for (size_t c = 0; c < nbContours; ++c) {
+        const size_t debut = contours[c];
+        const size_t fin = contours[c + 1];
+        if (fin - debut < 2) {
+            continue;
+        }
+        for (size_t i = debut; i < fin; ++i) {
+            ajouterSegment(sommets[i], sommets[(i + 1 < fin) ? i + 1 : debut]);
+        }
+    }
+}
+
+/**
+ * @brief Convertit l'accumulation en couverture 8 bits.
+ * 
+ * Seules les rangées touchées depuis la dernière résolution sont parcourues.
+ * Avec SSE2, la somme préfixe est calculée quatre cellules à la fois (deux
+ * décalages-additions dans le registre, plus la retenue de la rangée) et la
+ * conversion en octets est vectorisée ; sinon une boucle scalaire équivalente
+ * est utilisée.
+ * 
+ * @param bitmap Le bitmap de destination.
+ * @param origineX Abscisse du coin de la zone de rendu dans le bitmap.
+ * @param origineY Ordonnée du coin de la zone de rendu dans le bitmap.
+ * 
+ * @throws std::invalid_argument Si le format ne convient pas ou si la zone déborde du bitmap.
+ */
+void RasteriseurCouverture::resoudre(Bitmap& bitmap, int origineX, int origineY) {
+    TRACE_PORTEE("RasteriseurCouverture::resoudre");
+    if (bitmap.getFormat() != PixelFormat::Coverage8) {
+        throw std::invalid_argument("La résolution de couverture nécessite un bitmap Coverage8.");
+    }
+    if (origineX < 0 || origineY < 0 || origineX + width > bitmap.getWidth() || origineY + height > bitmap.getHeight()) {
+        throw std::invalid_argument("La zone de rendu doit être contenue dans le bitmap.");
+    }
+    TRACE_PIXELS(static_cast<uint64_t>(std::max(0, yMax - yMin + 1)) * width);
+
+    for (int y = yMin; y <= yMax; ++y) {
+        float* rangee = accumulation.data() + static_cast<size_t>(y) * pas;
+        uint8_t* ligne = bitmap.row(origineY + y) + origineX;
+        int x = 0;
+
+#ifdef __SSE2__
+        const __m128 masqueAbs = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 un = _mm_set1_ps(1.0f);
+        const __m128 echelle = _mm_set1_ps(255.0f);
+        const __m128 demi = _mm_set1_ps(0.5f);
+        __m128 retenue = _mm_setzero_ps();
+        for (; x + 4 <= width; x += 4) {
+            __m128 v = _mm_loadu_ps(rangee + x);
+            v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 4)));
+            v = _mm_add_ps(v, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(v), 8)));
+            v = _mm_add_ps(v, retenue);
+            retenue = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+            _mm_storeu_ps(rangee + x, _mm_setzero_ps());
+
+            // |somme| bornée à 1, puis 4 octets combinés par maximum avec l'existant
+            const __m128 couverture = _mm_min_ps(_mm_and_ps(v, masqueAbs), un);
+            const __m128i entiers = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(couverture, echelle), demi));
+            const __m128i mots = _mm_packs_epi32(entiers, entiers);
+            const __m128i octets = _mm_packus_epi16(mots, mots);
+            int32_t existants;
+            std::memcpy(&existants, ligne + x, sizeof(existants));
+            const int32_t resultat = _mm_cvtsi128_si32(_mm_max_epu8(octets, _mm_cvtsi32_si128(existants)));
+            std::memcpy(ligne + x, &resultat, sizeof(resultat));
+        }
+        float somme = _mm_cvtss_f32(retenue);
+#else
+        float somme = 0.0f;
+#endif
+        for (; x < width; ++x) {
+            somme += rangee[x];
+            rangee[x] = 0.0f;
+            const float couverture = std::min(std::fabs(somme), 1.0f);
+            const uint8_t valeur = static_cast<uint8_t>(couverture * 255.0f + 0.5f);
+            ligne[x] = std::max(ligne[x], valeur);
+        }
+        rangee[width] = 0.0f;
+        rangee[width + 1] = 0.0f;
+    }
+
+    yMin = height;
+    yMax = -1;
+}
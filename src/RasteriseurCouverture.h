@@ -0,0 +1,79 @@
+#ifndef RASTERISEUR_COUVERTURE_H
+#define RASTERISEUR_COUVERTURE_H
+
+#include "Bitmap.h"
+#include "Point.h"
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Rastériseur anti-crénelé par accumulation d'aires signées.
+ * 
+ * Chaque segment dépose, dans une rangée flottante par ligne de pixels, la
+ * différence d'aire et de couverture qu'il apporte à chaque cellule traversée
+ * (méthode de font-rs et stb_truetype v2). Une somme préfixe sur chaque rangée
+ * donne ensuite la couverture exacte de chaque pixel, convertie en alpha 8 bits.
+ * 
+ * Les contours doivent être fermés ; la couverture est |somme| bornée à 1,
+ * ce qui correspond à la règle de l'enroulement non nul pour des contours
+ * qui ne se recouvrent pas en sens opposé.
+ */
+class RasteriseurCouverture {
+public:
+    /**
+     * @brief Constructeur du rastériseur.
+     * 
+     * @param width Largeur de la zone de rendu (en pixels).
+     * @param height Hauteur de la zone de rendu (en pixels).
+     * @param ressource Ressource fournissant le tampon d'accumulation.
+     * 
+     * @throws std::invalid_argument Si la largeur ou la hauteur est <= 0.
+     */
+    RasteriseurCouverture(int width, int height,
+                          std::pmr::memory_resource* ressource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Accumule la contribution d'un segment orienté.
+     * 
+     * @param p0 Origine du segment.
+     * @param p1 Extrémité du segment.
+     */
+    void ajouterSegment(const Point& p0, const Point& p1);
+
+    /**
+     * @brief Accumule des contours aplatis, chacun refermé implicitement.
+     * 
+     * @param sommets Sommets de tous les contours.
+     * @param contours Indices de début des contours, suivis de l'indice de fin.
+     * @param nbContours Nombre de contours.
+     */
+    void ajouterContours(const Point* sommets, const size_t* contours, size_t nbContours);
+
+    /**
+     * @brief Convertit l'accumulation en couverture dans un bitmap.
+     * 
+     * La zone de rendu est placée en (origineX, origineY) dans le bitmap, ce
+     * qui permet de n'allouer l'accumulation que pour la boîte englobante du
+     * dessin. Chaque pixel (au format Coverage8) reçoit le maximum de sa
+     * valeur actuelle et de la couverture calculée, ce qui permet de composer
+     * plusieurs passes. L'accumulation est remise à zéro au passage.
+     * 
+     * @param bitmap Le bitmap de destination (format Coverage8).
+     * @param origineX Abscisse, dans le bitmap, du coin de la zone de rendu.
+     * @param origineY Ordonnée, dans le bitmap, du coin de la zone de rendu.
+     * 
+     * @throws std::invalid_argument Si le format ne convient pas ou si la zone déborde du bitmap.
+     */
+    void resoudre(Bitmap& bitmap, int origineX = 0, int origineY = 0);
+
+private:
+    int width;                       ///< Largeur de la zone de rendu.
+    int height;                      ///< Hauteur de la zone de rendu.
+    int pas;                         ///< Nombre de cellules par rangée (largeur + 2 cellules de débordement).
+    int yMin;                        ///< Première rangée modifiée depuis la dernière résolution.
+    int yMax;                        ///< Dernière rangée modifiée depuis la dernière résolution.
+    std::pmr::vector<float> accumulation; ///< Différences d'aire, rangée par rangée.
+};
+
+#endif
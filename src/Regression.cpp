@@ -0,0 +1,293 @@
+#include "Regression.h"
+#include "Composition.h"
+#include "Netpbm.h"
+#include "Police1.h"
+#include "Police2.h"
+#include "Police3.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+
+/**
+ * @brief Police vérifiée : nom des fichiers, style et police.
+ */
+struct PoliceVerifiee {
+    std::string nom;                     ///< Préfixe des fichiers ("police1"...).
+    StyleRendu style;                    ///< Style rendu par la police.
+    std::unique_ptr<PoliceBase> police;  ///< La police.
+};
+
+/**
+ * @brief Crée les trois polices à une taille donnée.
+ * 
+ * @param taille Hauteur des rendus.
+ * @return std::vector<PoliceVerifiee> Police1, Police2 et Police3.
+ */
+static std::vector<PoliceVerifiee> creerPolices(int taille) {
+    std::vector<PoliceVerifiee> polices;
+    polices.push_back({"police1", StyleRendu::Contour, std::make_unique<Police1>(Rendu::largeur(StyleRendu::Contour, taille), taille)});
+    polices.push_back({"police2", StyleRendu::RempliGras, std::make_unique<Police2>(Rendu::largeur(StyleRendu::RempliGras, taille), taille)});
+    polices.push_back({"police3", StyleRendu::ContourRouge, std::make_unique<Police3>(Rendu::largeur(StyleRendu::ContourRouge, taille), taille)});
+    return polices;
+}
+
+/**
+ * @brief Nombre de pixels de couleurs différentes entre deux bitmaps de mêmes dimensions.
+ * 
+ * Les couleurs sont comparées après conversion ARGB : des formats différents
+ * (une référence PBM relue en Bit1 et un rendu Index8 noir et blanc, par
+ * exemple) sont comparables.
+ * 
+ * @param a Premier bitmap.
+ * @param b Second bitmap.
+ * @return size_t Le nombre de pixels différents.
+ */
+static size_t compterDifferences(const Bitmap& a, const Bitmap& b) {
+    std::vector<uint32_t> ligneA(a.getWidth());
+    std::vector<uint32_t> ligneB(b.getWidth());
+    size_t differences = 0;
+    for (int y = 0; y < a.getHeight(); ++y) {
+        a.rowToARGB(y, ligneA.data());
+        b.rowToARGB(y, ligneB.data());
+        for (int x = 0; x < a.getWidth(); ++x) {
+            differences += ligneA[x] != ligneB[x];
+        }
+    }
+    return differences;
+}
+
+/**
+ * @brief Construit l'image de différences : référence, rendu, puis différences en rouge.
+ * 
+ * @param reference Image de référence.
+ * @param rendu Rendu actuel, de mêmes dimensions.
+ * @return Bitmap L'image Index8 de largeur 3 fois celle des images.
+ */
+static Bitmap imageDifferences(const Bitmap& reference, const Bitmap& rendu) {
+    const int largeur = reference.getWidth();
+    Bitmap image(3 * largeur, reference.getHeight(), PixelFormat::Index8);
+    Composition::composer(reference, image, 0, 0, OperateurComposition::Copie);
+    Composition::composer(rendu, image, largeur, 0, OperateurComposition::Copie);
+
+    std::vector<uint32_t> ligneReference(largeur);
+    std::vector<uint32_t> ligneRendu(largeur);
+    for (int y = 0; y < image.getHeight(); ++y) {
+        reference.rowToARGB(y, ligneReference.data());
+        rendu.rowToARGB(y, ligneRendu.data());
+        uint8_t* ligne = image.row(y) + 2 * largeur;
+        for (int x = 0; x < largeur; ++x) {
+            if (ligneReference[x] != ligneRendu[x]) {
+                ligne[x] = 2; // Rouge : pixel différent
+            } else if (ligneReference[x] != 0xFFFFFFFFu) {
+                ligne[x] = 1; // Noir : encre commune
+            }
+        }
+    }
+    return image;
+}
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param dossier Dossier des références.
+ * @param options Réglages.
+ */
+Regression::Regression(const std::string& dossier, const OptionsRegression& options)
+    : dossier(dossier), options(options) {
+    if (options.taille <= 0 || options.nbEssais <= 0 || options.toleranceDifferences < 0.0 || options.ecartsDebit < 0.0
+        || options.baisseMinimale < 0.0 || options.dureeMesure < 0.0) {
+        throw std::invalid_argument("Réglages de non-régression invalides.");
+    }
+}
+
+/**
+ * @brief Médiane d'une suite de valeurs.
+ * 
+ * @param valeurs Les valeurs (réordonnées), au moins une.
+ * @return double La médiane.
+ */
+static double mediane(std::vector<double>& valeurs) {
+    std::sort(valeurs.begin(), valeurs.end());
+    const size_t milieu = valeurs.size() / 2;
+    return valeurs.size() % 2 == 1 ? valeurs[milieu] : (valeurs[milieu - 1] + valeurs[milieu]) / 2.0;
+}
+
+/**
+ * @brief Mesure le débit de chaque style.
+ * 
+ * Chaque essai rend les 26 lettres en boucle pendant au moins dureeMesure ;
+ * les styles sont mesurés à tour de rôle, essai par essai, pour qu'une
+ * période chargée de la machine les touche tous au lieu d'un seul. Le débit
+ * retenu est la médiane des essais et la dispersion leur écart absolu médian
+ * (× 1,4826).
+ * 
+ * @return std::vector<DebitStyle> Les débits.
+ */
+std::vector<DebitStyle> Regression::mesurerDebits() const {
+    using Horloge = std::chrono::steady_clock;
+    Rendu rendu;
+    std::vector<PoliceVerifiee> polices = creerPolices(options.taille);
+    std::vector<Bitmap> bitmaps;
+    for (const PoliceVerifiee& police : polices) {
+        bitmaps.push_back(Rendu::creerBitmap(police.style, options.taille));
+        for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+            rendu.rendreLettre(lettre, police.style, options.taille, bitmaps.back()); // Mise en température
+        }
+    }
+
+    std::vector<std::vector<double>> essais(polices.size());
+    for (int essai = 0; essai < options.nbEssais; ++essai) {
+        for (size_t p = 0; p < polices.size(); ++p) {
+            size_t nbGlyphes = 0;
+            const auto debut = Horloge::now();
+            std::chrono::duration<double> duree{0.0};
+            do {
+                for (char lettre = 'A'; lettre <= 'Z'; ++lettre, ++nbGlyphes) {
+                    rendu.rendreLettre(lettre, polices[p].style, options.taille, bitmaps[p]);
+                }
+                duree = Horloge::now() - debut;
+            } while (duree.count() < options.dureeMesure);
+            essais[p].push_back(nbGlyphes / duree.count());
+        }
+    }
+
+    std::vector<DebitStyle> debits;
+    for (size_t p = 0; p < polices.size(); ++p) {
+        DebitStyle mesure{polices[p].style};
+        mesure.debit = mediane(essais[p]);
+        std::vector<double> ecarts;
+        for (double debit : essais[p]) {
+            ecarts.push_back(std::abs(debit - mesure.debit));
+        }
+        mesure.dispersion = 1.4826 * mediane(ecarts);
+        debits.push_back(mesure);
+    }
+    return debits;
+}
+
+/**
+ * @brief Produit les images et le débit de référence.
+ * 
+ * @param journal Flux recevant le compte rendu.
+ */
+void Regression::generer(std::ostream& journal) const {
+    std::filesystem::create_directories(dossier);
+    size_t nbImages = 0;
+    for (const PoliceVerifiee& police : creerPolices(options.taille)) {
+        for (char lettre = 'A'; lettre <= 'Z'; ++lettre, ++nbImages) {
+            const Bitmap bitmap = police.police->dessinerLettre(lettre);
+            const FormatNetpbm format = Netpbm::formatNaturel(bitmap);
+            Netpbm::ecrire(bitmap, dossier + "/" + police.nom + "_" + lettre + Netpbm::extension(format), format);
+        }
+    }
+
+    const std::string chemin = dossier + "/debit.txt";
+    std::ofstream fichier(chemin);
+    for (const DebitStyle& mesure : mesurerDebits()) {
+        fichier << Rendu::nomStyle(mesure.style) << " " << mesure.debit << " " << mesure.dispersion << "\n";
+        journal << "  débit " << Rendu::nomStyle(mesure.style) << " : " << mesure.debit << " ± " << mesure.dispersion
+                << " glyphes/s (" << options.nbEssais << " essais)" << std::endl;
+    }
+    if (!fichier.flush()) {
+        throw std::ios_base::failure("Erreur d'écriture dans le fichier : " + chemin);
+    }
+    journal << nbImages << " image(s) de référence écrite(s) dans " << dossier << std::endl;
+}
+
+/**
+ * @brief Compare les rendus et le débit actuels aux références.
+ * 
+ * @param journal Flux recevant le compte rendu.
+ * @return BilanRegression Le bilan.
+ */
+BilanRegression Regression::verifier(std::ostream& journal) const {
+    BilanRegression bilan;
+    const std::string dossierDifferences = dossier + "/diff";
+    for (const PoliceVerifiee& police : creerPolices(options.taille)) {
+        for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+            const std::string nom = police.nom + "_" + lettre;
+            const Bitmap rendu = police.police->dessinerLettre(lettre);
+            ++bilan.nbImages;
+
+            // La référence peut avoir été écrite dans un autre format que celui du rendu actuel
+            std::unique_ptr<Bitmap> reference;
+            for (FormatNetpbm format : {Netpbm::formatNaturel(rendu), FormatNetpbm::PBM, FormatNetpbm::PGM, FormatNetpbm::PPM}) {
+                const std::string chemin = dossier + "/" + nom + Netpbm::extension(format);
+                if (std::filesystem::exists(chemin)) {
+                    try {
+                        reference = std::make_unique<Bitmap>(Netpbm::lire(chemin));
+                    } catch (const std::exception& e) {
+                        journal << "  " << nom << " : " << e.what() << std::endl;
+                    }
+                    break;
+                }
+            }
+            if (!reference) {
+                journal << "  " << nom << " : référence manquante" << std::endl;
+                bilan.manquantes.push_back(nom);
+                continue;
+            }
+
+            const size_t surface = static_cast<size_t>(rendu.getWidth()) * rendu.getHeight();
+            if (reference->getWidth() != rendu.getWidth() || reference->getHeight() != rendu.getHeight()) {
+                journal << "  " << nom << " : dimensions " << rendu.getWidth() << "x" << rendu.getHeight()
+                        << " au lieu de " << reference->getWidth() << "x" << reference->getHeight() << std::endl;
+                bilan.differences.push_back(nom);
+                continue;
+            }
+            const size_t differences = compterDifferences(*reference, rendu);
+            if (differences > options.toleranceDifferences * surface) {
+                std::filesystem::create_directories(dossierDifferences);
+                Netpbm::ecrire(imageDifferences(*reference, rendu), dossierDifferences + "/" + nom + ".ppm", FormatNetpbm::PPM);
+                journal << "  " << nom << " : " << differences << " pixel(s) différent(s) sur " << surface << std::endl;
+                bilan.differences.push_back(nom);
+            }
+        }
+    }
+    journal << bilan.nbImages << " image(s) comparée(s) : " << bilan.differences.size() << " différente(s), "
+            << bilan.manquantes.size() << " référence(s) manquante(s)";
+    if (!bilan.differences.empty()) {
+        journal << " (différences dans " << dossierDifferences << ")";
+    }
+    journal << std::endl;
+
+    // Débits de référence : médiane et dispersion par style
+    std::map<std::string, std::pair<double, double>> references;
+    std::ifstream fichier(dossier + "/debit.txt");
+    std::string style;
+    double debit;
+    double dispersion;
+    while (fichier >> style >> debit >> dispersion) {
+        references[style] = {debit, dispersion};
+    }
+    for (DebitStyle mesure : mesurerDebits()) {
+        const auto trouve = references.find(Rendu::nomStyle(mesure.style));
+        journal << "  débit " << Rendu::nomStyle(mesure.style) << " : " << mesure.debit << " ± " << mesure.dispersion << " glyphes/s";
+        if (trouve == references.end()) {
+            journal << " (pas de référence)" << std::endl;
+        } else {
+            mesure.reference = trouve->second.first;
+            mesure.dispersionReference = trouve->second.second;
+            // Les deux médianes sont bruitées : l'écart toléré combine leurs dispersions
+            const double ecart = std::hypot(mesure.dispersion, mesure.dispersionReference);
+            const double baisse = mesure.reference - mesure.debit;
+            const bool insuffisant = baisse > options.ecartsDebit * ecart && baisse > options.baisseMinimale * mesure.reference;
+            bilan.debitInsuffisant = bilan.debitInsuffisant || insuffisant;
+            journal << ", référence " << mesure.reference << " ± " << mesure.dispersionReference << " ("
+                    << (mesure.debit / mesure.reference - 1.0) * 100.0 << " %, " << (ecart > 0.0 ? -baisse / ecart : 0.0)
+                    << " écart(s))" << (insuffisant ? " : BAISSE AU-DELÀ DU SEUIL" : "") << std::endl;
+        }
+        bilan.debits.push_back(mesure);
+    }
+    if (bilan.reussi()) {
+        journal << "Non-régression : réussie" << std::endl;
+    } else {
+        journal << (bilan.imagesConformes() ? "Non-régression : ÉCHEC du débit seul" : "Non-régression : ÉCHEC") << std::endl;
+    }
+    return bilan;
+}
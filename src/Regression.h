@@ -0,0 +1,128 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include "Rendu.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Réglages d'une vérification de non-régression.
+ */
+struct OptionsRegression {
+    int taille = 128;                   ///< Hauteur des rendus en pixels.
+    double toleranceDifferences = 0.0;  ///< Part maximale de pixels différents dans une image (0 : identique).
+    double ecartsDebit = 4.0;           ///< Baisse de débit tolérée, en écarts robustes des mesures (voir DebitStyle).
+    double baisseMinimale = 0.05;       ///< Baisse de débit toujours tolérée, quel que soit l'écart (0.05 : 5 %).
+    int nbEssais = 15;                  ///< Essais chronométrés par style ; la médiane est retenue.
+    double dureeMesure = 0.3;           ///< Durée minimale d'un essai, en secondes.
+};
+
+/**
+ * @brief Débit mesuré pour un style.
+ * 
+ * La dispersion est l'écart absolu médian des essais multiplié par 1,4826 :
+ * pour des mesures de loi normale, c'est l'écart type, mais quelques essais
+ * interrompus ne la faussent pas.
+ */
+struct DebitStyle {
+    StyleRendu style;                  ///< Le style.
+    double debit = 0.0;                ///< Médiane des essais, en glyphes rendus par seconde.
+    double dispersion = 0.0;           ///< Écart robuste des essais, en glyphes par seconde.
+    double reference = 0.0;            ///< Débit de référence (0 si absent).
+    double dispersionReference = 0.0;  ///< Écart robuste des essais de référence.
+};
+
+/**
+ * @brief Bilan d'une vérification de non-régression.
+ */
+struct BilanRegression {
+    size_t nbImages = 0;                  ///< Images comparées.
+    std::vector<std::string> differences; ///< Images qui dépassent la tolérance.
+    std::vector<std::string> manquantes;  ///< Images de référence absentes ou illisibles.
+    std::vector<DebitStyle> debits;       ///< Débits par style.
+    bool debitInsuffisant = false;        ///< Vrai si un débit est passé sous le seuil.
+
+    /**
+     * @brief Vrai si toutes les images sont présentes et conformes.
+     * 
+     * @return bool Aucune différence, aucune référence manquante.
+     */
+    bool imagesConformes() const {
+        return differences.empty() && manquantes.empty();
+    }
+
+    /**
+     * @brief Vrai si la vérification a réussi.
+     * 
+     * @return bool Images conformes et aucun débit insuffisant.
+     */
+    bool reussi() const {
+        return imagesConformes() && !debitInsuffisant;
+    }
+};
+
+/**
+ * @brief Non-régression des rendus : images de référence et débit de référence.
+ * 
+ * Les 26 lettres sont rendues par les trois polices (Police1, Police2,
+ * Police3), sans affichage. Chaque image est comparée pixel à pixel à une
+ * image de référence du dossier (`police<n>_<lettre>.pbm` ou `.ppm`, au
+ * format Netpbm::formatNaturel()) ; pour chaque image qui dépasse la
+ * tolérance, une image de différences est écrite dans `<dossier>/diff/` :
+ * référence, rendu actuel, puis pixels communs en noir et pixels différents
+ * en rouge, côte à côte.
+ * 
+ * Le débit de chaque style (Rendu::rendreLettre(), sans cache) est la médiane
+ * de nbEssais essais ; `<dossier>/debit.txt` en garde, par style, la médiane
+ * et l'écart robuste de référence. Un débit est insuffisant si sa baisse
+ * dépasse à la fois baisseMinimale et ecartsDebit fois l'écart combiné des
+ * deux séries d'essais : le seuil suit le bruit de la machine au lieu d'un
+ * pourcentage fixe. Ce débit dépend de la machine : la référence doit être
+ * produite sur la machine de vérification.
+ */
+class Regression {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param dossier Dossier des références.
+     * @param options Réglages.
+     * 
+     * @throws std::invalid_argument Si la taille ou le nombre d'essais est <= 0, ou si une tolérance est négative.
+     */
+    Regression(const std::string& dossier, const OptionsRegression& options = OptionsRegression());
+
+    /**
+     * @brief Produit les images et le débit de référence.
+     * 
+     * @param journal Flux recevant le compte rendu.
+     * 
+     * @throws std::ios_base::failure Si un fichier ne peut pas être écrit.
+     */
+    void generer(std::ostream& journal) const;
+
+    /**
+     * @brief Compare les rendus et le débit actuels aux références.
+     * 
+     * @param journal Flux recevant le compte rendu.
+     * @return BilanRegression Le bilan.
+     * 
+     * @throws std::ios_base::failure Si une image de différences ne peut pas être écrite.
+     */
+    BilanRegression verifier(std::ostream& journal) const;
+
+private:
+    /**
+     * @brief Mesure le débit de chaque style.
+     * 
+     * @return std::vector<DebitStyle> Un débit et sa dispersion par style, sans référence.
+     */
+    std::vector<DebitStyle> mesurerDebits() const;
+
+    std::string dossier;        ///< Dossier des références.
+    OptionsRegression options;  ///< Réglages.
+};
+
+#endif // REGRESSION_H
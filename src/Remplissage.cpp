@@ -0,0 +1,156 @@
+#include "Remplissage.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Premier indice de pixel dont le centre est >= v.
+ * 
+ * La valeur est bornée pour que la conversion en entier reste définie.
+ * 
+ * @param v Coordonnée en pixels.
+ * @return int ceil(v - 0.5).
+ */
+static int premierCentre(float v) {
+    const float borne = 1 << 24;
+    return static_cast<int>(std::ceil(std::max(-borne, std::min(borne, v)) - 0.5f));
+}
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param ressource Ressource fournissant la table des arêtes.
+ */
+Remplisseur::Remplisseur(std::pmr::memory_resource* ressource) : aretes(ressource) {}
+
+/**
+ * @brief Construit la table des arêtes à partir de contours aplatis.
+ * 
+ * Une arête de (xa, ya) à (xb, yb) coupe les lignes dont le centre y + 0.5
+ * est dans [min(ya, yb), max(ya, yb)[ ; on retient l'abscisse au centre de la
+ * première de ces lignes et la pente dx/dy.
+ * 
+ * @param sommets Sommets de tous les contours.
+ * @param contours Indices de début des contours, suivis de l'indice de fin.
+ * @param nbContours Nombre de contours.
+ */
+void Remplisseur::construire(const Point* sommets, const size_t* contours, size_t nbContours) {
+    aretes.clear();
+
+    for (size_t c = 0; c < nbContours; ++c) {
+        const size_t debut = contours[c];
+        const size_t fin = contours[c + 1];
+        if (fin - debut < 2) {
+            continue;
+        }
+        for (size_t i = debut; i < fin; ++i) {
+            const Point& a = sommets[i];
+            const Point& b = sommets[(i + 1 < fin) ? i + 1 : debut];
+            if (a.getY() == b.getY()) {
+                continue; // Arête horizontale
+            }
+
+            const bool descend = b.getY() > a.getY();
+            const Point& haut = descend ? a : b;
+            const Point& bas = descend ? b : a;
+
+            Arete arete;
+            arete.yDebut = premierCentre(haut.getY());
+            arete.yFin = premierCentre(bas.getY()) - 1;
+            if (arete.yDebut > arete.yFin) {
+                continue; // Aucun centre de ligne n'est coupé
+            }
+            arete.pente = (bas.getX() - haut.getX()) / (bas.getY() - haut.getY());
+            arete.x = haut.getX() + (arete.yDebut + 0.5f - haut.getY()) * arete.pente;
+            arete.sens = descend ? 1 : -1;
+            aretes.push_back(arete);
+        }
+    }
+
+    std::sort(aretes.begin(), aretes.end(), [](const Arete& a, const Arete& b) {
+        return a.yDebut < b.yDebut;
+    });
+}
+
+/**
+ * @brief Remplit l'intérieur des contours ligne par ligne.
+ * 
+ * À chaque ligne, les arêtes qui commencent sont ajoutées à la liste active,
+ * celles qui sont terminées en sont retirées, puis la liste est retriée par
+ * abscisse (tri par insertion : l'ordre change peu d'une ligne à l'autre).
+ * Le parcours des arêtes actives cumule le nombre d'enroulement et émet une
+ * portion pleine à chaque intervalle intérieur.
+ * 
+ * @param bitmap Le bitmap où remplir.
+ * @param regle Règle de remplissage.
+ * @param color Couleur des pixels intérieurs.
+ * @param ressource Ressource fournissant la liste des arêtes actives.
+ */
+void Remplisseur::remplir(Bitmap& bitmap, RegleRemplissage regle, int color, std::pmr::memory_resource* ressource) const {
+    TRACE_PORTEE("Remplisseur::remplir");
+    if (aretes.empty()) {
+        return;
+    }
+
+    std::pmr::vector<Arete> actives(ressource);
+    size_t prochaine = 0;
+    const int yMin = std::max(0, aretes.front().yDebut);
+
+    // Les arêtes commençant au-dessus du bitmap entrent directement à la première ligne
+    for (int y = yMin; y < bitmap.getHeight(); ++y) {
+        while (prochaine < aretes.size() && aretes[prochaine].yDebut <= y) {
+            Arete arete = aretes[prochaine++];
+            if (arete.yFin < y) {
+                continue;
+            }
+            arete.x += (y - arete.yDebut) * arete.pente;
+            actives.push_back(arete);
+        }
+
+        actives.erase(std::remove_if(actives.begin(), actives.end(), [y](const Arete& a) {
+            return a.yFin < y;
+        }), actives.end());
+
+        if (actives.empty()) {
+            if (prochaine == aretes.size()) {
+                break;
+            }
+            continue;
+        }
+
+        for (size_t i = 1; i < actives.size(); ++i) {
+            Arete courante = actives[i];
+            size_t j = i;
+            while (j > 0 && actives[j - 1].x > courante.x) {
+                actives[j] = actives[j - 1];
+                --j;
+            }
+            actives[j] = courante;
+        }
+
+        int enroulement = 0;
+        for (size_t i = 0; i + 1 < actives.size(); ++i) {
+            enroulement += (regle == RegleRemplissage::NonZero) ? actives[i].sens : 1;
+            const bool interieur = (regle == RegleRemplissage::NonZero) ? (enroulement != 0) : (enroulement & 1);
+            if (interieur) {
+                // Pixels dont le centre est dans [x_i, x_{i+1}[
+                const int x0 = premierCentre(actives[i].x);
+                const int x1 = premierCentre(actives[i + 1].x) - 1;
+                bitmap.fillSpan(y, x0, x1, color);
+            }
+        }
+
+        for (auto& arete : actives) {
+            arete.x += arete.pente;
+        }
+    }
+}
+
+/**
+ * @brief Retourne la table des arêtes.
+ * 
+ * @return const std::pmr::vector<Arete>& Les arêtes triées par première ligne.
+ */
+const std::pmr::vector<Arete>& Remplisseur::getAretes() const {
+    return aretes;
+}
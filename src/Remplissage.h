@@ -0,0 +1,82 @@
+#ifndef REMPLISSAGE_H
+#define REMPLISSAGE_H
+
+#include "Bitmap.h"
+#include "Point.h"
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Règle déterminant quels points sont à l'intérieur d'un contour.
+ */
+enum class RegleRemplissage {
+    NonZero,  ///< Intérieur si le nombre d'enroulement est non nul.
+    EvenOdd   ///< Intérieur si le nombre de croisements est impair.
+};
+
+/**
+ * @brief Arête d'un polygone, prête pour le balayage ligne par ligne.
+ */
+struct Arete {
+    float x;      ///< Abscisse de l'arête au centre de la ligne courante.
+    float pente;  ///< Variation de x entre deux lignes consécutives.
+    int yDebut;   ///< Première ligne coupée par l'arête.
+    int yFin;     ///< Dernière ligne coupée par l'arête (incluse).
+    int sens;     ///< +1 si l'arête descend, -1 si elle monte.
+};
+
+/**
+ * @brief Remplissage de polygones par balayage avec table d'arêtes actives.
+ * 
+ * Les contours (fermés implicitement) sont convertis en une table d'arêtes
+ * triée par première ligne. Chaque ligne ne considère que les arêtes actives,
+ * triées par abscisse, et en déduit des portions pleines selon la règle de
+ * remplissage : le coût suit arêtes × lignes et non la largeur du bitmap.
+ */
+class Remplisseur {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param ressource Ressource fournissant la table des arêtes.
+     */
+    explicit Remplisseur(std::pmr::memory_resource* ressource = std::pmr::get_default_resource());
+
+    /**
+     * @brief Construit la table des arêtes à partir de contours aplatis.
+     * 
+     * Chaque contour est refermé de son dernier à son premier sommet. Les
+     * arêtes horizontales, qui ne coupent aucun centre de ligne, sont ignorées.
+     * 
+     * @param sommets Sommets de tous les contours.
+     * @param contours Indices de début des contours, suivis de l'indice de fin.
+     * @param nbContours Nombre de contours.
+     */
+    void construire(const Point* sommets, const size_t* contours, size_t nbContours);
+
+    /**
+     * @brief Remplit l'intérieur des contours dans un bitmap.
+     * 
+     * Un pixel est plein si son centre est à l'intérieur selon la règle choisie.
+     * 
+     * @param bitmap Le bitmap où remplir.
+     * @param regle Règle de remplissage.
+     * @param color Couleur des pixels intérieurs.
+     * @param ressource Ressource fournissant la liste des arêtes actives.
+     */
+    void remplir(Bitmap& bitmap, RegleRemplissage regle, int color,
+                 std::pmr::memory_resource* ressource = std::pmr::get_default_resource()) const;
+
+    /**
+     * @brief Accès à la table des arêtes.
+     * 
+     * @return const std::pmr::vector<Arete>& Les arêtes, triées par première ligne.
+     */
+    const std::pmr::vector<Arete>& getAretes() const;
+
+private:
+    std::pmr::vector<Arete> aretes;  ///< Table des arêtes triée par yDebut.
+};
+
+#endif
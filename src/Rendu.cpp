@@ -0,0 +1,241 @@
+#include "Rendu.h"
+#include "GlyphGenerator.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+/**
+ * @brief Vérifie qu'une taille de rendu est valide.
+ * 
+ * @param taille Hauteur du rendu en pixels.
+ * 
+ * @throws std::invalid_argument Si la taille est <= 0.
+ */
+static void verifierTaille(int taille) {
+    if (taille <= 0) {
+        throw std::invalid_argument("La taille du rendu doit être strictement positive.");
+    }
+}
+
+/**
+ * @brief Constructeur : prépare les glyphes des lettres A à Z.
+ * 
+ * Les glyphes référencent la table constante des lettres, sans allocation.
+ */
+Rendu::Rendu() {
+    for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+        glyphes[lettre - 'A'] = generateGlyph(lettre);
+    }
+}
+
+/**
+ * @brief Largeur du rendu d'une lettre.
+ * 
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @return int La largeur en pixels.
+ */
+int Rendu::largeur(StyleRendu style, int taille) {
+    return style == StyleRendu::RempliGras ? 2 * taille : taille;
+}
+
+/**
+ * @brief Crée un bitmap blanc adapté à un style et une taille.
+ * 
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @return Bitmap Le bitmap créé.
+ */
+Bitmap Rendu::creerBitmap(StyleRendu style, int taille) {
+    verifierTaille(taille);
+    return Bitmap(largeur(style, taille), taille, formatPour(style));
+}
+
+/**
+ * @brief Format de pixels attendu par un style.
+ * 
+ * @param style Style de rendu.
+ * @return PixelFormat Le format.
+ */
+PixelFormat Rendu::formatPour(StyleRendu style) {
+    switch (style) {
+    case StyleRendu::Contour:
+    case StyleRendu::RempliGras:
+        return PixelFormat::Bit1;
+    case StyleRendu::ContourRouge:
+        return PixelFormat::Index8;
+    case StyleRendu::Lisse:
+        break;
+    }
+    return PixelFormat::Coverage8;
+}
+
+/**
+ * @brief Retourne un masque de travail effacé.
+ * 
+ * @param indice Numéro du masque.
+ * @param taille Côté du masque en pixels.
+ * @return Bitmap& Le masque.
+ */
+Bitmap& Rendu::masque(size_t indice, int taille) {
+    if (masques.empty()) {
+        // Les deux masques sont créés ensemble : une référence vers le premier reste valide
+        masques.emplace_back(taille, taille, PixelFormat::Bit1);
+        masques.emplace_back(taille, taille, PixelFormat::Bit1);
+    }
+    if (masques[indice].getHeight() != taille) {
+        masques[indice] = Bitmap(taille, taille, PixelFormat::Bit1);
+    } else {
+        masques[indice].clear();
+    }
+    return masques[indice];
+}
+
+/**
+ * @brief Retrouve un style à partir de son nom.
+ * 
+ * @param nom Nom du style.
+ * @return StyleRendu Le style correspondant.
+ */
+StyleRendu Rendu::styleDepuisNom(const std::string& nom) {
+    if (nom == "contour") {
+        return StyleRendu::Contour;
+    }
+    if (nom == "gras") {
+        return StyleRendu::RempliGras;
+    }
+    if (nom == "rouge") {
+        return StyleRendu::ContourRouge;
+    }
+    if (nom == "lisse") {
+        return StyleRendu::Lisse;
+    }
+    throw std::invalid_argument("Style de rendu inconnu : " + nom);
+}
+
+/**
+ * @brief Nom d'un style.
+ * 
+ * @param style Style de rendu.
+ * @return Le nom du style.
+ */
+const char* Rendu::nomStyle(StyleRendu style) {
+    switch (style) {
+    case StyleRendu::Contour:
+        return "contour";
+    case StyleRendu::RempliGras:
+        return "gras";
+    case StyleRendu::ContourRouge:
+        return "rouge";
+    case StyleRendu::Lisse:
+        return "lisse";
+    }
+    return "";
+}
+
+/**
+ * @brief Retourne le glyphe d'une lettre, mis à l'échelle d'une taille.
+ * 
+ * @param lettre La lettre recherchée.
+ * @param taille Hauteur du rendu en pixels.
+ * @return Le glyphe.
+ */
+const Glyph& Rendu::glyphe(char lettre, int taille) {
+    if (lettre < 'A' || lettre > 'Z') {
+        vide = generateGlyph(lettre); // Signale la lettre non supportée
+        return vide;
+    }
+    Glyph& glyph = glyphes[lettre - 'A'];
+    glyph.setEchelle(static_cast<float>(taille) / TAILLE_DESSIN);
+    return glyph;
+}
+
+/**
+ * @brief Mémoire occupée par les aplatissements conservés des glyphes.
+ * 
+ * @return size_t La mémoire, en octets.
+ */
+size_t Rendu::getMemoireAplatissements() const {
+    size_t memoire = vide.getMemoireCache();
+    for (const Glyph& glyph : glyphes) {
+        memoire += glyph.getMemoireCache();
+    }
+    return memoire;
+}
+
+/**
+ * @brief Dessine une lettre dans un nouveau bitmap.
+ * 
+ * @param lettre La lettre à dessiner.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @return Bitmap Le bitmap contenant la lettre.
+ */
+Bitmap Rendu::rendreLettre(char lettre, StyleRendu style, int taille) {
+    Bitmap bitmap = creerBitmap(style, taille);
+    rendreLettre(lettre, style, taille, bitmap);
+    return bitmap;
+}
+
+/**
+ * @brief Dessine une lettre dans un bitmap fourni par l'appelant.
+ * 
+ * @param lettre La lettre à dessiner.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @param bitmap Bitmap de destination.
+ */
+void Rendu::rendreLettre(char lettre, StyleRendu style, int taille, Bitmap& bitmap) {
+    TRACE_PORTEE_DETAIL("Rendu::rendreLettre", std::string(1, lettre) + " " + nomStyle(style) + " " + std::to_string(taille));
+    verifierTaille(taille);
+    if (bitmap.getFormat() != formatPour(style)) {
+        throw std::invalid_argument("Le format du bitmap ne convient pas au style de rendu.");
+    }
+    bitmap.clear();
+    arena.reinitialiser();
+
+    const float echelle = static_cast<float>(taille) / TAILLE_DESSIN;
+    const int epaisseur = static_cast<int>(std::lround(EPAISSEUR_DESSIN * echelle));
+    const Glyph& glyph = glyphe(lettre, taille);
+
+    switch (style) {
+    case StyleRendu::Contour:
+        glyph.drawContour(bitmap);
+        break;
+
+    case StyleRendu::RempliGras: {
+        // Dessiner la lettre remplie et la lettre grasse dans des masques de travail (1 bit par pixel)
+        Bitmap& filledBitmap = masque(0, taille);
+        Bitmap& boldBitmap = masque(1, taille);
+        glyph.drawFilled(filledBitmap, RegleRemplissage::NonZero, &arena);
+        glyph.drawBold(boldBitmap, epaisseur, Jointure::Arrondie, &arena);
+
+        // Copier les deux versions côte à côte, 64 pixels à la fois
+        bitmap.orBitmap(filledBitmap, 0, 0);
+        bitmap.orBitmap(boldBitmap, taille, 0);
+        break;
+    }
+
+    case StyleRendu::ContourRouge:
+        glyph.drawWithRedOutline(bitmap, epaisseur, Jointure::Arrondie, &arena);
+        break;
+
+    case StyleRendu::Lisse:
+        glyph.drawAntialiased(bitmap, std::max(1.0f, echelle), &arena);
+        break;
+    }
+}
+
+/**
+ * @brief Dessine une lettre dans un tampon ARGB8888 fourni par l'appelant.
+ * 
+ * @param lettre La lettre à dessiner.
+ * @param style Style de rendu.
+ * @param taille Hauteur du rendu en pixels.
+ * @param pixels Tampon de destination.
+ * @param pitch Distance en octets entre deux lignes du tampon.
+ */
+void Rendu::rendreLettreARGB(char lettre, StyleRendu style, int taille, void* pixels, int pitch) {
+    rendreLettre(lettre, style, taille).toARGB(pixels, pitch);
+}
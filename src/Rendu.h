@@ -0,0 +1,170 @@
+#ifndef RENDU_H
+#define RENDU_H
+
+#include "ArenaRendu.h"
+#include "Bitmap.h"
+#include "Glyph.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Styles de rendu d'une lettre.
+ */
+enum class StyleRendu {
+    Contour,       ///< Contour noir (police 1).
+    RempliGras,    ///< Lettre remplie et version grasse côte à côte (police 2).
+    ContourRouge,  ///< Contour rouge épais recouvert de noir (police 3).
+    Lisse          ///< Lettre remplie avec anti-crénelage, en niveaux de gris.
+};
+
+/**
+ * @brief Rendu de lettres dans des bitmaps, sans aucune dépendance à l'affichage.
+ * 
+ * Les glyphes sont dessinés dans un espace de TAILLE_DESSIN pixels de côté,
+ * mis à l'échelle de la taille demandée. Les épaisseurs de trait suivent la
+ * même échelle. Un objet Rendu conserve ses glyphes (et leurs aplatissements)
+ * d'un appel à l'autre ; il n'est pas protégé contre les accès concurrents,
+ * chaque thread doit utiliser le sien.
+ * 
+ * La mémoire de travail d'un rendu (polygones des traits, tables d'arêtes,
+ * masques temporaires) est prise dans une arène propre à l'objet, remise à
+ * zéro à chaque lettre : une fois les premiers rendus faits, rendreLettre()
+ * dans un bitmap fourni n'appelle plus l'allocateur global.
+ */
+class Rendu {
+public:
+    /// Hauteur (et largeur) de l'espace dans lequel les glyphes sont dessinés.
+    static constexpr int TAILLE_DESSIN = 600;
+
+    /// Épaisseur du gras et du contour rouge à la taille TAILLE_DESSIN.
+    static constexpr int EPAISSEUR_DESSIN = 15;
+
+    /**
+     * @brief Constructeur : prépare les glyphes des lettres A à Z.
+     */
+    Rendu();
+
+    /**
+     * @brief Largeur du rendu d'une lettre.
+     * 
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @return int La largeur en pixels (2 taille pour RempliGras, taille sinon).
+     */
+    static int largeur(StyleRendu style, int taille);
+
+    /**
+     * @brief Format de pixels attendu par un style.
+     * 
+     * Les styles monochromes (Contour, RempliGras) utilisent un bit par pixel :
+     * 16 fois moins de mémoire, et des remplissages et copies par mots de 64 pixels.
+     * 
+     * @param style Style de rendu.
+     * @return PixelFormat Bit1 pour Contour et RempliGras, Index8 pour ContourRouge, Coverage8 pour Lisse.
+     */
+    static PixelFormat formatPour(StyleRendu style);
+
+    /**
+     * @brief Crée un bitmap blanc adapté à un style et une taille.
+     * 
+     * @param style Style de rendu (le format des pixels est formatPour(style)).
+     * @param taille Hauteur du rendu en pixels.
+     * @return Bitmap Le bitmap de largeur(style, taille) x taille.
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0.
+     */
+    static Bitmap creerBitmap(StyleRendu style, int taille);
+
+    /**
+     * @brief Retrouve un style à partir de son nom.
+     * 
+     * @param nom "contour", "gras", "rouge" ou "lisse".
+     * @return StyleRendu Le style correspondant.
+     * 
+     * @throws std::invalid_argument Si le nom est inconnu.
+     */
+    static StyleRendu styleDepuisNom(const std::string& nom);
+
+    /**
+     * @brief Nom d'un style, tel qu'accepté par styleDepuisNom().
+     * 
+     * @param style Style de rendu.
+     * @return Le nom du style.
+     */
+    static const char* nomStyle(StyleRendu style);
+
+    /**
+     * @brief Dessine une lettre dans un nouveau bitmap.
+     * 
+     * @param lettre La lettre (majuscule) à dessiner.
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @return Bitmap Le bitmap contenant la lettre.
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0.
+     */
+    Bitmap rendreLettre(char lettre, StyleRendu style, int taille);
+
+    /**
+     * @brief Dessine une lettre dans un bitmap fourni par l'appelant.
+     * 
+     * Le bitmap est d'abord effacé ; il peut être plus grand que le rendu
+     * (le dessin est alors placé en haut à gauche) ou plus petit (le dessin
+     * est découpé). Il doit être au format formatPour(style).
+     * 
+     * @param lettre La lettre (majuscule) à dessiner.
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @param bitmap Bitmap de destination.
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0, ou si le format ne convient pas au style.
+     */
+    void rendreLettre(char lettre, StyleRendu style, int taille, Bitmap& bitmap);
+
+    /**
+     * @brief Dessine une lettre dans un tampon ARGB8888 fourni par l'appelant.
+     * 
+     * @param lettre La lettre (majuscule) à dessiner.
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu en pixels.
+     * @param pixels Tampon d'au moins taille lignes de largeur(style, taille) pixels.
+     * @param pitch Distance en octets entre deux lignes du tampon.
+     * 
+     * @throws std::invalid_argument Si la taille est <= 0.
+     */
+    void rendreLettreARGB(char lettre, StyleRendu style, int taille, void* pixels, int pitch);
+
+    /**
+     * @brief Retourne le glyphe d'une lettre, mis à l'échelle d'une taille.
+     * 
+     * @param lettre La lettre recherchée.
+     * @param taille Hauteur du rendu en pixels.
+     * @return Le glyphe, vide si la lettre n'est pas supportée. La référence
+     *         reste valide jusqu'au prochain appel pour une lettre non supportée.
+     */
+    const Glyph& glyphe(char lettre, int taille);
+
+    /**
+     * @brief Mémoire occupée par les aplatissements conservés des glyphes.
+     * 
+     * @return size_t Somme de Glyph::getMemoireCache() sur les glyphes, en octets.
+     */
+    size_t getMemoireAplatissements() const;
+
+private:
+    /**
+     * @brief Retourne un masque de travail effacé, réutilisé d'un rendu à l'autre.
+     * 
+     * @param indice Numéro du masque (0 ou 1).
+     * @param taille Côté du masque en pixels.
+     * @return Bitmap& Le masque, au format Bit1.
+     */
+    Bitmap& masque(size_t indice, int taille);
+
+    Glyph glyphes['Z' - 'A' + 1];  ///< Glyphes des lettres A à Z.
+    Glyph vide;                    ///< Glyphe des lettres non supportées.
+    std::vector<Bitmap> masques;   ///< Masques de travail du style RempliGras.
+    ArenaRendu arena;              ///< Mémoire de travail du rendu en cours.
+};
+
+#endif // RENDU_H
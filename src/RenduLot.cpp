@@ -0,0 +1,130 @@
+#include "RenduLot.h"
+#include "Netpbm.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+
+using Horloge = std::chrono::steady_clock;
+
+/**
+ * @brief Secondes écoulées depuis un instant.
+ * 
+ * @param debut Instant de départ ; remplacé par l'instant présent.
+ * @return double La durée écoulée en secondes.
+ */
+static double ecoule(Horloge::time_point& debut) {
+    const Horloge::time_point maintenant = Horloge::now();
+    const std::chrono::duration<double> duree = maintenant - debut;
+    debut = maintenant;
+    return duree.count();
+}
+
+/**
+ * @brief Ajoute les mesures d'un autre thread.
+ * 
+ * @param autre Mesures à cumuler.
+ */
+void StatistiquesLot::ajouter(const StatistiquesLot& autre) {
+    nbGlyphes += autre.nbGlyphes;
+    generation += autre.generation;
+    aplatissement += autre.aplatissement;
+    rasterisation += autre.rasterisation;
+    encodage += autre.encodage;
+}
+
+/**
+ * @brief État propre à un thread : moteur de rendu, bitmaps de travail et mesures.
+ * 
+ * Aligné sur une ligne de cache pour que les mesures de deux threads ne
+ * partagent pas la même ligne.
+ */
+struct alignas(64) Ouvrier {
+    Rendu rendu;                   ///< Moteur de rendu du thread.
+    std::vector<Bitmap> bitmaps;   ///< Bitmaps de travail, un par (style, taille) rencontré.
+    StatistiquesLot statistiques;  ///< Mesures du thread.
+
+    /**
+     * @brief Retourne un bitmap de travail adapté à un style et une taille.
+     * 
+     * @param style Style de rendu.
+     * @param taille Hauteur du rendu.
+     * @return Le bitmap, créé au premier besoin puis réutilisé.
+     */
+    Bitmap& bitmapPour(StyleRendu style, int taille) {
+        for (auto& bitmap : bitmaps) {
+            if (bitmap.getHeight() == taille && bitmap.getWidth() == Rendu::largeur(style, taille)
+                && bitmap.getFormat() == Rendu::formatPour(style)) {
+                return bitmap;
+            }
+        }
+        bitmaps.push_back(Rendu::creerBitmap(style, taille));
+        return bitmaps.back();
+    }
+};
+
+/**
+ * @brief Constructeur.
+ * 
+ * @param tailles Hauteurs de rendu en pixels.
+ * @param styles Styles de rendu.
+ * @param dossier Dossier de sortie.
+ */
+RenduLot::RenduLot(const std::vector<int>& tailles, const std::vector<StyleRendu>& styles, const std::string& dossier)
+    : tailles(tailles), styles(styles), dossier(dossier) {
+    for (int taille : tailles) {
+        if (taille <= 0) {
+            throw std::invalid_argument("Les tailles de rendu doivent être strictement positives.");
+        }
+    }
+}
+
+/**
+ * @brief Exécute le lot.
+ * 
+ * @param pool Groupe de threads exécutant les rendus.
+ * @return StatistiquesLot Les mesures du lot.
+ */
+StatistiquesLot RenduLot::executer(PoolThreads& pool) const {
+    Horloge::time_point debutLot = Horloge::now();
+    std::filesystem::create_directories(dossier);
+
+    std::vector<std::unique_ptr<Ouvrier>> ouvriers;
+    for (size_t i = 0; i < pool.getNbThreads(); ++i) {
+        ouvriers.push_back(std::make_unique<Ouvrier>());
+    }
+
+    for (int taille : tailles) {
+        for (char lettre = 'A'; lettre <= 'Z'; ++lettre) {
+            pool.soumettre([this, &ouvriers, taille, lettre](size_t indice) {
+                Ouvrier& ouvrier = *ouvriers[indice];
+                StatistiquesLot& mesures = ouvrier.statistiques;
+                Horloge::time_point debut = Horloge::now();
+
+                const Glyph& glyph = ouvrier.rendu.glyphe(lettre, taille);
+                mesures.generation += ecoule(debut);
+                glyph.getAplatissement();
+                mesures.aplatissement += ecoule(debut);
+
+                for (StyleRendu style : styles) {
+                    Bitmap& bitmap = ouvrier.bitmapPour(style, taille);
+                    ouvrier.rendu.rendreLettre(lettre, style, taille, bitmap);
+                    mesures.rasterisation += ecoule(debut);
+
+                    const FormatNetpbm format = Netpbm::formatNaturel(bitmap);
+                    Netpbm::ecrire(bitmap, dossier + "/" + Rendu::nomStyle(style) + "_" + std::to_string(taille) + "_" + lettre + Netpbm::extension(format), format);
+                    mesures.encodage += ecoule(debut);
+                    ++mesures.nbGlyphes;
+                }
+            });
+        }
+    }
+    pool.attendre();
+
+    StatistiquesLot total;
+    for (const auto& ouvrier : ouvriers) {
+        total.ajouter(ouvrier->statistiques);
+    }
+    total.duree = ecoule(debutLot);
+    return total;
+}
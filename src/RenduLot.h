@@ -0,0 +1,70 @@
+#ifndef RENDU_LOT_H
+#define RENDU_LOT_H
+
+#include "PoolThreads.h"
+#include "Rendu.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Mesures d'un rendu par lot.
+ * 
+ * Les durées des étapes sont cumulées sur tous les threads (en secondes) ;
+ * seule `duree` est un temps réel.
+ */
+struct StatistiquesLot {
+    size_t nbGlyphes = 0;        ///< Nombre de rendus produits.
+    double generation = 0.0;     ///< Recherche des glyphes et mise à l'échelle.
+    double aplatissement = 0.0;  ///< Aplatissement des courbes.
+    double rasterisation = 0.0;  ///< Dessin dans les bitmaps.
+    double encodage = 0.0;       ///< Écriture des fichiers.
+    double duree = 0.0;          ///< Durée totale du lot, en temps réel.
+
+    /**
+     * @brief Ajoute les mesures d'un autre thread.
+     * 
+     * @param autre Mesures à cumuler (sauf la durée totale).
+     */
+    void ajouter(const StatistiquesLot& autre);
+};
+
+/**
+ * @brief Rendu de toutes les lettres A à Z, dans plusieurs styles et tailles, vers des fichiers.
+ * 
+ * Une tâche par couple (lettre, taille) est confiée au groupe de threads :
+ * les styles d'une même tâche partagent l'aplatissement du glyphe. Chaque
+ * thread garde son propre moteur de rendu et ses bitmaps de travail, réutilisés
+ * d'une tâche à l'autre. Chaque rendu est écrit dès qu'il est terminé, au
+ * format Netpbm binaire, dans `<dossier>/<style>_<taille>_<lettre>.pbm`
+ * (`.pgm` ou `.ppm` selon Netpbm::formatNaturel()).
+ */
+class RenduLot {
+public:
+    /**
+     * @brief Constructeur.
+     * 
+     * @param tailles Hauteurs de rendu en pixels.
+     * @param styles Styles de rendu.
+     * @param dossier Dossier de sortie (créé au besoin).
+     * 
+     * @throws std::invalid_argument Si une taille est <= 0.
+     */
+    RenduLot(const std::vector<int>& tailles, const std::vector<StyleRendu>& styles, const std::string& dossier);
+
+    /**
+     * @brief Exécute le lot.
+     * 
+     * @param pool Groupe de threads exécutant les rendus.
+     * @return StatistiquesLot Les mesures du lot.
+     * 
+     * @throws std::ios_base::failure Si un fichier ne peut pas être écrit.
+     */
+    StatistiquesLot executer(PoolThreads& pool) const;
+
+private:
+    std::vector<int> tailles;         ///< Hauteurs de rendu.
+    std::vector<StyleRendu> styles;   ///< Styles de rendu.
+    std::string dossier;              ///< Dossier de sortie.
+};
+
+#endif // RENDU_LOT_H
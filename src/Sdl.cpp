@@ -1,4 +1,8 @@
 #include "Sdl.h"
+#include "Trace.h"
+
+#ifndef SANS_SDL
+
 #include <iostream>
 #include <stdexcept>
 
@@ -14,7 +18,8 @@
  * @throws std::runtime_error Si l'initialisation de SDL, la création de la fenêtre, ou celle du renderer échoue.
  */
 SDL::SDL(int width, int height, const std::string& title)
-    : window(nullptr), renderer(nullptr), isRunning(true) {
+    : window(nullptr), renderer(nullptr), texture(nullptr), textureWidth(0), textureHeight(0),
+      windowWidth(width), windowHeight(height), currentImage(0), isRunning(true) {
     // Initialisation de SDL
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {
         throw std::runtime_error(std::string("Erreur SDL_Init : ") + SDL_GetError());
@@ -33,8 +38,11 @@ SDL::SDL(int width, int height, const std::string& title)
         throw std::runtime_error(std::string("Erreur SDL_CreateWindow : ") + SDL_GetError());
     }
 
-    // Création du renderer
+    // Création du renderer (logiciel si aucun n'est accéléré, par exemple avec le pilote "dummy")
     renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer) {
+        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    }
     if (!renderer) {
         throw std::runtime_error(std::string("Erreur SDL_CreateRenderer : ") + SDL_GetError());
     }
@@ -46,6 +54,9 @@ SDL::SDL(int width, int height, const std::string& title)
  * Nettoie les ressources allouées, y compris le renderer, la fenêtre et arrête SDL.
  */
 SDL::~SDL() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+    }
     if (renderer) {
         SDL_DestroyRenderer(renderer);
     }
@@ -58,19 +69,71 @@ SDL::~SDL() {
 /**
  * @brief Rendu d'un bitmap dans la fenêtre SDL.
  * 
+ * Convertit le bitmap dans la texture de streaming puis l'affiche.
+ * 
+ * @param bitmap Le bitmap à afficher.
+ */
+void SDL::renderBitmap(const Bitmap& bitmap) {
+    TRACE_PORTEE("SDL::renderBitmap");
+    if (!texture || textureWidth != bitmap.getWidth() || textureHeight != bitmap.getHeight()) {
+        if (texture) {
+            SDL_DestroyTexture(texture);
+        }
+        texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING,
+                                    bitmap.getWidth(), bitmap.getHeight());
+        if (!texture) {
+            throw std::runtime_error(std::string("Erreur SDL_CreateTexture : ") + SDL_GetError());
+        }
+        textureWidth = bitmap.getWidth();
+        textureHeight = bitmap.getHeight();
+    }
+
+    void* pixels = nullptr;
+    int pitch = 0;
+    if (SDL_LockTexture(texture, nullptr, &pixels, &pitch) < 0) {
+        throw std::runtime_error(std::string("Erreur SDL_LockTexture : ") + SDL_GetError());
+    }
+    bitmap.toARGB(pixels, pitch);
+    TRACE_PIXELS(static_cast<uint64_t>(bitmap.getWidth()) * bitmap.getHeight());
+    SDL_UnlockTexture(texture);
+
+    present();
+}
+
+/**
+ * @brief Réaffiche la texture courante.
+ */
+void SDL::present() {
+    TRACE_PORTEE("SDL::present");
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);  // Blanc
+    SDL_RenderClear(renderer);
+    if (texture) {
+        SDL_RenderCopy(renderer, texture, nullptr, nullptr);
+    }
+    SDL_RenderPresent(renderer);
+}
+
+/**
+ * @brief Rendu d'un bitmap pixel par pixel.
+ * 
  * Affiche le contenu d'un bitmap sur la fenêtre SDL en dessinant chaque pixel
  * avec la couleur appropriée (blanc, noir, ou rouge).
  * 
  * @param bitmap Le bitmap à afficher.
  */
-void SDL::renderBitmap(const Bitmap& bitmap) {
+void SDL::renderBitmapPerPoint(const Bitmap& bitmap) {
+    TRACE_PORTEE("SDL::renderBitmapPerPoint");
     SDL_SetRenderDrawColor(renderer, 255, 255, 255, SDL_ALPHA_OPAQUE);  // Blanc
     SDL_RenderClear(renderer);
 
     for (int y = 0; y < bitmap.getHeight(); ++y) {
+        const uint8_t* ligne = bitmap.row(y);
         for (int x = 0; x < bitmap.getWidth(); ++x) {
-            int pixel = bitmap.getPixel(x, y);
-            if (pixel == 1) { // Noir
+            int pixel = bitmap.getPixelRaw(ligne, x);
+            if (bitmap.getFormat() == PixelFormat::Coverage8) { // Niveau de gris
+                const Uint8 gris = static_cast<Uint8>(255 - pixel);
+                SDL_SetRenderDrawColor(renderer, gris, gris, gris, SDL_ALPHA_OPAQUE);
+            } else if (pixel == 1) { // Noir
                 SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
             } else if (pixel == 2) { // Rouge
                 SDL_SetRenderDrawColor(renderer, 255, 0, 0, SDL_ALPHA_OPAQUE);
@@ -84,21 +147,124 @@ void SDL::renderBitmap(const Bitmap& bitmap) {
     SDL_RenderPresent(renderer);
 }
 
+/**
+ * @brief Lit les pixels affichés par le dernier rendu.
+ * 
+ * @param pixels Tampon de destination.
+ * @param pitch Distance en octets entre deux lignes de la destination.
+ * @return true si la lecture a réussi.
+ */
+bool SDL::readPixels(void* pixels, int pitch) {
+    return SDL_RenderReadPixels(renderer, nullptr, SDL_PIXELFORMAT_ARGB8888, pixels, pitch) == 0;
+}
+
+/**
+ * @brief Ajoute une image à la file d'affichage.
+ * 
+ * @param title Titre de la fenêtre.
+ * @param rendu Fonction produisant le bitmap.
+ */
+void SDL::queue(const std::string& title, std::function<Bitmap()> rendu) {
+    images.push_back(Image{title, std::move(rendu)});
+}
+
+/**
+ * @brief Ajoute un bitmap déjà rendu à la file d'affichage.
+ * 
+ * @param title Titre de la fenêtre.
+ * @param bitmap Le bitmap à afficher.
+ */
+void SDL::queueBitmap(const std::string& title, const Bitmap& bitmap) {
+    queue(title, [bitmap]() { return bitmap; });
+}
+
+/**
+ * @brief Ajoute une lettre d'une police à la file d'affichage.
+ * 
+ * @param police La police utilisée.
+ * @param lettre La lettre à afficher.
+ */
+void SDL::queueLetter(const PoliceBase& police, char lettre) {
+    images.push_back(Image{police.getNom() + " - " + lettre, nullptr, &police, lettre});
+}
+
+/**
+ * @brief Nombre d'images dans la file d'affichage.
+ * 
+ * @return La taille de la file.
+ */
+size_t SDL::getQueueSize() const {
+    return images.size();
+}
+
+/**
+ * @brief Rend et affiche une image de la file.
+ * 
+ * @param index Position de l'image dans la file.
+ */
+void SDL::showImage(size_t index) {
+    currentImage = index;
+    const Image& image = images[index];
+    Rectangle zone{0, 0, 0, 0};
+    Bitmap bitmap = image.police ? image.police->dessinerDansPool(image.lettre, canevas, zone) : image.rendu();
+    if (bitmap.getWidth() != windowWidth || bitmap.getHeight() != windowHeight) {
+        SDL_SetWindowSize(window, bitmap.getWidth(), bitmap.getHeight());
+        windowWidth = bitmap.getWidth();
+        windowHeight = bitmap.getHeight();
+    }
+    const std::string title = image.title + " (" + std::to_string(index + 1) + "/" + std::to_string(images.size()) + ")";
+    SDL_SetWindowTitle(window, title.c_str());
+    renderBitmap(bitmap);
+    if (image.police) {
+        canevas.rendre(std::move(bitmap), zone); // Les autres bitmaps ne viennent pas du pool : ils sont détruits
+    }
+}
+
 /**
  * @brief Boucle principale pour gérer les événements SDL.
  * 
  * Maintient la fenêtre active jusqu'à ce que l'utilisateur décide de quitter.
- * Gère les événements SDL tels que la fermeture de la fenêtre.
+ * Gère les événements SDL tels que la fermeture de la fenêtre, le clavier
+ * (navigation dans la file) et la réexposition de la fenêtre. Le thread
+ * reste bloqué dans SDL_WaitEvent entre deux événements.
  */
 void SDL::mainLoop() {
+    isRunning = true;
+    if (!images.empty()) {
+        showImage(currentImage);
+    }
+
     SDL_Event event;
-    while (isRunning) {
-        while (SDL_PollEvent(&event)) {
-            if (event.type == SDL_QUIT) {
+    while (isRunning && SDL_WaitEvent(&event)) {
+        if (event.type == SDL_QUIT) {
+            isRunning = false;
+        } else if (event.type == SDL_KEYDOWN) {
+            switch (event.key.keysym.sym) {
+            case SDLK_ESCAPE:
+            case SDLK_q:
                 isRunning = false;
+                break;
+            case SDLK_RIGHT:
+            case SDLK_SPACE:
+            case SDLK_n:
+                if (!images.empty()) {
+                    showImage((currentImage + 1) % images.size());
+                }
+                break;
+            case SDLK_LEFT:
+            case SDLK_p:
+                if (!images.empty()) {
+                    showImage((currentImage + images.size() - 1) % images.size());
+                }
+                break;
+            default:
+                break;
             }
+        } else if (event.type == SDL_WINDOWEVENT
+                   && (event.window.event == SDL_WINDOWEVENT_EXPOSED || event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED)) {
+            present();
         }
-        SDL_Delay(16);  // Pour limiter l'utilisation du CPU (~60 FPS)
     }
 }
 
+#endif // SANS_SDL
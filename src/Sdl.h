@@ -1,15 +1,26 @@
 #ifndef SDL_H
 #define SDL_H
 
+// Frontal d'affichage optionnel : compiler avec -DSANS_SDL pour un programme sans SDL
+#ifndef SANS_SDL
+
 #include <SDL2/SDL.h>
 #include "Bitmap.h"
+#include "PoliceBase.h"
+#include "PoolBitmaps.h"
+#include <functional>
 #include <string>
+#include <vector>
 
 /**
  * @brief Classe pour gérer l'affichage avec SDL.
  * 
  * Cette classe encapsule les fonctionnalités de SDL pour créer une fenêtre,
  * rendre un bitmap et gérer une boucle principale d'événements.
+ * 
+ * Un même objet sert de contexte d'affichage pour tout le programme : les
+ * images à montrer sont mises en file (queue()) puis parcourues dans une
+ * seule fenêtre par mainLoop(), sans réinitialiser SDL entre deux images.
  */
 class SDL {
 public:
@@ -34,24 +45,128 @@ public:
     /**
      * @brief Rendu d'un bitmap dans la fenêtre.
      * 
-     * Dessine le contenu d'un bitmap dans la fenêtre SDL à l'aide du renderer.
+     * Convertit le bitmap en ARGB8888 directement dans une texture de
+     * streaming conservée d'un appel à l'autre (recréée seulement si la
+     * taille change), puis la copie en un seul appel de rendu.
      * 
      * @param bitmap Le bitmap à dessiner.
+     * 
+     * @throws std::runtime_error Si la texture ne peut pas être créée ou verrouillée.
      */
     void renderBitmap(const Bitmap& bitmap);
 
+    /**
+     * @brief Rendu d'un bitmap pixel par pixel.
+     * 
+     * Ancien chemin d'affichage (un changement de couleur et un point dessiné
+     * par pixel), conservé comme référence pour mesurer renderBitmap().
+     * 
+     * @param bitmap Le bitmap à dessiner.
+     */
+    void renderBitmapPerPoint(const Bitmap& bitmap);
+
+    /**
+     * @brief Lit les pixels ARGB8888 affichés par le dernier rendu.
+     * 
+     * À appeler juste après un rendu ; sert à vérifier que deux chemins
+     * d'affichage produisent la même image. Fiable avec le renderer logiciel
+     * (pilote vidéo "dummy"), dont l'image reste lisible après présentation.
+     * 
+     * @param pixels Tampon de destination.
+     * @param pitch Distance en octets entre deux lignes de la destination.
+     * @return true si le renderer a pu relire ses pixels.
+     */
+    bool readPixels(void* pixels, int pitch);
+
+    /**
+     * @brief Ajoute une image à la file d'affichage.
+     * 
+     * Le rendu n'est exécuté qu'au moment où l'image est affichée : mettre
+     * en file de nombreuses images ne coûte presque rien. Les objets
+     * capturés par `rendu` doivent rester valides jusqu'à la fin de mainLoop().
+     * 
+     * @param title Titre de la fenêtre pendant l'affichage de l'image.
+     * @param rendu Fonction produisant le bitmap à afficher.
+     */
+    void queue(const std::string& title, std::function<Bitmap()> rendu);
+
+    /**
+     * @brief Ajoute un bitmap déjà rendu à la file d'affichage.
+     * 
+     * @param title Titre de la fenêtre pendant l'affichage du bitmap.
+     * @param bitmap Le bitmap à afficher (copié).
+     */
+    void queueBitmap(const std::string& title, const Bitmap& bitmap);
+
+    /**
+     * @brief Ajoute une lettre d'une police à la file d'affichage.
+     * 
+     * La lettre n'est dessinée qu'au moment où elle est affichée, dans un
+     * bitmap du pool de canevas (voir PoliceBase::dessinerDansPool()) ; la
+     * police doit rester valide jusqu'à la fin de mainLoop().
+     * 
+     * @param police La police utilisée.
+     * @param lettre La lettre à afficher.
+     */
+    void queueLetter(const PoliceBase& police, char lettre);
+
+    /**
+     * @brief Nombre d'images dans la file d'affichage.
+     * 
+     * @return La taille de la file.
+     */
+    size_t getQueueSize() const;
+
     /**
      * @brief Boucle principale pour gérer les événements.
      * 
-     * Gère les événements SDL (comme la fermeture de la fenêtre) et maintient
-     * la fenêtre active jusqu'à ce que l'utilisateur décide de quitter.
+     * Affiche la première image de la file puis attend les événements avec
+     * SDL_WaitEvent : le programme ne consomme rien tant qu'aucun événement
+     * n'arrive. Flèche droite, espace ou N affichent l'image suivante,
+     * flèche gauche ou P la précédente ; Échap, Q ou la fermeture de la
+     * fenêtre terminent la boucle.
      */
     void mainLoop();
 
 private:
+    /**
+     * @brief Image en attente d'affichage.
+     */
+    struct Image {
+        std::string title;                   ///< Titre de la fenêtre.
+        std::function<Bitmap()> rendu;       ///< Production du bitmap (images de queue()).
+        const PoliceBase* police = nullptr;  ///< Police des lettres de queueLetter(), dessinées dans le pool.
+        char lettre = 0;                     ///< Lettre à dessiner avec `police`.
+    };
+
+    /**
+     * @brief Rend et affiche une image de la file.
+     * 
+     * La fenêtre est redimensionnée si le bitmap n'a pas sa taille. Une fois
+     * copié dans la texture, le bitmap d'une lettre retourne au pool de canevas.
+     * 
+     * @param index Position de l'image dans la file.
+     */
+    void showImage(size_t index);
+
+    /**
+     * @brief Réaffiche la texture courante sans la recalculer.
+     */
+    void present();
+
     SDL_Window* window;      ///< Pointeur vers la fenêtre SDL.
     SDL_Renderer* renderer;  ///< Pointeur vers le renderer SDL.
+    SDL_Texture* texture;    ///< Texture de streaming réutilisée par renderBitmap().
+    int textureWidth;        ///< Largeur de la texture.
+    int textureHeight;       ///< Hauteur de la texture.
+    int windowWidth;         ///< Largeur courante de la fenêtre.
+    int windowHeight;        ///< Hauteur courante de la fenêtre.
+    std::vector<Image> images; ///< File des images à afficher.
+    PoolBitmaps canevas;     ///< Bitmaps réutilisés d'une image à l'autre.
+    size_t currentImage;     ///< Position de l'image affichée dans la file.
     bool isRunning;          ///< Indique si la boucle principale est active.
 };
 
+#endif // SANS_SDL
+
 #endif
@@ -0,0 +1,275 @@
+#include "Trace.h"
+#include "BancEssai.h"
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<bool> Trace::active{false};
+thread_local CompteursTrace Trace::compteurs;
+thread_local uint64_t Trace::allocationsTrace = 0;
+
+/**
+ * @brief Événement enregistré : une étape terminée.
+ */
+struct EvenementTrace {
+    const char* nom;        ///< Nom de l'étape.
+    std::string detail;     ///< Détail (lettre, style, taille...).
+    int64_t debut;          ///< Date de début (ns).
+    int64_t duree;          ///< Durée (ns).
+    uint64_t pixels;        ///< Pixels écrits.
+    uint64_t echantillons;  ///< Points de courbe évalués.
+    uint64_t allocations;   ///< Allocations.
+};
+
+/**
+ * @brief Événements d'un thread.
+ * 
+ * Le verrou n'est disputé que pendant un export : un thread l'obtient
+ * toujours seul pour enregistrer ses événements.
+ */
+struct TamponTrace {
+    int numero = 0;                          ///< Numéro du thread dans la trace.
+    std::mutex verrou;                       ///< Protège les événements.
+    std::vector<EvenementTrace> evenements;  ///< Événements, dans l'ordre de fin.
+    size_t perdus = 0;                       ///< Événements au-delà de EVENEMENTS_MAX.
+};
+
+/// Origine des dates de la trace (ns, horloge monotone).
+static std::atomic<int64_t> origine{0};
+
+/// Protège la liste des tampons.
+static std::mutex verrouTampons;
+
+/**
+ * @brief Tampons de tous les threads, conservés après la fin des threads.
+ * 
+ * @return std::vector<std::shared_ptr<TamponTrace>>& Les tampons.
+ */
+static std::vector<std::shared_ptr<TamponTrace>>& tampons() {
+    static std::vector<std::shared_ptr<TamponTrace>> liste;
+    return liste;
+}
+
+/**
+ * @brief Tampon du thread appelant, créé et inscrit au premier appel.
+ * 
+ * @return TamponTrace& Le tampon.
+ */
+static TamponTrace& tamponCourant() {
+    thread_local std::shared_ptr<TamponTrace> tampon = []() {
+        auto nouveau = std::make_shared<TamponTrace>();
+        std::lock_guard<std::mutex> verrou(verrouTampons);
+        nouveau->numero = static_cast<int>(tampons().size()) + 1;
+        tampons().push_back(nouveau);
+        return nouveau;
+    }();
+    return *tampon;
+}
+
+/**
+ * @brief Horloge monotone, en nanosecondes.
+ * 
+ * @return int64_t La date.
+ */
+static int64_t horloge() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @brief Commence l'enregistrement.
+ */
+void Trace::demarrer() {
+    origine.store(horloge(), std::memory_order_relaxed);
+    active.store(true, std::memory_order_release);
+}
+
+/**
+ * @brief Arrête l'enregistrement.
+ */
+void Trace::arreter() {
+    active.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief Oublie les événements enregistrés.
+ */
+void Trace::vider() {
+    std::lock_guard<std::mutex> verrou(verrouTampons);
+    for (const auto& tampon : tampons()) {
+        std::lock_guard<std::mutex> verrouTampon(tampon->verrou);
+        tampon->evenements.clear();
+        tampon->perdus = 0;
+    }
+}
+
+/**
+ * @brief Nombre d'événements enregistrés.
+ * 
+ * @return size_t Le nombre d'événements.
+ */
+size_t Trace::getNbEvenements() {
+    std::lock_guard<std::mutex> verrou(verrouTampons);
+    size_t nb = 0;
+    for (const auto& tampon : tampons()) {
+        std::lock_guard<std::mutex> verrouTampon(tampon->verrou);
+        nb += tampon->evenements.size();
+    }
+    return nb;
+}
+
+/**
+ * @brief Date courante depuis le démarrage de l'enregistrement.
+ * 
+ * @return int64_t La date (ns).
+ */
+int64_t Trace::maintenant() {
+    return horloge() - origine.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Ajoute un événement au tampon du thread appelant.
+ * 
+ * @param nom Nom de l'étape.
+ * @param detail Détail de l'étape.
+ * @param debut Date de début (ns).
+ * @param fin Date de fin (ns).
+ * @param ecart Compteurs de travail pendant l'étape.
+ * @param allocations Allocations pendant l'étape.
+ */
+void Trace::enregistrer(const char* nom, std::string detail, int64_t debut, int64_t fin,
+                        const CompteursTrace& ecart, uint64_t allocations) {
+    // Création du tampon et agrandissement du vecteur ne sont pas comptés aux étapes englobantes
+    const uint64_t depart = allocationsTotales();
+    {
+        TamponTrace& tampon = tamponCourant();
+        std::lock_guard<std::mutex> verrou(tampon.verrou);
+        if (tampon.evenements.size() >= EVENEMENTS_MAX) {
+            ++tampon.perdus;
+        } else {
+            tampon.evenements.push_back({nom, std::move(detail), debut, fin - debut, ecart.pixels, ecart.echantillons, allocations});
+        }
+    }
+    allocationsTrace += allocationsTotales() - depart;
+}
+
+/**
+ * @brief Allocations hors enregistrement.
+ * 
+ * @return uint64_t Le nombre d'allocations.
+ */
+uint64_t Trace::allocationsHorsTrace() {
+    return allocationsTotales() - allocationsTrace;
+}
+
+/**
+ * @brief Allocations de tout le programme.
+ * 
+ * @return uint64_t Le nombre d'allocations.
+ */
+uint64_t Trace::allocationsTotales() {
+    return BancEssai::getNbAllocations();
+}
+
+/**
+ * @brief Écrit les événements au format Chrome trace.
+ * 
+ * @param sortie Flux de sortie.
+ */
+void Trace::ecrireChrome(std::ostream& sortie) {
+    const auto precision = sortie.precision(15);
+    std::lock_guard<std::mutex> verrou(verrouTampons);
+    sortie << "{\n  \"displayTimeUnit\": \"ns\",\n  \"traceEvents\": [";
+    bool premier = true;
+    auto separer = [&]() {
+        sortie << (premier ? "\n" : ",\n");
+        premier = false;
+    };
+    for (const auto& tampon : tampons()) {
+        std::lock_guard<std::mutex> verrouTampon(tampon->verrou);
+        separer();
+        sortie << "    {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << tampon->numero
+               << ", \"args\": {\"name\": \"thread " << tampon->numero << "\"}}";
+        for (const EvenementTrace& e : tampon->evenements) {
+            separer();
+            // Dates et durées en microsecondes, comme l'attend le format
+            sortie << "    {\"name\": " << BancEssai::chaineJson(e.nom) << ", \"cat\": \"rendu\", \"ph\": \"X\", \"pid\": 1, \"tid\": "
+                   << tampon->numero << ", \"ts\": " << e.debut / 1000.0 << ", \"dur\": " << e.duree / 1000.0 << ", \"args\": {";
+            if (!e.detail.empty()) {
+                sortie << "\"detail\": " << BancEssai::chaineJson(e.detail) << ", ";
+            }
+            sortie << "\"pixels\": " << e.pixels << ", \"echantillons\": " << e.echantillons
+                   << ", \"allocations\": " << e.allocations << "}}";
+        }
+        if (tampon->perdus > 0) {
+            separer();
+            sortie << "    {\"name\": \"evenements_perdus\", \"ph\": \"C\", \"pid\": 1, \"tid\": " << tampon->numero
+                   << ", \"ts\": 0, \"args\": {\"perdus\": " << tampon->perdus << "}}";
+        }
+    }
+    sortie << "\n  ]\n}\n";
+    sortie.precision(precision);
+}
+
+/**
+ * @brief Écrit un résumé par étape et par détail.
+ * 
+ * @param sortie Flux de sortie.
+ */
+void Trace::ecrireResume(std::ostream& sortie) {
+    struct Cumul {
+        size_t appels = 0;
+        int64_t duree = 0;
+        uint64_t pixels = 0;
+        uint64_t echantillons = 0;
+        uint64_t allocations = 0;
+    };
+    std::map<std::string, Cumul> cumuls;
+    size_t perdus = 0;
+    {
+        std::lock_guard<std::mutex> verrou(verrouTampons);
+        for (const auto& tampon : tampons()) {
+            std::lock_guard<std::mutex> verrouTampon(tampon->verrou);
+            for (const EvenementTrace& e : tampon->evenements) {
+                Cumul& cumul = cumuls[e.detail.empty() ? std::string(e.nom) : std::string(e.nom) + " " + e.detail];
+                ++cumul.appels;
+                cumul.duree += e.duree;
+                cumul.pixels += e.pixels;
+                cumul.echantillons += e.echantillons;
+                cumul.allocations += e.allocations;
+            }
+            perdus += tampon->perdus;
+        }
+    }
+    for (const auto& [etape, cumul] : cumuls) {
+        sortie << "  " << etape << " : " << cumul.appels << " appel(s), " << cumul.duree / 1e6 << " ms ("
+               << cumul.duree / 1e3 / cumul.appels << " µs/appel), " << cumul.pixels << " pixel(s), "
+               << cumul.echantillons << " échantillon(s), " << cumul.allocations << " allocation(s)" << std::endl;
+    }
+    if (perdus > 0) {
+        sortie << "  " << perdus << " événement(s) perdu(s) (plus de " << EVENEMENTS_MAX << " par thread)" << std::endl;
+    }
+}
+
+/**
+ * @brief Relève la date et les compteurs au début de l'étape.
+ */
+void PorteeTrace::commencer() {
+    depart = Trace::compteurs;
+    allocations = Trace::allocationsHorsTrace();
+    debut = Trace::maintenant();
+}
+
+/**
+ * @brief Enregistre l'étape avec les écarts des compteurs.
+ */
+void PorteeTrace::terminer() {
+    const int64_t fin = Trace::maintenant();
+    const uint64_t allocationsEtape = Trace::allocationsHorsTrace() - allocations;
+    CompteursTrace ecart;
+    ecart.pixels = Trace::compteurs.pixels - depart.pixels;
+    ecart.echantillons = Trace::compteurs.echantillons - depart.echantillons;
+    Trace::enregistrer(nom, std::move(detail), debut, fin, ecart, allocationsEtape);
+}
@@ -0,0 +1,243 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Instrumentation des étapes du rendu : compiler avec -DSANS_TRACE pour la retirer entièrement
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Compteurs de travail d'un thread, incrémentés seulement pendant l'enregistrement.
+ */
+struct CompteursTrace {
+    uint64_t pixels = 0;        ///< Pixels écrits (traits, portions remplies, compositions, dilatations).
+    uint64_t echantillons = 0;  ///< Points de courbes de Bézier évalués.
+};
+
+/**
+ * @brief Enregistrement des étapes du rendu, exporté au format Chrome trace.
+ * 
+ * Les étapes instrumentées (TRACE_PORTEE) sont enregistrées entre
+ * demarrer() et arreter() : nom, détail éventuel (lettre, style, taille),
+ * début et durée, puis pixels écrits, échantillons évalués et allocations
+ * faites pendant l'étape. Les compteurs d'une étape incluent ceux des
+ * étapes imbriquées.
+ * 
+ * Chaque thread écrit dans son propre tampon (borné à EVENEMENTS_MAX
+ * événements, les suivants sont comptés comme perdus). Hors enregistrement,
+ * une étape, comme un comptage de pixels ou d'échantillons, ne coûte qu'une
+ * lecture atomique ; compilées avec -DSANS_TRACE, les macros ne produisent
+ * aucun code.
+ * 
+ * Les allocations sont lues sur le compteur global de BancEssai, diminué de
+ * celles de l'enregistrement lui-même (tampons d'événements, détails) : une
+ * étape ne compte que les allocations du rendu. Avec plusieurs threads, elle
+ * compte aussi celles des autres.
+ */
+class Trace {
+public:
+    /// Nombre maximal d'événements conservés par thread.
+    static constexpr size_t EVENEMENTS_MAX = size_t(1) << 20;
+
+    /**
+     * @brief Commence l'enregistrement ; les dates sont comptées à partir de cet appel.
+     */
+    static void demarrer();
+
+    /**
+     * @brief Arrête l'enregistrement (les événements sont conservés).
+     */
+    static void arreter();
+
+    /**
+     * @brief Vrai pendant l'enregistrement.
+     * 
+     * @return bool Vrai entre demarrer() et arreter().
+     */
+    static bool estActive() {
+        return active.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Oublie les événements enregistrés.
+     */
+    static void vider();
+
+    /**
+     * @brief Nombre d'événements enregistrés, tous threads confondus.
+     * 
+     * @return size_t Le nombre d'événements.
+     */
+    static size_t getNbEvenements();
+
+    /**
+     * @brief Écrit les événements au format Chrome trace (JSON).
+     * 
+     * Le fichier s'ouvre dans chrome://tracing ou https://ui.perfetto.dev :
+     * une piste par thread, un événement complet ("ph": "X") par étape,
+     * détail et compteurs dans `args`.
+     * 
+     * @param sortie Flux de sortie.
+     */
+    static void ecrireChrome(std::ostream& sortie);
+
+    /**
+     * @brief Écrit un résumé par étape et par détail : appels, durées et compteurs cumulés.
+     * 
+     * @param sortie Flux de sortie.
+     */
+    static void ecrireResume(std::ostream& sortie);
+
+    /**
+     * @brief Ajoute des pixels écrits au compteur du thread.
+     * 
+     * @param n Nombre de pixels.
+     */
+    static void ajouterPixels(uint64_t n) {
+        compteurs.pixels += n;
+    }
+
+    /**
+     * @brief Ajoute des échantillons évalués au compteur du thread.
+     * 
+     * @param n Nombre de points évalués.
+     */
+    static void ajouterEchantillons(uint64_t n) {
+        compteurs.echantillons += n;
+    }
+
+    /**
+     * @brief Compteurs du thread appelant, cumulés sur ses périodes d'enregistrement.
+     * 
+     * @return const CompteursTrace& Les compteurs.
+     */
+    static const CompteursTrace& getCompteurs() {
+        return compteurs;
+    }
+
+private:
+    friend class PorteeTrace;
+
+    /**
+     * @brief Date courante, en nanosecondes depuis le démarrage de l'enregistrement.
+     * 
+     * @return int64_t La date.
+     */
+    static int64_t maintenant();
+
+    /**
+     * @brief Ajoute un événement au tampon du thread appelant.
+     * 
+     * @param nom Nom de l'étape (chaîne statique).
+     * @param detail Détail de l'étape.
+     * @param debut Date de début (ns).
+     * @param fin Date de fin (ns).
+     * @param ecart Compteurs de travail pendant l'étape.
+     * @param allocations Allocations pendant l'étape.
+     */
+    static void enregistrer(const char* nom, std::string detail, int64_t debut, int64_t fin,
+                            const CompteursTrace& ecart, uint64_t allocations);
+
+    /**
+     * @brief Allocations de tout le programme, moins celles de l'enregistrement faites par ce thread.
+     * 
+     * @return uint64_t Le nombre d'allocations.
+     */
+    static uint64_t allocationsHorsTrace();
+
+    /**
+     * @brief Allocations de tout le programme (compteur de BancEssai).
+     * 
+     * @return uint64_t Le nombre d'allocations.
+     */
+    static uint64_t allocationsTotales();
+
+    static std::atomic<bool> active;                ///< Vrai pendant l'enregistrement.
+    static thread_local CompteursTrace compteurs;   ///< Compteurs du thread.
+    static thread_local uint64_t allocationsTrace;  ///< Allocations faites par l'enregistrement dans ce thread.
+};
+
+/**
+ * @brief Étape mesurée : enregistrée à la sortie de la portée si l'enregistrement est actif.
+ */
+class PorteeTrace {
+public:
+    /**
+     * @brief Commence une étape.
+     * 
+     * @param nom Nom de l'étape (chaîne statique, non copiée).
+     */
+    explicit PorteeTrace(const char* nom) : nom(nom), mesuree(Trace::estActive()) {
+        if (mesuree) {
+            commencer();
+        }
+    }
+
+    /**
+     * @brief Commence une étape avec un détail, calculé seulement pendant l'enregistrement.
+     * 
+     * @param nom Nom de l'étape (chaîne statique, non copiée).
+     * @param calculerDetail Fonction sans argument renvoyant le détail.
+     */
+    template <class Detail>
+    PorteeTrace(const char* nom, Detail&& calculerDetail) : PorteeTrace(nom) {
+        if (mesuree) {
+            const uint64_t depart = Trace::allocationsTotales();
+            detail = calculerDetail();
+            Trace::allocationsTrace += Trace::allocationsTotales() - depart; // Le détail appartient à l'enregistrement
+        }
+    }
+
+    /**
+     * @brief Termine l'étape et l'enregistre.
+     */
+    ~PorteeTrace() {
+        if (mesuree) {
+            terminer();
+        }
+    }
+
+    PorteeTrace(const PorteeTrace&) = delete;
+    PorteeTrace& operator=(const PorteeTrace&) = delete;
+
+private:
+    /**
+     * @brief Relève la date, les compteurs du thread et le nombre d'allocations.
+     */
+    void commencer();
+
+    /**
+     * @brief Enregistre l'étape avec les écarts des compteurs depuis commencer().
+     */
+    void terminer();
+
+    const char* nom;           ///< Nom de l'étape.
+    bool mesuree;              ///< Vrai si l'enregistrement était actif au début.
+    std::string detail;        ///< Détail de l'étape.
+    int64_t debut = 0;         ///< Date de début (ns).
+    CompteursTrace depart;     ///< Compteurs du thread au début.
+    uint64_t allocations = 0;  ///< Allocations hors enregistrement au début.
+};
+
+#ifdef SANS_TRACE
+#define TRACE_PORTEE(nom) ((void)0)
+#define TRACE_PORTEE_DETAIL(nom, detail) ((void)0)
+#define TRACE_PIXELS(n) ((void)0)
+#define TRACE_ECHANTILLONS(n) ((void)0)
+#else
+#define TRACE_CONCATENER_(a, b) a##b
+#define TRACE_CONCATENER(a, b) TRACE_CONCATENER_(a, b)
+/// Mesure la portée courante sous le nom `nom`.
+#define TRACE_PORTEE(nom) PorteeTrace TRACE_CONCATENER(porteeTrace, __LINE__)(nom)
+/// Mesure la portée courante ; l'expression `detail` (std::string) n'est évaluée que pendant l'enregistrement.
+#define TRACE_PORTEE_DETAIL(nom, detail) \
+    PorteeTrace TRACE_CONCATENER(porteeTrace, __LINE__)(nom, [&]() { return std::string(detail); })
+/// Compte `n` pixels écrits ; `n` n'est évalué que pendant l'enregistrement.
+#define TRACE_PIXELS(n) (Trace::estActive() ? Trace::ajouterPixels(static_cast<uint64_t>(n)) : (void)0)
+/// Compte `n` points de courbe évalués ; `n` n'est évalué que pendant l'enregistrement.
+#define TRACE_ECHANTILLONS(n) (Trace::estActive() ? Trace::ajouterEchantillons(static_cast<uint64_t>(n)) : (void)0)
+#endif
+
+#endif // TRACE_H
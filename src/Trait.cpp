@@ -0,0 +1,217 @@
+#include "Trait.h"
+#include <algorithm>
+#include <cmath>
+
+/// Pi, M_PI n'étant pas standard.
+static constexpr float PI = 3.14159265358979323846f;
+
+/**
+ * @brief Ajoute un morceau fermé en lui imposant l'orientation commune.
+ * 
+ * L'orientation retenue est celle d'aire signée négative, qui est celle de
+ * tous les quadrilatères de segments ; un morceau d'orientation contraire est
+ * ajouté à l'envers.
+ * 
+ * @param morceau Sommets du morceau.
+ * @param nb Nombre de sommets.
+ * @param sommets Vecteur de destination des sommets.
+ * @param contours Vecteur de destination des bornes.
+ */
+static void ajouterMorceau(const Point* morceau, size_t nb, std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours) {
+    float aire = 0.0f;
+    for (size_t i = 0; i < nb; ++i) {
+        const Point& a = morceau[i];
+        const Point& b = morceau[(i + 1) % nb];
+        aire += a.getX() * b.getY() - b.getX() * a.getY();
+    }
+    if (aire > 0.0f) {
+        for (size_t i = nb; i > 0; --i) {
+            sommets.push_back(morceau[i - 1]);
+        }
+    } else {
+        sommets.insert(sommets.end(), morceau, morceau + nb);
+    }
+    contours.push_back(sommets.size());
+}
+
+/**
+ * @brief Nombre de cordes approchant un arc à `tolerance` près.
+ * 
+ * @param angle Angle de l'arc (radians).
+ * @param rayon Rayon de l'arc.
+ * @param tolerance Écart maximal toléré.
+ * @return int Le nombre de cordes, au moins 1.
+ */
+static int nombreCordes(float angle, float rayon, float tolerance) {
+    // Écart d'une corde d'angle a : r (1 - cos(a / 2)) <= tolerance
+    const float cosinus = std::max(-1.0f, 1.0f - tolerance / rayon);
+    const float angleCorde = std::max(2.0f * std::acos(cosinus), 1e-3f);
+    return std::max(1, static_cast<int>(std::ceil(angle / angleCorde)));
+}
+
+/**
+ * @brief Ajoute un disque approché par un polygone régulier.
+ * 
+ * Le nombre de côtés garantit un écart au cercle d'au plus `tolerance`.
+ * 
+ * @param centre Centre du disque.
+ * @param rayon Rayon du disque.
+ * @param tolerance Écart maximal toléré.
+ * @param sommets Vecteur de destination des sommets.
+ * @param contours Vecteur de destination des bornes.
+ */
+static void ajouterDisque(const Point& centre, float rayon, float tolerance,
+                          std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours) {
+    const int cotes = std::max(8, nombreCordes(2.0f * PI, rayon, tolerance));
+    for (int i = 0; i < cotes; ++i) {
+        const float a = -2.0f * PI * i / cotes; // Sens négatif
+        sommets.push_back(Point(centre.getX() + rayon * std::cos(a), centre.getY() + rayon * std::sin(a)));
+    }
+    contours.push_back(sommets.size());
+}
+
+/**
+ * @brief Ajoute la jonction entre deux segments au sommet p.
+ * 
+ * @param p Sommet commun.
+ * @param u1x Composante X de la direction unitaire du segment entrant.
+ * @param u1y Composante Y de la direction unitaire du segment entrant.
+ * @param u2x Composante X de la direction unitaire du segment sortant.
+ * @param u2y Composante Y de la direction unitaire du segment sortant.
+ * @param demi Demi-largeur du trait.
+ * @param style Paramètres du trait.
+ * @param sommets Vecteur de destination des sommets.
+ * @param contours Vecteur de destination des bornes.
+ */
+static void ajouterJointure(const Point& p, float u1x, float u1y, float u2x, float u2y, float demi,
+                            const StyleTrait& style, std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours) {
+    const float produitVectoriel = u1x * u2y - u1y * u2x;
+    const float produitScalaire = u1x * u2x + u1y * u2y;
+    if (std::fabs(produitVectoriel) < 1e-6f && produitScalaire > 0.0f) {
+        return; // Segments alignés : les quadrilatères se raccordent déjà
+    }
+
+    // Côté extérieur du virage : à droite pour un virage à gauche, et inversement
+    const float cote = (produitVectoriel > 0.0f) ? -1.0f : 1.0f;
+    const float n1x = -u1y * cote, n1y = u1x * cote;
+    const float n2x = -u2y * cote, n2y = u2x * cote;
+    const Point bord1(p.getX() + n1x * demi, p.getY() + n1y * demi);
+    const Point bord2(p.getX() + n2x * demi, p.getY() + n2y * demi);
+
+    if (style.jointure == Jointure::Arrondie) {
+        // Seul le secteur extérieur entre les deux bords manque aux quadrilatères ;
+        // si l'arc s'écarte de sa corde de moins que la tolérance, le biseau suffit
+        const float angle = std::atan2(std::fabs(produitVectoriel), produitScalaire);
+        if (demi * (1.0f - std::cos(0.5f * angle)) > style.tolerance) {
+            const int cordes = nombreCordes(angle, demi, style.tolerance);
+            // Parcours en sens négatif (orientation commune) : de n1 à n2 si le
+            // produit vectoriel est négatif (cote > 0), de n2 à n1 sinon
+            const float dx = (cote > 0.0f) ? n1x : n2x, dy = (cote > 0.0f) ? n1y : n2y;
+            sommets.push_back(p);
+            sommets.push_back(cote > 0.0f ? bord1 : bord2);
+            for (int k = 1; k < cordes; ++k) {
+                const float a = -angle * k / cordes;
+                const float c = std::cos(a), s = std::sin(a);
+                sommets.push_back(Point(p.getX() + (dx * c - dy * s) * demi, p.getY() + (dx * s + dy * c) * demi));
+            }
+            sommets.push_back(cote > 0.0f ? bord2 : bord1);
+            contours.push_back(sommets.size());
+            return;
+        }
+    }
+
+    if (style.jointure == Jointure::Angle) {
+        // Pointe : 2 demi (n1 + n2) / |n1 + n2|², de longueur 2 demi / |n1 + n2|
+        const float sx = n1x + n2x, sy = n1y + n2y;
+        const float norme2 = sx * sx + sy * sy;
+        if (norme2 > 1e-12f && 2.0f / std::sqrt(norme2) <= style.limiteAngle) {
+            const Point pointe(p.getX() + 2.0f * demi * sx / norme2, p.getY() + 2.0f * demi * sy / norme2);
+            const Point morceau[4] = {p, bord1, pointe, bord2};
+            ajouterMorceau(morceau, 4, sommets, contours);
+            return;
+        }
+    }
+
+    const Point morceau[3] = {p, bord1, bord2};
+    ajouterMorceau(morceau, 3, sommets, contours);
+}
+
+/**
+ * @brief Ajoute les polygones du trait d'une ligne brisée.
+ * 
+ * Les sommets répétés sont ignorés ; une ligne réduite à un point ne produit
+ * qu'un disque (extrémités arrondies) ou rien (extrémités plates).
+ * 
+ * @param points Sommets de la ligne brisée.
+ * @param nbPoints Nombre de sommets.
+ * @param ferme Si vrai, la ligne est refermée.
+ * @param style Paramètres du trait.
+ * @param sommets Vecteur de destination des sommets.
+ * @param contours Vecteur de destination des bornes.
+ */
+void Trait::contourner(const Point* points, size_t nbPoints, bool ferme, const StyleTrait& style,
+                       std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours) {
+    if (contours.empty()) {
+        contours.push_back(sommets.size());
+    }
+    const float demi = 0.5f * style.largeur;
+    if (nbPoints == 0 || !(demi > 0.0f)) {
+        return;
+    }
+
+    // Sommets distincts consécutifs
+    std::pmr::vector<Point> chemin(sommets.get_allocator()); // Dans la même ressource que le résultat
+    chemin.reserve(nbPoints + 1);
+    for (size_t i = 0; i < nbPoints; ++i) {
+        if (chemin.empty() || points[i].getX() != chemin.back().getX() || points[i].getY() != chemin.back().getY()) {
+            chemin.push_back(points[i]);
+        }
+    }
+    if (ferme && chemin.size() > 1 && chemin.front().getX() == chemin.back().getX() && chemin.front().getY() == chemin.back().getY()) {
+        chemin.pop_back();
+    }
+    if (chemin.size() == 1) {
+        if (style.extremite == Extremite::Arrondie) {
+            ajouterDisque(chemin[0], demi, style.tolerance, sommets, contours);
+        }
+        return;
+    }
+    ferme = ferme && chemin.size() > 2;
+
+    const size_t nbSegments = ferme ? chemin.size() : chemin.size() - 1;
+    float precedentX = 0.0f, precedentY = 0.0f;
+    for (size_t i = 0; i < nbSegments; ++i) {
+        const Point& a = chemin[i];
+        const Point& b = chemin[(i + 1) % chemin.size()];
+        const float longueur = std::hypot(b.getX() - a.getX(), b.getY() - a.getY());
+        const float ux = (b.getX() - a.getX()) / longueur;
+        const float uy = (b.getY() - a.getY()) / longueur;
+        const float nx = -uy * demi, ny = ux * demi;
+
+        const Point quad[4] = {
+            Point(a.getX() + nx, a.getY() + ny),
+            Point(b.getX() + nx, b.getY() + ny),
+            Point(b.getX() - nx, b.getY() - ny),
+            Point(a.getX() - nx, a.getY() - ny)
+        };
+        ajouterMorceau(quad, 4, sommets, contours);
+
+        if (i > 0) {
+            ajouterJointure(a, precedentX, precedentY, ux, uy, demi, style, sommets, contours);
+        }
+        precedentX = ux;
+        precedentY = uy;
+    }
+
+    if (ferme) {
+        // Jonction au premier sommet, entre le dernier segment et le premier
+        const Point& a = chemin[0];
+        const Point& b = chemin[1];
+        const float longueur = std::hypot(b.getX() - a.getX(), b.getY() - a.getY());
+        ajouterJointure(a, precedentX, precedentY, (b.getX() - a.getX()) / longueur, (b.getY() - a.getY()) / longueur,
+                        demi, style, sommets, contours);
+    } else if (style.extremite == Extremite::Arrondie) {
+        ajouterDisque(chemin.front(), demi, style.tolerance, sommets, contours);
+        ajouterDisque(chemin.back(), demi, style.tolerance, sommets, contours);
+    }
+}
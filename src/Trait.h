@@ -0,0 +1,68 @@
+#ifndef TRAIT_H
+#define TRAIT_H
+
+#include "Point.h"
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Forme de la jonction entre deux segments d'un trait.
+ */
+enum class Jointure {
+    Angle,    ///< Pointe prolongeant les bords (limitée par StyleTrait::limiteAngle).
+    Arrondie, ///< Arc de cercle centré sur le sommet.
+    Biseau    ///< Coin coupé entre les deux bords.
+};
+
+/**
+ * @brief Forme des extrémités d'un trait ouvert.
+ */
+enum class Extremite {
+    Plate,   ///< Le trait s'arrête net à l'extrémité.
+    Arrondie ///< Demi-disque centré sur l'extrémité.
+};
+
+/**
+ * @brief Paramètres d'un trait épais.
+ */
+struct StyleTrait {
+    float largeur = 1.0f;                    ///< Largeur totale du trait (en pixels).
+    Jointure jointure = Jointure::Arrondie;  ///< Forme des jonctions.
+    Extremite extremite = Extremite::Arrondie; ///< Forme des extrémités.
+    float limiteAngle = 4.0f;                ///< Longueur maximale d'une pointe, en demi-largeurs, avant biseau.
+    float tolerance = 0.25f;                 ///< Écart maximal toléré pour les arcs (en pixels).
+};
+
+/**
+ * @brief Conversion d'une ligne brisée en polygones de trait.
+ * 
+ * Le trait est décrit par des morceaux fermés : un quadrilatère par segment
+ * (les deux bords décalés d'une demi-largeur), plus un morceau par jonction
+ * et par extrémité. Tous les morceaux ont la même orientation : leur union
+ * est exactement la surface du trait sous la règle de l'enroulement non nul,
+ * sans calcul d'intersections. Le nombre de sommets suit le périmètre du
+ * trait, pas sa surface.
+ */
+class Trait {
+public:
+    /**
+     * @brief Ajoute les polygones du trait d'une ligne brisée.
+     * 
+     * Les morceaux sont ajoutés au format des contours aplatis : `contours`
+     * contient les indices de début puis l'indice de fin ; s'il est vide, il
+     * est initialisé.
+     * 
+     * @param points Sommets de la ligne brisée.
+     * @param nbPoints Nombre de sommets.
+     * @param ferme Si vrai, la ligne est refermée (jonction au premier sommet, pas d'extrémités).
+     * @param style Paramètres du trait.
+     * @param sommets Vecteur auquel sont ajoutés les sommets des morceaux (le
+     * vecteur de travail de la fonction est pris dans la même ressource).
+     * @param contours Vecteur auquel sont ajoutées les bornes des morceaux.
+     */
+    static void contourner(const Point* points, size_t nbPoints, bool ferme, const StyleTrait& style,
+                           std::pmr::vector<Point>& sommets, std::pmr::vector<size_t>& contours);
+};
+
+#endif
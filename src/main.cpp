@@ -1,7 +1,79 @@
+#include "Modes.h"
 #include "Police1.h"
 #include "Police2.h"
 #include "Police3.h"
+#include "Sdl.h"
+#include "Trace.h"
+#include <cctype>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Enregistre les étapes du rendu pendant sa durée de vie, puis les écrit.
+ * 
+ * À la destruction, la trace est écrite au format Chrome trace dans le
+ * fichier donné et résumée par étape sur la sortie standard.
+ */
+class EnregistrementTrace {
+public:
+    /**
+     * @brief Commence l'enregistrement.
+     * 
+     * @param fichier Fichier JSON de sortie.
+     */
+    explicit EnregistrementTrace(const std::string& fichier) : fichier(fichier) {
+#ifdef SANS_TRACE
+        std::cerr << "Programme compilé avec -DSANS_TRACE : la trace sera vide." << std::endl;
+#endif
+        Trace::demarrer();
+    }
+
+    /**
+     * @brief Arrête l'enregistrement, écrit la trace et son résumé.
+     */
+    ~EnregistrementTrace() {
+        Trace::arreter();
+        std::ofstream sortie(fichier);
+        Trace::ecrireChrome(sortie);
+        if (!sortie.flush()) {
+            std::cerr << "Erreur d'écriture dans le fichier : " << fichier << std::endl;
+            return;
+        }
+        std::cout << "Trace : " << Trace::getNbEvenements() << " étape(s) écrite(s) dans " << fichier << std::endl;
+        Trace::ecrireResume(std::cout);
+    }
+
+    EnregistrementTrace(const EnregistrementTrace&) = delete;
+    EnregistrementTrace& operator=(const EnregistrementTrace&) = delete;
+
+private:
+    std::string fichier;  ///< Fichier JSON de sortie.
+};
+
+/**
+ * @brief Modes du programme, choisis par le premier argument.
+ * 
+ * Chaque mode vit dans sa propre unité de traduction (voir Modes.h) ; tous
+ * sont disponibles sans SDL, sauf `--mesure-affichage`.
+ */
+static const ModeProgramme modes[] = {
+    {"--rendu", 1, "<lettres> [contour|gras|rouge|lisse] [taille] [préfixe]", modeRendu},
+    {"--lot", 1, "<tailles> [dossier] [threads]", modeLot},
+    {"--atlas", 1, "<lettres> [taille] [fichier]", modeAtlas},
+    {"--cache", 1, "<lettres> [contour|gras|rouge|lisse] [taille] [passages] [budget]", modeCache},
+    {"--cache-concurrent", 0, "[threads] [durée ms]", modeCacheConcurrent},
+    {"--bancs", 0, "[fichier.json] [répétitions] [groupe]", modeBancs},
+    {"--regression", 1, "<dossier> [generer|verifier] [taille] [écarts débit] [tolérance]", modeRegression},
+    {"--allocations", 0, "[tailles]", modeAllocations},
+    {"--pool", 0, "[passages] [budget]", modePool},
+#ifndef SANS_SDL
+    {"--mesure-affichage", 0, "[répétitions]", modeMesureAffichage},
+#endif
+};
 
 /**
  * @brief Point d'entrée du programme SDL.
@@ -9,6 +81,19 @@
  * La fonction principale initialise et utilise différentes classes de police
  * pour afficher des lettres dans des styles variés : contour, rempli, et contour rouge.
  * 
+ * Les lettres à afficher peuvent être données en premier argument (par
+ * défaut "A") ; toutes sont affichées dans une même fenêtre, lettre suivante
+ * avec la flèche droite, précédente avec la flèche gauche.
+ * 
+ * Si le premier argument est l'option d'un mode de la table `modes`, ce mode
+ * est lancé à la place avec les arguments suivants (voir Modes.h) ; un
+ * programme compilé avec -DSANS_SDL, qui n'a pas besoin de SDL, n'offre que
+ * ces modes.
+ * 
+ * Placée avant les autres, l'option `--trace <fichier.json>` enregistre les
+ * étapes du rendu pendant toute l'exécution et les écrit au format Chrome
+ * trace (voir Trace et EnregistrementTrace).
+ * 
  * @param argc Nombre d'arguments passés en ligne de commande.
  * @param argv Tableau des arguments passés en ligne de commande.
  * @return int Code de retour du programme (0 si succès).
@@ -21,15 +106,52 @@ int main(int argc, char* argv[]) {
         std::cout << "Argument " << i << ": " << argv[i] << std::endl;
     }
 
+    // Enregistrement des étapes du rendu jusqu'à la sortie du programme
+    std::unique_ptr<EnregistrementTrace> trace;
+    if (argc > 2 && std::strcmp(argv[1], "--trace") == 0) {
+        trace = std::make_unique<EnregistrementTrace>(argv[2]);
+        argv[2] = argv[0];
+        argv += 2;
+        argc -= 2;
+    }
+
+    if (argc > 1) {
+        for (const ModeProgramme& mode : modes) {
+            if (std::strcmp(argv[1], mode.option) == 0 && static_cast<size_t>(argc - 2) >= mode.nbArgumentsRequis) {
+                return executerMode(mode, std::vector<std::string>(argv + 2, argv + argc));
+            }
+        }
+    }
+
+#ifdef SANS_SDL
+    for (const ModeProgramme& mode : modes) {
+        std::cerr << (&mode == modes ? "Usage : " : "        ") << argv[0] << " " << mode.option << " " << mode.usage << std::endl;
+    }
+    std::cerr << "        " << argv[0] << " --trace <fichier.json> <option> ..." << std::endl;
+    return 1;
+#else
     // Initialisation des différentes classes de police
     Police1 police1(1200, 600);  ///< Police affichant uniquement le contour.
     Police2 police2(1200, 600);  ///< Police combinant le remplissage et le gras.
     Police3 police3(1200, 600);  ///< Police avec contour rouge.
 
-    // Affichage des lettres dans des styles différents
-    police1.afficherLettre('A');  // Affiche la lettre 'A' avec un contour.
-    police2.afficherLettre('A');  // Affiche la lettre 'B' remplie.
-    police3.afficherLettre('A');  // Affiche la lettre 'C' avec un contour rouge.
+    // Un seul contexte SDL pour toutes les lettres : chaque lettre est mise en
+    // file dans les trois styles, puis parcourue au clavier dans la même fenêtre
+    SDL sdl(1200, 600, "Polices");
+    const std::string lettres = argc > 1 ? argv[1] : "A";
+    for (char lettre : lettres) {
+        lettre = static_cast<char>(std::toupper(static_cast<unsigned char>(lettre)));
+        sdl.queueLetter(police1, lettre);  // Contour.
+        sdl.queueLetter(police2, lettre);  // Rempli et gras.
+        sdl.queueLetter(police3, lettre);  // Contour rouge.
+    }
+    sdl.mainLoop();
+
+    // Mémoire des contours aplatis conservés par les polices
+    std::cout << "Contours aplatis en cache : "
+              << police1.getMemoireAplatissements() + police2.getMemoireAplatissements() + police3.getMemoireAplatissements()
+              << " octets" << std::endl;
 
     return 0;
+#endif
 }